@@ -0,0 +1,68 @@
+#include "arene.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+Arene arene_vide() {
+    Arene a = malloc(sizeof(struct AreneOctets));
+    if (a == NULL) {
+        fprintf(stderr, "Erreur: Échec de l'allocation de mémoire.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    a->blocs = NULL;
+    a->nb_blocs = 0;
+    a->capacite_blocs = 0;
+    a->nb_utilises = 0;
+    a->taille_bloc_courant = 0; // No block yet: the next copy creates one
+    a->nb_octets = 0;
+
+    return a;
+}
+
+// Allocates a new block of a given size, which becomes the current block
+static void nouveau_bloc(Arene a, size_t taille) {
+    if (a->nb_blocs == a->capacite_blocs) {
+        a->capacite_blocs = a->capacite_blocs == 0 ? 8 : a->capacite_blocs * 2;
+        char** blocs = realloc(a->blocs, a->capacite_blocs * sizeof(char*));
+        if (blocs == NULL) {
+            fprintf(stderr, "Erreur: Échec de l'allocation de mémoire.\n");
+            exit(EXIT_FAILURE);
+        }
+        a->blocs = blocs;
+    }
+
+    char* bloc = malloc(taille);
+    if (bloc == NULL) {
+        fprintf(stderr, "Erreur: Échec de l'allocation de mémoire.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    a->blocs[a->nb_blocs] = bloc;
+    a->nb_blocs++;
+    a->nb_utilises = 0;
+    a->taille_bloc_courant = taille;
+    a->nb_octets += taille;
+}
+
+char* arene_copier(Arene a, const void* octets, size_t longueur) {
+    size_t taille = longueur + 1;
+
+    if (a->nb_utilises + taille > a->taille_bloc_courant) {
+        nouveau_bloc(a, taille > TAILLE_BLOC_ARENE ? taille : TAILLE_BLOC_ARENE);
+    }
+
+    char* copie = a->blocs[a->nb_blocs - 1] + a->nb_utilises;
+    memcpy(copie, octets, longueur);
+    copie[longueur] = '\0';
+    a->nb_utilises += taille;
+    return copie;
+}
+
+void liberer_arene(Arene a) {
+    for (size_t i = 0; i < a->nb_blocs; i++) {
+        free(a->blocs[i]);
+    }
+    free(a->blocs);
+    free(a);
+}
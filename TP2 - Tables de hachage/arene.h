@@ -0,0 +1,76 @@
+/**
+ * @file arene.h
+ * @author
+ * */
+
+#ifndef __ARENE__H__
+#define __ARENE__H__
+
+#include <stdlib.h>
+
+
+/* Description de la structure */
+
+/**
+ * @brief La taille d'un bloc de l'arène, en octets (64 Kio).
+ */
+#define TAILLE_BLOC_ARENE 65536
+
+/**
+ * @brief Structure codant une arène d'octets : une zone mémoire où l'on ne fait
+ * qu'ajouter. \n
+ * Les octets sont copiés les uns à la suite des autres dans des blocs de
+ * TAILLE_BLOC_ARENE octets (une copie plus grande a son propre bloc). Une copie
+ * ne bouge jamais : son adresse reste valable jusqu'à la libération de l'arène.
+ * On ne peut pas libérer une copie seule : tout est libéré d'un coup en
+ * libérant les blocs.
+ */
+struct AreneOctets{
+
+	char** blocs; /**< Le tableau des adresses des blocs alloués. */
+
+	size_t nb_blocs; /**< Le nombre de blocs alloués. */
+
+	size_t capacite_blocs; /**< La taille du tableau **blocs**. */
+
+	size_t nb_utilises; /**< Le nombre d'octets du bloc courant déjà utilisés. */
+
+	size_t taille_bloc_courant; /**< La taille du bloc courant (celui où l'on copie). */
+
+	size_t nb_octets; /**< Le nombre total d'octets alloués pour les blocs. */
+};
+
+/**
+ * @brief Le type "Arene" est un pointeur vers une arène d'octets.
+ */
+typedef struct AreneOctets* Arene;
+
+
+/* Prototype des fonctions */
+
+/**
+ * @brief Renvoie une arène vide (aucun bloc n'est encore alloué). \n
+ * **Complexité :** O(1)
+ * @returns une arène vide.
+ */
+Arene arene_vide();
+
+/**
+ * @brief Copie des octets dans l'arène, suivis d'un octet nul
+ * (pour qu'une chaîne de caractères copiée reste une chaîne C). \n
+ * **Complexité :** O(longueur) (en amorti)
+ * @param a une arène,
+ * @param octets l'adresse des octets à copier,
+ * @param longueur le nombre d'octets à copier.
+ * @returns l'adresse de la copie (valable jusqu'à la libération de l'arène).
+ */
+char* arene_copier(Arene a, const void* octets, size_t longueur);
+
+/**
+ * @brief Libère l'arène ainsi que toutes les copies qu'elle contient. \n
+ * **Complexité :** O(nombre de blocs)
+ * @param a une arène.
+ */
+void liberer_arene(Arene a);
+
+#endif
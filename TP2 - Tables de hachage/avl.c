@@ -0,0 +1,300 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "avl.h"
+
+
+
+/* POUR DEBUGGER : fonction qui transforme des avl en fichiers .dot */
+
+#include "string.h"
+
+void avl_to_dot_walker(FILE* fd, avl a, avl parent){
+	if (a) {
+		if (a != parent) fprintf(fd, "%ld -> %ld\n", (size_t) parent, (size_t) a);
+		fprintf(fd, "%ld [label=\"" FORMAT_BASE "\"];\n", (size_t) a, a->valeur);
+		fprintf(fd, "%ld [xlabel=\"%d\"];\n", (size_t) a, a->facteur_equilibrage);
+		avl_to_dot_walker(fd, a->gauche, a);
+		avl_to_dot_walker(fd, a->droite, a);
+	}
+}
+
+void avl_vers_dot(const char* nom_fichier, avl a){
+	int n = strlen(nom_fichier);
+	char nom_fichier_complet[n + 5];
+	strcpy(nom_fichier_complet,nom_fichier);
+	strcat(nom_fichier_complet,".dot");
+	FILE* fd = fopen(nom_fichier_complet, "w+");
+	fputs("digraph G {\nrankdir=\"TB\";\n", fd);
+	if (a){
+		avl_to_dot_walker(fd, a, a);
+	}
+	fputs("}\n", fd);
+	fclose(fd);
+}
+
+// Fonctions de base
+
+avl creer_noeud(type_base valeur) {
+    avl nouveau_noeud = (avl)malloc(sizeof(struct NoeudAvl));
+    if (nouveau_noeud == NULL) {
+        fprintf(stderr, "Erreur: Échec de l'allocation de mémoire.\n");
+        exit(EXIT_FAILURE);
+    }
+    nouveau_noeud->valeur = valeur;
+    nouveau_noeud->facteur_equilibrage = 0;
+    nouveau_noeud->gauche = NULL;
+    nouveau_noeud->droite = NULL;
+    return nouveau_noeud;
+}
+
+bool rechercher_abr(ArbreBinaire a, type_base x) {
+
+    while (a != NULL) {
+
+        if (a->valeur == x)
+            return true;
+        else if (x < a->valeur)
+            a = a->gauche;
+        else
+            a = a->droite;
+    }
+    return false;
+}
+
+avl inserer_sans_equilibrage(ArbreBinaire a, type_base x) {
+    if (a == NULL)
+        return creer_noeud(x);
+    if (x <= a->valeur)
+        a->gauche = inserer_sans_equilibrage(a->gauche, x);
+    else
+        a->droite = inserer_sans_equilibrage(a->droite, x);
+    return a;
+}
+
+void liberer_avl(ArbreBinaire a) {
+    if (a != NULL) {
+        liberer_avl(a->gauche);
+        liberer_avl(a->droite);
+        free(a);
+    }
+}
+
+// Fonctions pour tester si un arbre est AVL
+
+// Appends the values of a to l, in order
+static void ajouter_infixe(Liste l, ArbreBinaire a) {
+    if (a != NULL) {
+        ajouter_infixe(l, a->gauche);
+        ajouter_en_fin(l, a->valeur);
+        ajouter_infixe(l, a->droite);
+    }
+}
+
+Liste parcours_infixe(ArbreBinaire a) {
+    Liste l = liste_vide();
+    ajouter_infixe(l, a);
+    return l;
+}
+
+int hauteur_abr(ArbreBinaire a) {
+    if (a == NULL)
+        return -1;
+    int hauteur_gauche = hauteur_abr(a->gauche);
+    int hauteur_droite = hauteur_abr(a->droite);
+    return 1 + (hauteur_gauche > hauteur_droite ? hauteur_gauche : hauteur_droite);
+}
+
+// Height of a if every balance factor is right and between -1 and 1, -2 otherwise
+static int hauteur_si_equilibre(ArbreBinaire a) {
+    if (a == NULL)
+        return -1;
+    int hauteur_gauche = hauteur_si_equilibre(a->gauche);
+    int hauteur_droite = hauteur_si_equilibre(a->droite);
+    int diff_hauteur = hauteur_droite - hauteur_gauche;
+    if (hauteur_gauche == -2 || hauteur_droite == -2 || diff_hauteur < -1 || diff_hauteur > 1
+        || diff_hauteur != a->facteur_equilibrage)
+        return -2;
+    return 1 + (hauteur_gauche > hauteur_droite ? hauteur_gauche : hauteur_droite);
+}
+
+bool est_avl(ArbreBinaire a) {
+    // Le parcours infixe doit être croissant (au sens large)
+    Liste l = parcours_infixe(a);
+    bool trie = true;
+    for (size_t i = 1; i < longueur(l) && trie; i++) {
+        trie = element(l, i - 1) <= element(l, i);
+    }
+    liberer_liste(l);
+    return trie && hauteur_si_equilibre(a) != -2;
+}
+
+// Rotations simples
+
+void rotation_gauche(avl a) {
+    if (a == NULL || a->droite == NULL) {
+        fprintf(stderr, "Erreur: Rotation gauche d'un arbre sans enfant droit.\n");
+        exit(EXIT_FAILURE);
+    }
+    avl y = a->droite;
+    int facteur_x = a->facteur_equilibrage;
+    int facteur_y = y->facteur_equilibrage;
+
+    // Le noeud de y devient celui de x (en bas à gauche) : la racine ne bouge pas
+    type_base valeur_x = a->valeur;
+    a->valeur = y->valeur;
+    y->valeur = valeur_x;
+
+    a->droite = y->droite;
+    y->droite = y->gauche;
+    y->gauche = a->gauche;
+    a->gauche = y;
+
+    int nouveau_x = facteur_x - 1 - (facteur_y > 0 ? facteur_y : 0);
+    y->facteur_equilibrage = nouveau_x;
+    a->facteur_equilibrage = facteur_y - 1 + (nouveau_x < 0 ? nouveau_x : 0);
+}
+
+void rotation_droite(avl a) {
+    if (a == NULL || a->gauche == NULL) {
+        fprintf(stderr, "Erreur: Rotation droite d'un arbre sans enfant gauche.\n");
+        exit(EXIT_FAILURE);
+    }
+    avl x = a->gauche;
+    int facteur_y = a->facteur_equilibrage;
+    int facteur_x = x->facteur_equilibrage;
+
+    // Le noeud de x devient celui de y (en bas à droite) : la racine ne bouge pas
+    type_base valeur_y = a->valeur;
+    a->valeur = x->valeur;
+    x->valeur = valeur_y;
+
+    a->gauche = x->gauche;
+    x->gauche = x->droite;
+    x->droite = a->droite;
+    a->droite = x;
+
+    int nouveau_y = facteur_y + 1 - (facteur_x < 0 ? facteur_x : 0);
+    x->facteur_equilibrage = nouveau_y;
+    a->facteur_equilibrage = facteur_x + 1 + (nouveau_y > 0 ? nouveau_y : 0);
+}
+
+// Insertion
+
+avl dernier_noeud_desequilibre_et_insertion(avl a, type_base x) {
+    if (a == NULL)
+        return NULL;
+
+    // Sans noeud déséquilibré sur le chemin, les facteurs sont mis à jour depuis la racine
+    avl dernier_desequilibre = a;
+    avl current = a;
+    while (true) {
+        if (current->facteur_equilibrage != 0)
+            dernier_desequilibre = current;
+        avl* enfant = (x <= current->valeur) ? &(current->gauche) : &(current->droite);
+        if (*enfant == NULL) {
+            *enfant = creer_noeud(x);
+            return dernier_desequilibre;
+        }
+        current = *enfant;
+    }
+}
+
+void reequilibrage_jusqu_a_feuille(avl a_mettre_a_jour, type_base x) {
+    // On suit le chemin de l'insertion ; la feuille est le premier noeud sans enfant de ce côté
+    avl current = a_mettre_a_jour;
+    while (current != NULL) {
+        avl suivant = (x <= current->valeur) ? current->gauche : current->droite;
+        if (suivant == NULL)
+            return;
+        current->facteur_equilibrage += (x <= current->valeur) ? -1 : 1;
+        current = suivant;
+    }
+}
+
+// Restores the AVL condition at a node whose balance factor is -2 or 2
+// (single or double rotation, chosen from the balance factor of the child)
+static void reequilibrer(avl a) {
+    if (a->facteur_equilibrage == -2) {
+        if (a->gauche->facteur_equilibrage > 0)
+            rotation_gauche(a->gauche);
+        rotation_droite(a);
+    } else if (a->facteur_equilibrage == 2) {
+        if (a->droite->facteur_equilibrage < 0)
+            rotation_droite(a->droite);
+        rotation_gauche(a);
+    }
+}
+
+avl inserer_avl(avl a, type_base x) {
+    if (a == NULL)
+        return creer_noeud(x);
+    avl dernier_desequilibre = dernier_noeud_desequilibre_et_insertion(a, x);
+    reequilibrage_jusqu_a_feuille(dernier_desequilibre, x);
+    reequilibrer(dernier_desequilibre);
+    return a;
+}
+
+// Autre fonction
+
+int hauteur_avl(avl a) {
+    // On descend toujours du côté du sous-arbre le plus haut
+    int hauteur = -1;
+    while (a != NULL) {
+        hauteur++;
+        a = (a->facteur_equilibrage > 0) ? a->droite : a->gauche;
+    }
+    return hauteur;
+}
+
+// Suppression
+
+// Removes an occurrence of x from a, and sets *diminue if the height of a
+// went down by one. Returns the new root (a, unless a itself was freed).
+static avl supprimer_avl_rec(avl a, type_base x, bool* diminue) {
+    if (a == NULL) {
+        *diminue = false;
+        return NULL;
+    }
+
+    if (x != a->valeur) {
+        bool a_gauche = x < a->valeur;
+        if (a_gauche)
+            a->gauche = supprimer_avl_rec(a->gauche, x, diminue);
+        else
+            a->droite = supprimer_avl_rec(a->droite, x, diminue);
+        if (!*diminue)
+            return a;
+        a->facteur_equilibrage += a_gauche ? 1 : -1;
+    } else if (a->gauche == NULL || a->droite == NULL) {
+        avl enfant = (a->gauche != NULL) ? a->gauche : a->droite;
+        free(a);
+        *diminue = true;
+        return enfant;
+    } else {
+        // Deux enfants : on prend la valeur du prédécesseur, qu'on supprime à gauche
+        avl predecesseur = a->gauche;
+        while (predecesseur->droite != NULL)
+            predecesseur = predecesseur->droite;
+        a->valeur = predecesseur->valeur;
+        a->gauche = supprimer_avl_rec(a->gauche, a->valeur, diminue);
+        if (!*diminue)
+            return a;
+        a->facteur_equilibrage++;
+    }
+
+    // La hauteur de a ne change pas si son facteur passe à -1 ou 1 ; une rotation
+    // la fait baisser, sauf si l'enfant du côté le plus haut était équilibré
+    if (a->facteur_equilibrage == -1 || a->facteur_equilibrage == 1) {
+        *diminue = false;
+    } else if (a->facteur_equilibrage == 2 || a->facteur_equilibrage == -2) {
+        avl haut = (a->facteur_equilibrage == 2) ? a->droite : a->gauche;
+        *diminue = (haut->facteur_equilibrage != 0);
+        reequilibrer(a);
+    }
+    return a;
+}
+
+avl supprimer_avl(avl a, type_base x) {
+    bool diminue;
+    return supprimer_avl_rec(a, x, &diminue);
+}
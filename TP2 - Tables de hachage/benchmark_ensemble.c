@@ -0,0 +1,1738 @@
+#include "benchmark_ensemble.h"
+#include "benchmark.h"
+#include "ensemble.h"
+#include "ensemble_groupe.h"
+#include "hachage.h"
+#include "ensemble_concurrent.h"
+#include "ensemble_chaines.h"
+#include "ensemble_compresse.h"
+#include "instantane.h"
+#include "ensemble_coucou.h"
+#include "ensemble_deroule.h"
+#include "dictionnaire.h"
+#include "dictionnaire_ordonne.h"
+#include "operateurs.h"
+#include "esquisses.h"
+#include "ensemble_statique.h"
+#include "cache_lru.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <math.h>
+#include <time.h>
+
+// Keys shared by the benchmarked functions (test_rapidite only passes a size)
+static type_base* cles_presentes;
+static type_base* cles_absentes;
+static Ensemble ens_chaine;
+static EnsembleGroupe ens_groupe;
+static fonction_hachage hachage_courant;
+
+// Prevents the compiler from removing the lookups
+static volatile size_t nb_trouves;
+
+// Pseudo-random generator (xorshift64*), independent of rand()
+static uint64_t etat_aleatoire = 0x9E3779B97F4A7C15ULL;
+
+static uint64_t aleatoire() {
+    etat_aleatoire ^= etat_aleatoire >> 12;
+    etat_aleatoire ^= etat_aleatoire << 25;
+    etat_aleatoire ^= etat_aleatoire >> 27;
+    return etat_aleatoire * 0x2545F4914F6CDD1DULL;
+}
+
+// Present keys are even and absent keys are odd, so they never meet
+static void generer_cles(size_t taille) {
+    cles_presentes = malloc(taille * sizeof(type_base));
+    cles_absentes = malloc(taille * sizeof(type_base));
+    for (size_t i = 0; i < taille; i++) {
+        cles_presentes[i] = (type_base)(aleatoire() & 0x3FFFFFFF) * 2;
+        cles_absentes[i] = (type_base)(aleatoire() & 0x3FFFFFFF) * 2 + 1;
+    }
+}
+
+static void liberer_cles() {
+    free(cles_presentes);
+    free(cles_absentes);
+}
+
+static void appartient_presentes_chaine(size_t taille) {
+    size_t n = 0;
+    for (size_t i = 0; i < taille; i++) {
+        n += appartient(ens_chaine, cles_presentes[i]);
+    }
+    nb_trouves = n;
+}
+
+static void appartient_absentes_chaine(size_t taille) {
+    size_t n = 0;
+    for (size_t i = 0; i < taille; i++) {
+        n += appartient(ens_chaine, cles_absentes[i]);
+    }
+    nb_trouves = n;
+}
+
+static void appartient_presentes_groupe(size_t taille) {
+    size_t n = 0;
+    for (size_t i = 0; i < taille; i++) {
+        n += appartient_eg(ens_groupe, cles_presentes[i]);
+    }
+    nb_trouves = n;
+}
+
+static void appartient_absentes_groupe(size_t taille) {
+    size_t n = 0;
+    for (size_t i = 0; i < taille; i++) {
+        n += appartient_eg(ens_groupe, cles_absentes[i]);
+    }
+    nb_trouves = n;
+}
+
+void benchmark_ensemble_groupe(size_t taille) {
+    generer_cles(taille);
+
+    ens_chaine = ensemble_vide();
+    ens_groupe = ensemble_groupe_vide();
+    for (size_t i = 0; i < taille; i++) {
+        ajouter(ens_chaine, cles_presentes[i]);
+        ajouter_eg(ens_groupe, cles_presentes[i]);
+    }
+
+    printf("\n**** Recherches : 1. chaînée (présents), 2. chaînée (absents), "
+           "3. groupes (présents), 4. groupes (absents) ****\n");
+    fonction recherches[] = {appartient_presentes_chaine, appartient_absentes_chaine,
+                             appartient_presentes_groupe, appartient_absentes_groupe};
+    test_rapidite(recherches, 4, taille);
+
+    liberer_ensemble(ens_chaine);
+    liberer_ensemble_groupe(ens_groupe);
+    liberer_cles();
+}
+
+static void construire_et_rechercher(size_t taille) {
+    Ensemble e = ensemble_vide_avec_hachage(hachage_courant);
+    size_t n = 0;
+    for (size_t i = 0; i < taille; i++) {
+        ajouter(e, cles_presentes[i]);
+    }
+    for (size_t i = 0; i < taille; i++) {
+        n += appartient(e, cles_absentes[i]);
+    }
+    nb_trouves = n;
+    liberer_ensemble(e);
+}
+
+// Prints the longest bucket and the mean cost of a successful lookup
+static void afficher_repartition(const char* nom_cles, type_base* cles, size_t taille) {
+    Ensemble e = ensemble_vide_avec_hachage(hachage_courant);
+    for (size_t i = 0; i < taille; i++) {
+        ajouter(e, cles[i]);
+    }
+
+    size_t longueur_max = 0;
+    double nb_comparaisons = 0;
+    for (size_t i = 0; i < e->nb_alveoles; i++) {
+        size_t longueur = 0;
+        for (ListeChainee c = e->table[i]; c != NULL; c = c->suivant) {
+            longueur++;
+        }
+        if (longueur > longueur_max) {
+            longueur_max = longueur;
+        }
+        // Le k-ième noeud d'une alvéole est trouvé après k comparaisons
+        nb_comparaisons += longueur * (longueur + 1) / 2.0;
+    }
+
+    printf("  clés %-12s : alvéole la plus longue %zu, %.3f comparaisons par recherche "
+           "(uniforme : %.3f)\n", nom_cles, longueur_max, nb_comparaisons / taille,
+           1 + taille / (2.0 * e->nb_alveoles));
+    liberer_ensemble(e);
+}
+
+void benchmark_fonctions_hachage(size_t taille) {
+    const char* noms[] = {"multiplicatif_reel", "fibonacci", "murmur3", "wyhash"};
+    fonction_hachage fonctions[] = {hachage_multiplicatif_reel, hachage_fibonacci,
+                                    hachage_murmur3, hachage_wyhash};
+
+    generer_cles(taille);
+    type_base* consecutives = malloc(taille * sizeof(type_base));
+    type_base* espacees = malloc(taille * sizeof(type_base));
+    for (size_t i = 0; i < taille; i++) {
+        consecutives[i] = (type_base)i;
+        espacees[i] = (type_base)((i * 1024) & 0x7FFFFFFF);
+    }
+
+    fonction construction[] = {construire_et_rechercher};
+    for (size_t f = 0; f < 4; f++) {
+        hachage_courant = fonctions[f];
+        printf("\n**** Hachage %s : construction + recherches infructueuses ****\n", noms[f]);
+        test_rapidite(construction, 1, taille);
+        afficher_repartition("aléatoires", cles_presentes, taille);
+        afficher_repartition("consécutives", consecutives, taille);
+        afficher_repartition("espacées", espacees, taille);
+    }
+
+    free(consecutives);
+    free(espacees);
+    liberer_cles();
+}
+
+static int comparer_durees(const void* a, const void* b) {
+    long x = *(const long*)a, y = *(const long*)b;
+    return (x > y) - (x < y);
+}
+
+// Times every insertion of the present keys, put in successive ensembles
+// of a given size, then prints the percentiles
+static void afficher_latences(const char* nom, bool progressif, size_t taille, size_t taille_ensemble) {
+    struct timespec debut, fin;
+    long* durees = malloc(taille * sizeof(long));
+
+    for (size_t premier = 0; premier < taille; premier += taille_ensemble) {
+        Ensemble e = ensemble_vide();
+        ensemble_redimensionnement_progressif(e, progressif);
+        for (size_t i = premier; i < taille && i < premier + taille_ensemble; i++) {
+            clock_gettime(CLOCK_MONOTONIC, &debut);
+            ajouter(e, cles_presentes[i]);
+            clock_gettime(CLOCK_MONOTONIC, &fin);
+            durees[i] = (fin.tv_sec - debut.tv_sec) * 1000000000 + (fin.tv_nsec - debut.tv_nsec);
+        }
+        liberer_ensemble(e);
+    }
+
+    qsort(durees, taille, sizeof(long), comparer_durees);
+    printf("  %-11s : médiane %ld ns, p99 %ld ns, p99.9 %ld ns, p99.99 %ld ns, max %ld ns\n",
+           nom, durees[taille / 2], durees[taille * 99 / 100], durees[taille * 999 / 1000],
+           durees[taille * 9999 / 10000], durees[taille - 1]);
+    free(durees);
+}
+
+void benchmark_redimensionnement_progressif(size_t taille) {
+    generer_cles(taille);
+
+    // Un seul gros ensemble : les redimensionnements sont rares mais énormes
+    printf("\n**** Latence de ajouter (un ensemble de %zu éléments) ****\n", taille);
+    afficher_latences("d'un coup", false, taille, taille);
+    afficher_latences("progressif", true, taille, taille);
+
+    // Beaucoup de petits ensembles : les redimensionnements sont fréquents
+    printf("\n**** Latence de ajouter (%zu ensembles de 1000 éléments) ****\n", taille / 1000);
+    afficher_latences("d'un coup", false, taille, 1000);
+    afficher_latences("progressif", true, taille, 1000);
+
+    liberer_cles();
+}
+
+// Adds the present keys, removes one out of two and adds half as many absent keys
+static Ensemble construire_avec_suppressions(size_t taille, bool avec_reserve) {
+    Ensemble e = ensemble_vide();
+    ensemble_utiliser_reserve(e, avec_reserve);
+    for (size_t i = 0; i < taille; i++) {
+        ajouter(e, cles_presentes[i]);
+    }
+    for (size_t i = 0; i < taille; i += 2) {
+        supprimer(e, cles_presentes[i]);
+    }
+    for (size_t i = 0; i < taille / 2; i++) {
+        ajouter(e, cles_absentes[i]);
+    }
+    return e;
+}
+
+static void construire_malloc(size_t taille) {
+    liberer_ensemble(construire_avec_suppressions(taille, false));
+}
+
+static void construire_reserve(size_t taille) {
+    liberer_ensemble(construire_avec_suppressions(taille, true));
+}
+
+// Looks up the keys still present after construire_avec_suppressions
+static void appartient_restantes(size_t taille) {
+    size_t n = 0;
+    for (size_t i = 1; i < taille; i += 2) {
+        n += appartient(ens_chaine, cles_presentes[i]);
+    }
+    for (size_t i = 0; i < taille / 2; i++) {
+        n += appartient(ens_chaine, cles_absentes[i]);
+    }
+    nb_trouves = n;
+}
+
+void benchmark_reserve_noeuds(size_t taille) {
+    generer_cles(taille);
+
+    printf("\n**** Construction : 1. malloc, 2. réserve ****\n");
+    fonction constructions[] = {construire_malloc, construire_reserve};
+    test_rapidite(constructions, 2, taille);
+
+    fonction recherches[] = {appartient_restantes};
+    printf("\n**** Recherches fructueuses (malloc) ****\n");
+    ens_chaine = construire_avec_suppressions(taille, false);
+    test_rapidite(recherches, 1, taille);
+    printf("  %zu appels à malloc, %zu appels à free avant liberer_ensemble\n",
+           taille + taille / 2, taille / 2);
+    liberer_ensemble(ens_chaine);
+
+    printf("\n**** Recherches fructueuses (réserve) ****\n");
+    ens_chaine = construire_avec_suppressions(taille, true);
+    test_rapidite(recherches, 1, taille);
+    printf("  %zu noeuds distribués, %zu rendus, %zu blocs alloués (libérés d'un coup)\n",
+           ens_chaine->reserve->nb_allocations, ens_chaine->reserve->nb_liberations,
+           ens_chaine->reserve->nb_blocs);
+    liberer_ensemble(ens_chaine);
+
+    liberer_cles();
+}
+
+// Parameters of a benchmark thread
+struct ParametresThread {
+    size_t taille;
+    int pourcentage_lectures;
+    bool concurrent;
+    uint64_t graine;
+};
+
+static EnsembleConcurrent ens_concurrent;
+static pthread_mutex_t verrou_global = PTHREAD_MUTEX_INITIALIZER;
+
+// Random mix of lookups, insertions and removals (as many insertions as removals)
+static void* operations_melangees(void* arg) {
+    struct ParametresThread* p = arg;
+    uint64_t etat = p->graine;
+    size_t n = 0;
+
+    for (size_t i = 0; i < p->taille; i++) {
+        etat ^= etat >> 12;
+        etat ^= etat << 25;
+        etat ^= etat >> 27;
+        uint64_t r = etat * 0x2545F4914F6CDD1DULL;
+        type_base x = cles_presentes[(r >> 8) % p->taille];
+        int choix = (int)(r % 100);
+        int pourcentage_ajouts = (100 - p->pourcentage_lectures) / 2;
+
+        if (p->concurrent) {
+            if (choix < p->pourcentage_lectures) {
+                n += appartient_concurrent(ens_concurrent, x);
+            } else if (choix < p->pourcentage_lectures + pourcentage_ajouts) {
+                ajouter_concurrent(ens_concurrent, x);
+            } else {
+                supprimer_concurrent(ens_concurrent, x);
+            }
+        } else {
+            pthread_mutex_lock(&verrou_global);
+            if (choix < p->pourcentage_lectures) {
+                n += appartient(ens_chaine, x);
+            } else if (choix < p->pourcentage_lectures + pourcentage_ajouts) {
+                ajouter(ens_chaine, x);
+            } else {
+                supprimer_si_present(ens_chaine, x);
+            }
+            pthread_mutex_unlock(&verrou_global);
+        }
+    }
+    nb_trouves = n;
+    return NULL;
+}
+
+// Runs nb_threads threads on a freshly filled ensemble, returns millions of operations per second
+static double debit_threads(size_t taille, int nb_threads, int pourcentage_lectures, bool concurrent) {
+    struct timespec debut, fin;
+    pthread_t threads[nb_threads];
+    struct ParametresThread parametres[nb_threads];
+
+    if (concurrent) {
+        ens_concurrent = ensemble_concurrent_vide();
+    } else {
+        ens_chaine = ensemble_vide();
+    }
+    for (size_t i = 0; i < taille; i++) {
+        if (concurrent) {
+            ajouter_concurrent(ens_concurrent, cles_presentes[i]);
+        } else {
+            ajouter(ens_chaine, cles_presentes[i]);
+        }
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &debut);
+    for (int t = 0; t < nb_threads; t++) {
+        parametres[t] = (struct ParametresThread){taille, pourcentage_lectures, concurrent, aleatoire() | 1};
+        pthread_create(&threads[t], NULL, operations_melangees, &parametres[t]);
+    }
+    for (int t = 0; t < nb_threads; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &fin);
+
+    if (concurrent) {
+        liberer_ensemble_concurrent(ens_concurrent);
+    } else {
+        liberer_ensemble(ens_chaine);
+    }
+
+    double secondes = (fin.tv_sec - debut.tv_sec) + (fin.tv_nsec - debut.tv_nsec) / 1e9;
+    return nb_threads * taille / secondes / 1e6;
+}
+
+void benchmark_ensemble_concurrent(size_t taille, int nb_threads_max) {
+    int pourcentages_lectures[] = {90, 20};
+    generer_cles(taille);
+
+    for (int m = 0; m < 2; m++) {
+        printf("\n**** Débit (Mop/s), %d %% de lectures : verrou global / concurrent ****\n",
+               pourcentages_lectures[m]);
+        for (int nb_threads = 1; nb_threads <= nb_threads_max; nb_threads *= 2) {
+            printf("  %2d thread(s) : %7.2f / %7.2f\n", nb_threads,
+                   debit_threads(taille, nb_threads, pourcentages_lectures[m], false),
+                   debit_threads(taille, nb_threads, pourcentages_lectures[m], true));
+        }
+    }
+
+    liberer_cles();
+}
+
+static bool* resultats_lot;
+
+static void construire_un_par_un(size_t taille) {
+    Ensemble e = ensemble_vide();
+    for (size_t i = 0; i < taille; i++) {
+        ajouter(e, cles_presentes[i]);
+    }
+    liberer_ensemble(e);
+}
+
+static void construire_par_lot(size_t taille) {
+    Ensemble e = ensemble_vide();
+    ajouter_lot(e, cles_presentes, taille);
+    liberer_ensemble(e);
+}
+
+static void appartient_presentes_lot(size_t taille) {
+    appartient_lot(ens_chaine, cles_presentes, taille, resultats_lot);
+}
+
+static void appartient_absentes_lot(size_t taille) {
+    appartient_lot(ens_chaine, cles_absentes, taille, resultats_lot);
+}
+
+void benchmark_lots(size_t taille) {
+    generer_cles(taille);
+    resultats_lot = malloc(taille * sizeof(bool));
+
+    printf("\n**** Construction (%zu éléments) : 1. ajouter, 2. ajouter_lot ****\n", taille);
+    fonction constructions[] = {construire_un_par_un, construire_par_lot};
+    test_rapidite(constructions, 2, taille);
+
+    ens_chaine = ensemble_vide();
+    ajouter_lot(ens_chaine, cles_presentes, taille);
+    printf("\n**** Recherches : 1. appartient (présents), 2. appartient_lot (présents), "
+           "3. appartient (absents), 4. appartient_lot (absents) ****\n");
+    fonction recherches[] = {appartient_presentes_chaine, appartient_presentes_lot,
+                             appartient_absentes_chaine, appartient_absentes_lot};
+    test_rapidite(recherches, 4, taille);
+    liberer_ensemble(ens_chaine);
+
+    free(resultats_lot);
+    liberer_cles();
+}
+
+static Ensemble ens_a;
+static Ensemble ens_b;
+static int nb_threads_operations;
+
+// Adds the elements of a list that are not already in the set
+static void ajouter_absents(Ensemble r, Liste l, Ensemble filtre) {
+    for (size_t i = 0; i < longueur(l); i++) {
+        type_base x = element(l, i);
+        if ((filtre == NULL || appartient(filtre, x)) && !appartient(r, x)) {
+            ajouter(r, x);
+        }
+    }
+}
+
+static void union_naive(size_t taille) {
+    (void)taille;
+    Liste la = ensemble_vers_liste(ens_a);
+    Liste lb = ensemble_vers_liste(ens_b);
+    Ensemble r = ensemble_vide();
+    ajouter_absents(r, la, NULL);
+    ajouter_absents(r, lb, NULL);
+    nb_trouves = r->taille;
+    liberer_liste(la);
+    liberer_liste(lb);
+    liberer_ensemble(r);
+}
+
+static void intersection_naive(size_t taille) {
+    (void)taille;
+    Liste lb = ensemble_vers_liste(ens_b);
+    Ensemble r = ensemble_vide();
+    ajouter_absents(r, lb, ens_a);
+    nb_trouves = r->taille;
+    liberer_liste(lb);
+    liberer_ensemble(r);
+}
+
+static void union_optimisee(size_t taille) {
+    (void)taille;
+    Ensemble r = ensemble_union_parallele(ens_a, ens_b, nb_threads_operations);
+    nb_trouves = r->taille;
+    liberer_ensemble(r);
+}
+
+static void intersection_optimisee(size_t taille) {
+    (void)taille;
+    Ensemble r = ensemble_intersection_parallele(ens_a, ens_b, nb_threads_operations);
+    nb_trouves = r->taille;
+    liberer_ensemble(r);
+}
+
+static void difference_optimisee(size_t taille) {
+    (void)taille;
+    Ensemble r = ensemble_difference_parallele(ens_a, ens_b, nb_threads_operations);
+    nb_trouves = r->taille;
+    liberer_ensemble(r);
+}
+
+static void sous_ensemble(size_t taille) {
+    (void)taille;
+    nb_trouves = est_sous_ensemble(ens_a, ens_a);
+}
+
+void benchmark_operations_ensemblistes(size_t taille, int nb_threads) {
+    generer_cles(taille);
+
+    ens_a = ensemble_vide();
+    ens_b = ensemble_vide();
+    ajouter_lot(ens_a, cles_presentes, taille);
+    ajouter_lot(ens_b, cles_presentes, taille / 8);
+    ajouter_lot(ens_b, cles_absentes, taille / 8);
+
+    printf("\n**** |A| = %zu, |B| = %zu : 1. union naïve, 2. ensemble_union, "
+           "3. intersection naïve, 4. ensemble_intersection, 5. ensemble_difference(A, B), "
+           "6. est_sous_ensemble(A, A) ****\n", ens_a->taille, ens_b->taille);
+    nb_threads_operations = 1;
+    fonction operations[] = {union_naive, union_optimisee, intersection_naive, intersection_optimisee,
+                             difference_optimisee, sous_ensemble};
+    test_rapidite(operations, 6, taille);
+
+    printf("\n**** Avec %d threads : 1. union, 2. intersection, 3. difference ****\n", nb_threads);
+    nb_threads_operations = nb_threads;
+    fonction paralleles[] = {union_optimisee, intersection_optimisee, difference_optimisee};
+    test_rapidite(paralleles, 3, taille);
+
+    // Vérifications : B contient des clés absentes de A, et un ensemble non
+    // vide n'est jamais inclus dans l'ensemble vide
+    Ensemble inter = ensemble_intersection(ens_b, ens_a);
+    Ensemble vide = ensemble_vide();
+    Ensemble deux = ensemble_vide();
+    ajouter(deux, cles_presentes[0]);
+    ajouter(deux, cles_absentes[0]);
+    printf("B inclus dans A : %s (attendu : non), B inter A inclus dans A : %s (attendu : oui), "
+           "{x, y} inclus dans {} : %s (attendu : non)\n",
+           est_sous_ensemble(ens_b, ens_a) ? "oui" : "non", est_sous_ensemble(inter, ens_a) ? "oui" : "non",
+           est_sous_ensemble(deux, vide) ? "oui" : "non");
+    liberer_ensemble(deux);
+    liberer_ensemble(vide);
+    liberer_ensemble(inter);
+
+    liberer_ensemble(ens_a);
+    liberer_ensemble(ens_b);
+    liberer_cles();
+}
+
+void benchmark_filtre_bloom(size_t taille) {
+    generer_cles(taille);
+    ens_chaine = ensemble_vide();
+    ajouter_lot(ens_chaine, cles_presentes, taille);
+
+    int bits_par_cle[] = {0, 4, 8, 12, 16};
+    for (size_t i = 0; i < 5; i++) {
+        ensemble_utiliser_filtre(ens_chaine, bits_par_cle[i]);
+        if (bits_par_cle[i] == 0) {
+            printf("\n**** Sans filtre : 1. recherches infructueuses, 2. recherches fructueuses ****\n");
+        } else {
+            size_t nb_faux_positifs = 0;
+            for (size_t j = 0; j < taille; j++) {
+                nb_faux_positifs += filtre_bloom_contient(ens_chaine->filtre, objet_vers_nombre(cles_absentes[j]));
+            }
+            size_t nb_octets = ens_chaine->filtre->nb_blocs * NB_MOTS_PAR_BLOC * sizeof(uint64_t);
+            printf("\n**** Filtre de %d bits par clé (%.1f bits par élément présent, %zu Kio) : "
+                   "%.2f %% de faux positifs ; 1. recherches infructueuses, 2. recherches fructueuses ****\n",
+                   bits_par_cle[i], 8.0 * (double)nb_octets / (double)taille, nb_octets / 1024,
+                   100.0 * (double)nb_faux_positifs / (double)taille);
+        }
+        fonction recherches[] = {appartient_absentes_chaine, appartient_presentes_chaine};
+        test_rapidite(recherches, 2, taille);
+    }
+
+    liberer_ensemble(ens_chaine);
+    liberer_cles();
+}
+
+static bool mode_multiensemble;
+
+static void construire_multiensemble(size_t taille) {
+    liberer_ensemble(ens_chaine);
+    ens_chaine = ensemble_vide();
+    ensemble_mode_multiensemble(ens_chaine, mode_multiensemble);
+    for (size_t i = 0; i < taille; i++) {
+        ajouter(ens_chaine, cles_presentes[i]);
+    }
+}
+
+// Negative keys are never drawn
+static void appartient_negatives(size_t taille) {
+    size_t n = 0;
+    for (size_t i = 0; i < taille; i++) {
+        n += appartient(ens_chaine, -(type_base)i - 1);
+    }
+    nb_trouves = n;
+}
+
+static void construire_et_vider_multiensemble(size_t taille) {
+    construire_multiensemble(taille);
+    for (size_t i = 0; i < taille; i++) {
+        supprimer(ens_chaine, cles_presentes[i]);
+    }
+}
+
+void benchmark_multiensemble(size_t taille) {
+    // Loi log-uniforme : la clé 1 revient environ taille / (2 ln(taille)) fois
+    cles_presentes = malloc(taille * sizeof(type_base));
+    for (size_t i = 0; i < taille; i++) {
+        double u = (double)(aleatoire() >> 11) / 9007199254740992.0;
+        cles_presentes[i] = (type_base)exp(u * log((double)taille));
+    }
+    ens_chaine = ensemble_vide();
+
+    for (int mode = 0; mode < 2; mode++) {
+        mode_multiensemble = mode;
+        construire_multiensemble(taille);
+
+        size_t plus_longue = 0;
+        for (size_t i = 0; i < ens_chaine->nb_alveoles; i++) {
+            size_t longueur_chaine = 0;
+            for (ListeChainee n = ens_chaine->table[i]; n != NULL; n = n->suivant) {
+                longueur_chaine++;
+            }
+            plus_longue = longueur_chaine > plus_longue ? longueur_chaine : plus_longue;
+        }
+        printf("\n**** %s : %zu noeuds, %zu Kio, plus longue liste : %zu ; "
+               "1. ajouts, 2. recherches infructueuses, 3. ajouts puis suppressions ****\n",
+               mode ? "Multi-ensemble" : "Noeud par doublon", ens_chaine->taille,
+               (ens_chaine->taille * sizeof(struct Noeud) + ens_chaine->nb_alveoles * sizeof(ListeChainee)) / 1024,
+               plus_longue);
+
+        fonction operations[] = {construire_multiensemble, appartient_negatives, construire_et_vider_multiensemble};
+        test_rapidite(operations, 3, taille);
+    }
+
+    liberer_ensemble(ens_chaine);
+    free(cles_presentes);
+}
+
+#define LONGUEUR_CHAINE_BENCHMARK 22
+
+static EnsembleChaines ens_chaines;
+static char* chaines_presentes;
+static char* chaines_absentes;
+
+// Writes `nb` strings "utilisateur_" + 10 digits, one every LONGUEUR_CHAINE_BENCHMARK
+// bytes (not NUL-terminated); present strings have an even number, absent ones an odd one
+static char* generer_chaines(size_t nb, int parite) {
+    char* chaines = malloc(nb * LONGUEUR_CHAINE_BENCHMARK + 1);
+    for (size_t i = 0; i < nb; i++) {
+        unsigned long long n = (aleatoire() % 4999999999ULL) * 2 + parite;
+        snprintf(chaines + i * LONGUEUR_CHAINE_BENCHMARK, LONGUEUR_CHAINE_BENCHMARK + 1,
+                 "utilisateur_%010llu", n);
+    }
+    return chaines;
+}
+
+static void interner_presentes(size_t taille) {
+    size_t n = 0;
+    for (size_t i = 0; i < taille; i++) {
+        n += interner(ens_chaines, chaines_presentes + i * LONGUEUR_CHAINE_BENCHMARK, LONGUEUR_CHAINE_BENCHMARK);
+    }
+    nb_trouves = n;
+}
+
+static void construire_ensemble_chaines(size_t taille) {
+    liberer_ensemble_chaines(ens_chaines);
+    ens_chaines = ensemble_chaines_vide();
+    interner_presentes(taille);
+}
+
+static void rechercher_chaines_absentes(size_t taille) {
+    size_t n = 0;
+    for (size_t i = 0; i < taille; i++) {
+        n += appartient_chaine(ens_chaines, chaines_absentes + i * LONGUEUR_CHAINE_BENCHMARK, LONGUEUR_CHAINE_BENCHMARK);
+    }
+    nb_trouves = n;
+}
+
+void benchmark_ensemble_chaines(size_t taille) {
+    chaines_presentes = generer_chaines(taille, 0);
+    chaines_absentes = generer_chaines(taille, 1);
+    ens_chaines = ensemble_chaines_vide();
+
+    printf("\n**** Chaînes de %d octets : 1. premiers internements, 2. internements de chaînes présentes, "
+           "3. recherches de chaînes absentes ****\n", LONGUEUR_CHAINE_BENCHMARK);
+    fonction operations[] = {construire_ensemble_chaines, interner_presentes, rechercher_chaines_absentes};
+    test_rapidite(operations, 3, taille);
+
+    size_t n = ens_chaines->taille;
+    printf("%zu chaînes : %.1f octets d'arène, %zu octets d'entrée et %.1f octets d'alvéoles par chaîne\n",
+           n, (double)ens_chaines->arene->nb_octets / (double)n, sizeof(struct EntreeChaine),
+           (double)(ens_chaines->nb_alveoles * sizeof(int32_t)) / (double)n);
+
+    liberer_ensemble_chaines(ens_chaines);
+    free(chaines_presentes);
+    free(chaines_absentes);
+}
+
+static EnsembleCompresse compresse_a;
+static EnsembleCompresse compresse_b;
+static size_t nb_cles_a;
+
+static void construire_ensemble_dense(size_t taille) {
+    (void)taille;
+    liberer_ensemble(ens_a);
+    ens_a = ensemble_vide();
+    ajouter_lot(ens_a, cles_presentes, nb_cles_a);
+}
+
+static void construire_compresse(size_t taille) {
+    (void)taille;
+    liberer_ensemble_compresse(compresse_a);
+    compresse_a = ensemble_compresse_vide();
+    for (size_t i = 0; i < nb_cles_a; i++) {
+        ajouter_compresse(compresse_a, cles_presentes[i]);
+    }
+}
+
+static void appartient_ensemble_dense(size_t taille) {
+    size_t n = 0;
+    for (size_t i = 0; i < taille; i++) {
+        n += appartient(ens_a, cles_absentes[i]);
+    }
+    nb_trouves = n;
+}
+
+static void appartient_compresse_dense(size_t taille) {
+    size_t n = 0;
+    for (size_t i = 0; i < taille; i++) {
+        n += appartient_compresse(compresse_a, cles_absentes[i]);
+    }
+    nb_trouves = n;
+}
+
+static void union_compresse_dense(size_t taille) {
+    (void)taille;
+    EnsembleCompresse r = union_compresse(compresse_a, compresse_b);
+    nb_trouves = r->cardinal;
+    liberer_ensemble_compresse(r);
+}
+
+static void intersection_compresse_dense(size_t taille) {
+    (void)taille;
+    EnsembleCompresse r = intersection_compresse(compresse_a, compresse_b);
+    nb_trouves = r->cardinal;
+    liberer_ensemble_compresse(r);
+}
+
+void benchmark_ensemble_compresse(size_t taille) {
+    // A : chaque entier de [0, 2 taille[ avec probabilité 1/2, dans le désordre ;
+    // B : l'intervalle [taille, 2 taille[ ; les recherches portent sur [0, 2 taille[
+    cles_presentes = malloc(2 * taille * sizeof(type_base));
+    cles_absentes = malloc(taille * sizeof(type_base));
+    nb_cles_a = 0;
+    for (size_t i = 0; i < 2 * taille; i++) {
+        if (aleatoire() & 1) {
+            cles_presentes[nb_cles_a] = (type_base)i;
+            nb_cles_a++;
+        }
+    }
+    for (size_t i = nb_cles_a; i > 1; i--) {
+        size_t j = aleatoire() % i;
+        type_base x = cles_presentes[i - 1];
+        cles_presentes[i - 1] = cles_presentes[j];
+        cles_presentes[j] = x;
+    }
+    for (size_t i = 0; i < taille; i++) {
+        cles_absentes[i] = (type_base)(aleatoire() % (2 * taille));
+    }
+
+    ens_a = ensemble_vide();
+    ens_b = ensemble_vide();
+    compresse_a = ensemble_compresse_vide();
+    compresse_b = ensemble_compresse_vide();
+    for (size_t i = taille; i < 2 * taille; i++) {
+        ajouter(ens_b, (type_base)i);
+        ajouter_compresse(compresse_b, (type_base)i);
+    }
+    optimiser_compresse(compresse_b);
+
+    printf("\n**** Identifiants denses, |A| = %zu, |B| = %zu : 1. construction de A (Ensemble), "
+           "2. construction de A (EnsembleCompresse), 3. recherches (Ensemble), 4. recherches (EnsembleCompresse), "
+           "5. union (Ensemble), 6. union (EnsembleCompresse), 7. intersection (Ensemble), "
+           "8. intersection (EnsembleCompresse) ****\n", nb_cles_a, taille);
+    fonction operations[] = {construire_ensemble_dense, construire_compresse, appartient_ensemble_dense,
+                             appartient_compresse_dense, union_optimisee, union_compresse_dense,
+                             intersection_optimisee, intersection_compresse_dense};
+    nb_threads_operations = 1;
+    test_rapidite(operations, 8, taille);
+
+    printf("Octets par élément : A %.2f (Ensemble) / %.3f (EnsembleCompresse), "
+           "B %.2f (Ensemble) / %.5f (EnsembleCompresse, en plages)\n",
+           (double)(ens_a->taille * sizeof(struct Noeud) + ens_a->nb_alveoles * sizeof(ListeChainee)) / (double)ens_a->taille,
+           (double)memoire_compresse(compresse_a) / (double)compresse_a->cardinal,
+           (double)(ens_b->taille * sizeof(struct Noeud) + ens_b->nb_alveoles * sizeof(ListeChainee)) / (double)ens_b->taille,
+           (double)memoire_compresse(compresse_b) / (double)compresse_b->cardinal);
+
+    liberer_ensemble(ens_a);
+    liberer_ensemble(ens_b);
+    liberer_ensemble_compresse(compresse_a);
+    liberer_ensemble_compresse(compresse_b);
+    liberer_cles();
+}
+
+#define FICHIER_INSTANTANE "benchmark_ensemble.instantane"
+
+static void reconstruire_ensemble(size_t taille) {
+    liberer_ensemble(ens_chaine);
+    ens_chaine = ensemble_vide();
+    for (size_t i = 0; i < taille; i++) {
+        ajouter(ens_chaine, cles_presentes[i]);
+    }
+}
+
+static void charger_instantane(size_t taille) {
+    (void)taille;
+    liberer_ensemble_groupe(ens_groupe);
+    ens_groupe = charger_ensemble_groupe(FICHIER_INSTANTANE, false);
+}
+
+static void charger_et_verifier_instantane(size_t taille) {
+    (void)taille;
+    liberer_ensemble_groupe(ens_groupe);
+    ens_groupe = charger_ensemble_groupe(FICHIER_INSTANTANE, true);
+}
+
+static void charger_et_chercher(size_t taille) {
+    charger_instantane(taille);
+    appartient_presentes_groupe(taille);
+}
+
+void benchmark_instantane(size_t taille) {
+    generer_cles(taille);
+    ens_chaine = ensemble_vide();
+    reconstruire_ensemble(taille);
+    if (!sauvegarder_ensemble(ens_chaine, FICHIER_INSTANTANE)) {
+        liberer_ensemble(ens_chaine);
+        liberer_cles();
+        return;
+    }
+    ens_groupe = charger_ensemble_groupe(FICHIER_INSTANTANE, false);
+
+    printf("\n**** Instantané de %zu éléments (%zu Kio) : 1. reconstruction par ajouter, "
+           "2. chargement, 3. chargement avec vérification, 4. chargement puis recherches (présents), "
+           "5. recherches (présents), 6. recherches (absents) ****\n",
+           taille, ens_groupe->taille_projection / 1024);
+    fonction operations[] = {reconstruire_ensemble, charger_instantane, charger_et_verifier_instantane,
+                             charger_et_chercher, appartient_presentes_groupe, appartient_absentes_groupe};
+    test_rapidite(operations, 6, taille);
+
+    liberer_ensemble_groupe(ens_groupe);
+    liberer_ensemble(ens_chaine);
+    remove(FICHIER_INSTANTANE);
+    liberer_cles();
+}
+
+static void charger_sans_indication(size_t taille) {
+    liberer_ensemble(ens_chaine);
+    ens_chaine = ensemble_vide();
+    for (size_t i = 0; i < taille; i++) {
+        ajouter(ens_chaine, cles_presentes[i]);
+    }
+}
+
+static void charger_avec_capacite(size_t taille) {
+    liberer_ensemble(ens_chaine);
+    ens_chaine = ensemble_avec_capacite(taille);
+    for (size_t i = 0; i < taille; i++) {
+        ajouter(ens_chaine, cles_presentes[i]);
+    }
+}
+
+static void charger_avec_capacite_charge_1(size_t taille) {
+    liberer_ensemble(ens_chaine);
+    ens_chaine = ensemble_vide();
+    ensemble_facteurs_de_charge(ens_chaine, 0.25, 1.0);
+    ensemble_reserver(ens_chaine, taille);
+    for (size_t i = 0; i < taille; i++) {
+        ajouter(ens_chaine, cles_presentes[i]);
+    }
+}
+
+// Empties the set then fills it again (ens_chaine must contain the present keys)
+static void vider_et_remplir(size_t taille) {
+    for (size_t i = 0; i < taille; i++) {
+        supprimer(ens_chaine, cles_presentes[i]);
+    }
+    for (size_t i = 0; i < taille; i++) {
+        ajouter(ens_chaine, cles_presentes[i]);
+    }
+}
+
+static void appartient_presentes_charge_1(size_t taille) {
+    size_t n = 0;
+    for (size_t i = 0; i < taille; i++) {
+        n += appartient(ens_a, cles_presentes[i]);
+    }
+    nb_trouves = n;
+}
+
+void benchmark_capacite(size_t taille) {
+    generer_cles(taille);
+    ens_chaine = ensemble_vide();
+
+    printf("\n**** Chargement de %zu éléments : 1. sans indication, 2. ensemble_avec_capacite, "
+           "3. ensemble_avec_capacite et facteur de charge 1 ****\n", taille);
+    fonction chargements[] = {charger_sans_indication, charger_avec_capacite, charger_avec_capacite_charge_1};
+    test_rapidite(chargements, 3, taille);
+
+    // ens_a : facteur de charge 1 ; ens_chaine : facteur de charge 1/2
+    ens_a = ens_chaine;
+    ens_chaine = ensemble_vide();
+    charger_sans_indication(taille);
+    printf("\n**** Recherches (présents) : 1. facteur de charge 1/2 (%zu alvéoles), "
+           "2. facteur de charge 1 (%zu alvéoles) ****\n", ens_chaine->nb_alveoles, ens_a->nb_alveoles);
+    fonction recherches[] = {appartient_presentes_chaine, appartient_presentes_charge_1};
+    test_rapidite(recherches, 2, taille);
+    liberer_ensemble(ens_a);
+
+    printf("\n**** Vider puis remplir %zu éléments : sans réserve, puis avec ensemble_reserver ****\n", taille);
+    fonction cycles[] = {vider_et_remplir};
+    test_rapidite(cycles, 1, taille);
+    ensemble_reserver(ens_chaine, taille);
+    test_rapidite(cycles, 1, taille);
+
+    liberer_ensemble(ens_chaine);
+    liberer_cles();
+}
+
+// A deliberately poor hash function: the bucket is made of the high bits of
+// the (32-bit) key itself, so keys below 2^31 never use the upper half
+static uint64_t hachage_naif(uint64_t k, uint64_t graine) {
+    (void)graine;
+    return k << 32;
+}
+
+// Loads the present keys one by one into a set with statistics, looks up
+// every present and absent key, then prints the diagnostic
+static void diagnostiquer(fonction_hachage hachage, size_t taille) {
+    liberer_ensemble(ens_chaine);
+    ens_chaine = ensemble_vide_avec_hachage(hachage);
+    ensemble_activer_statistiques(ens_chaine, true);
+    for (size_t i = 0; i < taille; i++) {
+        ajouter(ens_chaine, cles_presentes[i]);
+    }
+    appartient_presentes_chaine(taille);
+    appartient_absentes_chaine(taille);
+    ensemble_diagnostic(ens_chaine, stdout);
+}
+
+void benchmark_statistiques(size_t taille) {
+    generer_cles(taille);
+    ens_chaine = ensemble_vide();
+    ajouter_lot(ens_chaine, cles_presentes, taille);
+
+    printf("\n**** Coût des statistiques : 1. recherches (présents), 2. recherches (absents), "
+           "3. et 4. les mêmes avec les statistiques activées ****\n");
+    fonction recherches[] = {appartient_presentes_chaine, appartient_absentes_chaine,
+                             appartient_presentes_chaine, appartient_absentes_chaine};
+    test_rapidite(recherches, 2, taille);
+    ensemble_activer_statistiques(ens_chaine, true);
+    test_rapidite(recherches + 2, 2, taille);
+
+    printf("\n**** Diagnostic de %zu ajouts puis %zu recherches (hachage_fibonacci) ****\n", taille, 2 * taille);
+    diagnostiquer(hachage_fibonacci, taille);
+
+    printf("\n**** Le même avec un hachage naïf (bits de poids fort de la clé) ****\n");
+    diagnostiquer(hachage_naif, taille);
+
+    liberer_ensemble(ens_chaine);
+    liberer_cles();
+}
+
+static EnsembleCoucou ens_coucou;
+
+static void construire_coucou(size_t taille) {
+    liberer_ensemble_coucou(ens_coucou);
+    ens_coucou = ensemble_coucou_vide();
+    for (size_t i = 0; i < taille; i++) {
+        ajouter_coucou(ens_coucou, cles_presentes[i]);
+    }
+}
+
+static void appartient_presentes_coucou(size_t taille) {
+    size_t n = 0;
+    for (size_t i = 0; i < taille; i++) {
+        n += appartient_coucou(ens_coucou, cles_presentes[i]);
+    }
+    nb_trouves = n;
+}
+
+static void appartient_absentes_coucou(size_t taille) {
+    size_t n = 0;
+    for (size_t i = 0; i < taille; i++) {
+        n += appartient_coucou(ens_coucou, cles_absentes[i]);
+    }
+    nb_trouves = n;
+}
+
+// Times every lookup of the present keys on its own (in the chained table
+// if coucou is false), then prints the percentiles
+static void afficher_latences_recherche(const char* nom, bool coucou, size_t taille) {
+    struct timespec debut, fin;
+    long* durees = malloc(taille * sizeof(long));
+    size_t n = 0;
+
+    for (size_t i = 0; i < taille; i++) {
+        clock_gettime(CLOCK_MONOTONIC, &debut);
+        n += coucou ? appartient_coucou(ens_coucou, cles_presentes[i]) : appartient(ens_chaine, cles_presentes[i]);
+        clock_gettime(CLOCK_MONOTONIC, &fin);
+        durees[i] = (fin.tv_sec - debut.tv_sec) * 1000000000 + (fin.tv_nsec - debut.tv_nsec);
+    }
+    nb_trouves = n;
+
+    qsort(durees, taille, sizeof(long), comparer_durees);
+    printf("  %-15s : médiane %ld ns, p99 %ld ns, p99.9 %ld ns, p99.99 %ld ns, max %ld ns\n",
+           nom, durees[taille / 2], durees[taille * 99 / 100], durees[taille * 999 / 1000],
+           durees[taille * 9999 / 10000], durees[taille - 1]);
+    free(durees);
+}
+
+void benchmark_ensemble_coucou(size_t taille) {
+    generer_cles(taille);
+    ens_chaine = ensemble_vide();
+    ajouter_lot(ens_chaine, cles_presentes, taille);
+
+    // Facteur de charge atteint juste avant chaque agrandissement (sur les grandes tables)
+    ens_coucou = ensemble_coucou_vide();
+    double charge_min = 1, charge_max = 0;
+    for (size_t i = 0; i < taille; i++) {
+        size_t nb_alveoles = ens_coucou->nb_alveoles;
+        double charge = (double)ens_coucou->taille / (double)(nb_alveoles * NB_CASES_ALVEOLE);
+        ajouter_coucou(ens_coucou, cles_presentes[i]);
+        if (ens_coucou->nb_alveoles != nb_alveoles && nb_alveoles >= 1024) {
+            charge_min = charge < charge_min ? charge : charge_min;
+            charge_max = charge > charge_max ? charge : charge_max;
+        }
+    }
+
+    printf("\n**** Coucou (%zu éléments) : 1. construction (coucou), 2. construction (listes chaînées), "
+           "3. recherches (présents, coucou), 4. recherches (présents, listes chaînées), "
+           "5. recherches (absents, coucou), 6. recherches (absents, listes chaînées) ****\n", taille);
+    fonction operations[] = {construire_coucou, charger_sans_indication, appartient_presentes_coucou,
+                             appartient_presentes_chaine, appartient_absentes_coucou, appartient_absentes_chaine};
+    test_rapidite(operations, 6, taille);
+
+    size_t histogramme[1];
+    size_t plus_longue = ensemble_histogramme_alveoles(ens_chaine, histogramme, 1);
+    printf("Facteur de charge avant agrandissement : entre %.3f et %.3f (coucou), 0.5 (listes chaînées)\n",
+           charge_min, charge_max);
+    printf("Octets par élément : %.1f (coucou), %.1f (listes chaînées) ; "
+           "alvéoles lues au pire : 2 (coucou), plus longue liste : %zu noeuds (listes chaînées)\n",
+           (double)(ens_coucou->nb_alveoles * sizeof(struct AlveoleCoucou)) / (double)ens_coucou->taille,
+           (double)(ens_chaine->taille * sizeof(struct Noeud) + ens_chaine->nb_alveoles * sizeof(ListeChainee)) / (double)ens_chaine->taille,
+           plus_longue);
+
+    printf("\n**** Latence de appartient (présents) ****\n");
+    afficher_latences_recherche("coucou", true, taille);
+    afficher_latences_recherche("listes chaînées", false, taille);
+
+    liberer_ensemble_coucou(ens_coucou);
+    liberer_ensemble(ens_chaine);
+    liberer_cles();
+}
+
+static Liste liste_cles;
+
+static void construire_depuis_liste(size_t taille) {
+    (void)taille;
+    liberer_ensemble(ens_chaine);
+    ens_chaine = liste_vers_ensemble_parallele(liste_cles, 1);
+}
+
+static void construire_depuis_liste_parallele(size_t taille) {
+    (void)taille;
+    liberer_ensemble(ens_chaine);
+    ens_chaine = liste_vers_ensemble_parallele(liste_cles, nb_threads_operations);
+}
+
+void benchmark_construction_parallele(size_t taille, int nb_threads) {
+    generer_cles(taille);
+    liste_cles = liste_vide();
+    for (size_t i = 0; i < taille; i++) {
+        ajouter_en_fin(liste_cles, cles_presentes[i]);
+    }
+    ens_chaine = ensemble_vide();
+    nb_threads_operations = nb_threads;
+
+    printf("\n**** Construction depuis une liste de %zu éléments : 1. ajouter sans indication, "
+           "2. ajouter avec ensemble_avec_capacite, 3. liste_vers_ensemble (répartition, 1 thread), "
+           "4. liste_vers_ensemble_parallele (%d threads) ****\n", taille, nb_threads);
+    fonction constructions[] = {charger_sans_indication, charger_avec_capacite, construire_depuis_liste,
+                                construire_depuis_liste_parallele};
+    test_rapidite(constructions, 4, taille);
+
+    liberer_ensemble(ens_chaine);
+    liberer_liste(liste_cles);
+    liberer_cles();
+}
+
+static EnsembleDeroule ens_deroule;
+
+static void construire_deroule(size_t taille) {
+    liberer_ensemble_deroule(ens_deroule);
+    ens_deroule = ensemble_deroule_vide();
+    for (size_t i = 0; i < taille; i++) {
+        ajouter_deroule(ens_deroule, cles_presentes[i]);
+    }
+}
+
+static void appartient_presentes_deroule(size_t taille) {
+    size_t n = 0;
+    for (size_t i = 0; i < taille; i++) {
+        n += appartient_deroule(ens_deroule, cles_presentes[i]);
+    }
+    nb_trouves = n;
+}
+
+static void appartient_absentes_deroule(size_t taille) {
+    size_t n = 0;
+    for (size_t i = 0; i < taille; i++) {
+        n += appartient_deroule(ens_deroule, cles_absentes[i]);
+    }
+    nb_trouves = n;
+}
+
+void benchmark_ensemble_deroule(size_t taille) {
+    generer_cles(taille);
+    ens_deroule = ensemble_deroule_vide();
+    ens_chaine = ensemble_vide();
+
+    printf("\n**** Listes déroulées (%zu éléments) : 1. construction (déroulées), 2. construction (listes chaînées), "
+           "3. recherches (présents, déroulées), 4. recherches (présents, listes chaînées), "
+           "5. recherches (absents, déroulées), 6. recherches (absents, listes chaînées) ****\n", taille);
+    fonction operations[] = {construire_deroule, charger_sans_indication, appartient_presentes_deroule,
+                             appartient_presentes_chaine, appartient_absentes_deroule, appartient_absentes_chaine};
+    test_rapidite(operations, 6, taille);
+
+    printf("%zu clés par bloc, %.2f clés par alvéole, %.1f clés par bloc en moyenne\n",
+           (size_t)NB_CLES_BLOC, (double)ens_deroule->taille / (double)ens_deroule->nb_alveoles,
+           (double)ens_deroule->taille / (double)ens_deroule->nb_blocs);
+    printf("Octets par élément : %.1f (déroulées), %.1f (listes chaînées)\n",
+           (double)memoire_deroule(ens_deroule) / (double)ens_deroule->taille,
+           (double)(ens_chaine->taille * sizeof(struct Noeud) + ens_chaine->nb_alveoles * sizeof(ListeChainee)) / (double)ens_chaine->taille);
+
+    liberer_ensemble_deroule(ens_deroule);
+    liberer_ensemble(ens_chaine);
+    liberer_cles();
+}
+
+// Builds ens_a from the keys 0..taille-1 with hachage_naif: below 65536, they
+// all fall into bucket 0 (whatever the number of buckets up to 65536)
+static void construire_collisions(size_t taille) {
+    liberer_ensemble(ens_a);
+    ens_a = ensemble_vide_avec_hachage(hachage_naif);
+    for (size_t i = 0; i < taille; i++) {
+        ajouter(ens_a, (type_base)i);
+    }
+}
+
+static void appartient_presentes_collisions(size_t taille) {
+    size_t n = 0;
+    for (size_t i = 0; i < taille; i++) {
+        n += appartient(ens_a, (type_base)i);
+    }
+    nb_trouves = n;
+}
+
+static void appartient_absentes_collisions(size_t taille) {
+    size_t n = 0;
+    for (size_t i = 0; i < taille; i++) {
+        n += appartient(ens_a, (type_base)(taille + i));
+    }
+    nb_trouves = n;
+}
+
+static void construire_et_vider_collisions(size_t taille) {
+    construire_collisions(taille);
+    for (size_t i = 0; i < taille; i++) {
+        supprimer(ens_a, (type_base)i);
+    }
+}
+
+void benchmark_arborisation(size_t taille) {
+    if (2 * taille > 65536) {
+        taille = 32768; // Au-delà, les clés ne tombent plus toutes dans la même alvéole
+    }
+    ens_a = ensemble_vide();
+
+    printf("\n**** %zu clés dans la même alvéole : 1. construction, 2. recherches (présents), "
+           "3. recherches (absents), 4. construction puis suppression de tout ****\n", taille);
+    fonction operations[] = {construire_collisions, appartient_presentes_collisions,
+                             appartient_absentes_collisions, construire_et_vider_collisions};
+    construire_collisions(taille);
+    test_rapidite(operations, 4, taille);
+
+    construire_collisions(taille);
+    printf("Alvéole 0 : %zu noeuds, arbre de hauteur %d\n", ens_a->taille,
+           ens_a->arbres != NULL ? hauteur_avl(ens_a->arbres[0]) : -1);
+    liberer_ensemble(ens_a);
+
+    // Libération pendant une migration progressive, avec des arbres et sans réserve
+    ens_a = ensemble_vide_avec_hachage(hachage_naif);
+    ensemble_utiliser_reserve(ens_a, false);
+    ensemble_redimensionnement_progressif(ens_a, true);
+    for (size_t i = 0; i < taille && (ens_a->arbres == NULL || ens_a->ancienne_table == NULL); i++) {
+        ajouter(ens_a, (type_base)i);
+    }
+    printf("Libération pendant une migration (arbres : %s, migration en cours : %s)\n",
+           ens_a->arbres != NULL ? "oui" : "non", ens_a->ancienne_table != NULL ? "oui" : "non");
+    liberer_ensemble(ens_a);
+}
+
+static DictionnaireOrdonne dict_ordonne;
+static Dictionnaire dict_chaine;
+
+static void construire_ordonne(size_t taille) {
+    liberer_dictionnaire_ordonne(dict_ordonne);
+    dict_ordonne = dictionnaire_ordonne_vide();
+    for (size_t i = 0; i < taille; i++) {
+        inserer_ou_maj_ordonne(dict_ordonne, cles_presentes[i], (type_valeur)i);
+    }
+}
+
+static void construire_dictionnaire(size_t taille) {
+    liberer_dictionnaire(dict_chaine);
+    dict_chaine = dictionnaire_vide();
+    for (size_t i = 0; i < taille; i++) {
+        inserer_ou_maj(dict_chaine, cles_presentes[i], (type_valeur)i);
+    }
+}
+
+static void obtenir_presentes_ordonne(size_t taille) {
+    size_t n = 0;
+    for (size_t i = 0; i < taille; i++) {
+        n += (size_t)*obtenir_ordonne(dict_ordonne, cles_presentes[i]);
+    }
+    nb_trouves = n;
+}
+
+static void obtenir_presentes_dictionnaire(size_t taille) {
+    size_t n = 0;
+    for (size_t i = 0; i < taille; i++) {
+        n += (size_t)*obtenir(dict_chaine, cles_presentes[i]);
+    }
+    nb_trouves = n;
+}
+
+static void parcourir_cles_ordonne(size_t taille) {
+    (void)taille;
+    Liste l = cles_ordonnees(dict_ordonne);
+    nb_trouves = longueur(l);
+    liberer_liste(l);
+}
+
+static void parcourir_cles_dictionnaire(size_t taille) {
+    (void)taille;
+    Liste l = cles_dictionnaire(dict_chaine);
+    nb_trouves = longueur(l);
+    liberer_liste(l);
+}
+
+// Checks that the keys come out in the order of their first insertion
+static bool ordre_conserve(size_t taille) {
+    Liste l = cles_ordonnees(dict_ordonne);
+    Dictionnaire vues = dictionnaire_vide();
+    size_t j = 0;
+    bool ok = true;
+    for (size_t i = 0; i < taille && ok; i++) {
+        if (obtenir(vues, cles_presentes[i]) == NULL) {
+            inserer_ou_maj(vues, cles_presentes[i], 0);
+            ok = j < longueur(l) && element(l, j) == cles_presentes[i];
+            j++;
+        }
+    }
+    ok = ok && j == longueur(l);
+    liberer_dictionnaire(vues);
+    liberer_liste(l);
+    return ok;
+}
+
+void benchmark_dictionnaire_ordonne(size_t taille) {
+    generer_cles(taille);
+    dict_ordonne = dictionnaire_ordonne_vide();
+    dict_chaine = dictionnaire_vide();
+
+    printf("\n**** Dictionnaire ordonné (%zu clés) : 1. construction (ordonné), 2. construction (Dictionnaire), "
+           "3. recherches (ordonné), 4. recherches (Dictionnaire), "
+           "5. liste des clés (ordonné), 6. liste des clés (Dictionnaire) ****\n", taille);
+    fonction operations[] = {construire_ordonne, construire_dictionnaire, obtenir_presentes_ordonne,
+                             obtenir_presentes_dictionnaire, parcourir_cles_ordonne, parcourir_cles_dictionnaire};
+    test_rapidite(operations, 6, taille);
+
+    printf("Indices sur %d octets, ordre d'insertion conservé : %s\n", dict_ordonne->largeur_indice,
+           ordre_conserve(taille) ? "oui" : "NON");
+    printf("Octets par clé : %.1f (ordonné), %.1f (Dictionnaire)\n",
+           (double)memoire_ordonne(dict_ordonne) / (double)dict_ordonne->taille,
+           (double)(dict_chaine->taille * sizeof(struct Noeud) + dict_chaine->nb_alveoles * sizeof(ListeChainee)) / (double)dict_chaine->taille);
+
+    liberer_dictionnaire_ordonne(dict_ordonne);
+    liberer_dictionnaire(dict_chaine);
+    liberer_cles();
+}
+
+// Columns of the group-by and join benchmark: faits has taille rows whose keys
+// are ids of the dimension (taille / 16 distinct keys, each present once)
+static Liste colonne_faits;
+static Liste colonne_dimension;
+
+static void incrementer_compteur(type_valeur* v, bool existait, void* contexte) {
+    (void)contexte;
+    *v = existait ? *v + 1 : 1;
+}
+
+static void compter_avec_dictionnaire(size_t taille) {
+    Dictionnaire d = dictionnaire_vide();
+    for (size_t i = 0; i < taille; i++) {
+        inserer_ou_maj_avec(d, colonne_faits->tableau[i], incrementer_compteur, NULL);
+    }
+    nb_trouves = d->taille;
+    liberer_dictionnaire(d);
+}
+
+static void compter_avec_grouper(size_t taille) {
+    (void)taille;
+    struct Groupes g = grouper_compter(colonne_faits);
+    nb_trouves = longueur(g.cles);
+    liberer_groupes(g);
+}
+
+// Join on a unique key: the dimension row of each fact, found in a dictionary
+static void joindre_avec_dictionnaire(size_t taille) {
+    Dictionnaire d = dictionnaire_vide();
+    for (size_t i = 0; i < longueur(colonne_dimension); i++) {
+        inserer_ou_maj(d, colonne_dimension->tableau[i], (type_valeur)i);
+    }
+    struct Jointure j = {liste_vide(), liste_vide()};
+    for (size_t i = 0; i < taille; i++) {
+        type_valeur* v = obtenir(d, colonne_faits->tableau[i]);
+        if (v != NULL) {
+            ajouter_en_fin(j.indices_gauche, (type_base)i);
+            ajouter_en_fin(j.indices_droite, *v);
+        }
+    }
+    nb_trouves = longueur(j.indices_gauche);
+    liberer_jointure(j);
+    liberer_dictionnaire(d);
+}
+
+static void joindre_avec_jointure(size_t taille) {
+    (void)taille;
+    struct Jointure j = jointure_hachage(colonne_faits, colonne_dimension);
+    nb_trouves = longueur(j.indices_gauche);
+    liberer_jointure(j);
+}
+
+void benchmark_operateurs(size_t taille) {
+    size_t nb_cles = taille / 16;
+    colonne_faits = liste_vide();
+    colonne_dimension = liste_vide();
+    for (size_t i = 0; i < nb_cles; i++) {
+        ajouter_en_fin(colonne_dimension, (type_base)(aleatoire() & 0x3FFFFFFF));
+    }
+    for (size_t i = 0; i < taille; i++) {
+        ajouter_en_fin(colonne_faits, colonne_dimension->tableau[aleatoire() % nb_cles]);
+    }
+
+    printf("\n**** Regroupement et jointure (%zu rangées, %zu clés) : 1. comptage (Dictionnaire), "
+           "2. comptage (grouper_compter), 3. jointure (Dictionnaire), 4. jointure (jointure_hachage) ****\n",
+           taille, nb_cles);
+    fonction operations[] = {compter_avec_dictionnaire, compter_avec_grouper,
+                             joindre_avec_dictionnaire, joindre_avec_jointure};
+    test_rapidite(operations, 4, taille);
+
+    liberer_liste(colonne_faits);
+    liberer_liste(colonne_dimension);
+}
+
+// Stream of the sketch benchmark: the keys (skewed towards small ids), and
+// the same keys transformed by objet_vers_nombre
+static type_base* flot;
+static uint64_t* flot_nombres;
+static HyperLogLog hll;
+static CountMin esquisse;
+
+static void distinctes_avec_ensemble(size_t taille) {
+    Ensemble e = ensemble_vide();
+    for (size_t i = 0; i < taille; i++) {
+        if (!appartient(e, flot[i])) {
+            ajouter(e, flot[i]);
+        }
+    }
+    nb_trouves = e->taille;
+    liberer_ensemble(e);
+}
+
+static void distinctes_avec_hyperloglog(size_t taille) {
+    for (size_t i = 0; i < taille; i++) {
+        hyperloglog_ajouter(hll, flot_nombres[i]);
+    }
+}
+
+static void distinctes_avec_hyperloglog_lot(size_t taille) {
+    hyperloglog_ajouter_lot(hll, flot_nombres, taille);
+}
+
+static void frequences_avec_dictionnaire(size_t taille) {
+    Dictionnaire d = dictionnaire_vide();
+    for (size_t i = 0; i < taille; i++) {
+        inserer_ou_maj_avec(d, flot[i], incrementer_compteur, NULL);
+    }
+    nb_trouves = d->taille;
+    liberer_dictionnaire(d);
+}
+
+static void frequences_avec_count_min(size_t taille) {
+    for (size_t i = 0; i < taille; i++) {
+        count_min_ajouter(esquisse, flot_nombres[i], 1);
+    }
+}
+
+void benchmark_esquisses(size_t taille) {
+    size_t nb_ids = taille / 4;
+    flot = malloc(taille * sizeof(type_base));
+    flot_nombres = malloc(taille * sizeof(uint64_t));
+    for (size_t i = 0; i < taille; i++) {
+        uint64_t k = aleatoire() % nb_ids;
+        flot[i] = (type_base)(k * k / nb_ids * 2654435761u % 0x3FFFFFFF);
+        flot_nombres[i] = objet_vers_nombre(flot[i]);
+    }
+    hll = hyperloglog_vide(14, aleatoire());
+    esquisse = count_min_vide(1 << 14, 4, aleatoire());
+
+    printf("\n**** Esquisses (flot de %zu clés) : 1. clés distinctes (Ensemble), 2. clés distinctes (HyperLogLog), "
+           "3. clés distinctes (HyperLogLog, par lots), 4. fréquences (Dictionnaire), 5. fréquences (Count-Min) ****\n", taille);
+    fonction operations[] = {distinctes_avec_ensemble, distinctes_avec_hyperloglog, distinctes_avec_hyperloglog_lot,
+                             frequences_avec_dictionnaire, frequences_avec_count_min};
+    test_rapidite(operations, 5, taille);
+    liberer_hyperloglog(hll);
+    liberer_count_min(esquisse);
+
+    // Valeurs exactes
+    Dictionnaire exact = dictionnaire_vide();
+    for (size_t i = 0; i < taille; i++) {
+        inserer_ou_maj_avec(exact, flot[i], incrementer_compteur, NULL);
+    }
+    double nb_distinctes = (double)exact->taille;
+    printf("Exact : %zu clés distinctes, %.1f Mio (Ensemble)\n", exact->taille,
+           (double)(exact->taille * sizeof(struct Noeud) + exact->nb_alveoles * sizeof(ListeChainee)) / 1048576.0);
+
+    for (int precision = 8; precision <= 16; precision += 2) {
+        hll = hyperloglog_vide(precision, aleatoire());
+        HyperLogLog moitie = hyperloglog_vide(precision, hll->graine);
+        hyperloglog_ajouter_lot(hll, flot_nombres, taille / 2);
+        hyperloglog_ajouter_lot(moitie, flot_nombres + taille / 2, taille - taille / 2);
+        hyperloglog_fusionner(hll, moitie);
+        double estimation = hyperloglog_estimer(hll);
+        printf("HyperLogLog, %6zu octets : %.0f clés distinctes (erreur %+.2f %%, attendue ±%.2f %%)\n",
+               hll->nb_registres, estimation, 100.0 * (estimation - nb_distinctes) / nb_distinctes,
+               104.0 / sqrt((double)hll->nb_registres));
+        liberer_hyperloglog(moitie);
+        liberer_hyperloglog(hll);
+    }
+
+    Liste cles = cles_dictionnaire(exact);
+    for (size_t largeur = 1 << 10; largeur <= 1 << 16; largeur *= 4) {
+        esquisse = count_min_vide(largeur, 4, aleatoire());
+        for (size_t i = 0; i < taille; i++) {
+            count_min_ajouter(esquisse, flot_nombres[i], 1);
+        }
+        // Excès moyen sur toutes les clés, et erreur relative sur les plus fréquentes
+        double exces = 0, erreur_frequentes = 0;
+        size_t nb_frequentes = 0;
+        for (size_t i = 0; i < longueur(cles); i++) {
+            type_base cle = cles->tableau[i];
+            uint32_t vrai = (uint32_t)*obtenir(exact, cle);
+            uint32_t difference = count_min_estimer(esquisse, objet_vers_nombre(cle)) - vrai;
+            exces += difference;
+            if (vrai >= 100) {
+                erreur_frequentes += (double)difference / (double)vrai;
+                nb_frequentes++;
+            }
+        }
+        printf("Count-Min 4 x %5zu, %7zu octets : excès moyen %.1f (borne e/largeur * total = %.0f), "
+               "erreur relative %.1f %% sur les %zu clés vues au moins 100 fois\n",
+               esquisse->largeur, esquisse->largeur * 4 * sizeof(uint32_t), exces / (double)longueur(cles),
+               exp(1.0) / (double)esquisse->largeur * (double)esquisse->total,
+               nb_frequentes > 0 ? 100.0 * erreur_frequentes / (double)nb_frequentes : 0.0, nb_frequentes);
+        liberer_count_min(esquisse);
+    }
+
+    liberer_liste(cles);
+    liberer_dictionnaire(exact);
+    free(flot_nombres);
+    free(flot);
+}
+
+void benchmark_cles_64_bits(size_t taille) {
+    if (sizeof(type_base) < 8) {
+        printf("\n**** Clés de 64 bits : compiler avec -DCLES_64_BITS ****\n");
+        return;
+    }
+
+    // Clés k << 32 : leurs 32 bits de poids faible sont nuls
+    const char* noms[] = {"multiplicatif_reel", "fibonacci", "murmur3", "wyhash"};
+    fonction_hachage fonctions[] = {hachage_multiplicatif_reel, hachage_fibonacci,
+                                    hachage_murmur3, hachage_wyhash};
+    cles_presentes = malloc(taille * sizeof(type_base));
+    cles_absentes = malloc(taille * sizeof(type_base));
+    type_base* aleatoires = malloc(taille * sizeof(type_base));
+    for (size_t i = 0; i < taille; i++) {
+        cles_presentes[i] = (type_base)((uint64_t)(i + 1) << 32);
+        cles_absentes[i] = (type_base)((uint64_t)(taille + i + 1) << 32);
+        aleatoires[i] = (type_base)(aleatoire() & 0xFFFFFFFF00000000ULL);
+    }
+
+    fonction construction[] = {construire_et_rechercher};
+    for (size_t f = 0; f < 4; f++) {
+        hachage_courant = fonctions[f];
+        printf("\n**** Clés k << 32, hachage %s : construction + recherches infructueuses ****\n", noms[f]);
+        test_rapidite(construction, 1, taille);
+        afficher_repartition("k << 32", cles_presentes, taille);
+        afficher_repartition("aléat. << 32", aleatoires, taille);
+    }
+
+    // EnsembleCompresse n'accepte que des clés de 32 bits, conversions comprises
+    // (une clé plus grande déclenche une erreur au lieu d'être tronquée)
+    Liste bornes = liste_vide();
+    ajouter_en_fin(bornes, INT32_MIN);
+    ajouter_en_fin(bornes, -1);
+    ajouter_en_fin(bornes, 0);
+    ajouter_en_fin(bornes, INT32_MAX);
+    EnsembleCompresse compresse = liste_vers_ensemble_compresse(bornes);
+    bool bornes_retrouvees = compresse->cardinal == 4;
+    for (size_t i = 0; i < longueur(bornes); i++) {
+        bornes_retrouvees = bornes_retrouvees && appartient_compresse(compresse, element(bornes, (int)i));
+    }
+    printf("\nEnsembleCompresse depuis une liste : INT32_MIN, -1, 0 et INT32_MAX retrouvés : %s\n",
+           bornes_retrouvees ? "oui" : "NON");
+    liberer_ensemble_compresse(compresse);
+    liberer_liste(bornes);
+
+    free(aleatoires);
+    liberer_cles();
+}
+
+static EnsembleStatique ens_statique;
+
+static void construire_statique(size_t taille) {
+    (void)taille;
+    liberer_ensemble_statique(ens_statique);
+    ens_statique = ensemble_statique_depuis_liste(liste_cles);
+}
+
+static void appartient_presentes_statique(size_t taille) {
+    size_t n = 0;
+    for (size_t i = 0; i < taille; i++) {
+        n += appartient_statique(ens_statique, cles_presentes[i]);
+    }
+    nb_trouves = n;
+}
+
+static void appartient_absentes_statique(size_t taille) {
+    size_t n = 0;
+    for (size_t i = 0; i < taille; i++) {
+        n += appartient_statique(ens_statique, cles_absentes[i]);
+    }
+    nb_trouves = n;
+}
+
+void benchmark_ensemble_statique(size_t taille) {
+    generer_cles(taille);
+    liste_cles = liste_vide();
+    for (size_t i = 0; i < taille; i++) {
+        ajouter_en_fin(liste_cles, cles_presentes[i]);
+    }
+    ens_chaine = liste_vers_ensemble_parallele(liste_cles, 1);
+    ens_statique = ensemble_statique_depuis_liste(liste_cles);
+
+    printf("\n**** Ensemble statique (%zu éléments) : 1. construction depuis la liste (statique), "
+           "2. construction depuis la liste (listes chaînées), 3. recherches (présents, statique), "
+           "4. recherches (présents, listes chaînées), 5. recherches (absents, statique), "
+           "6. recherches (absents, listes chaînées) ****\n", taille);
+    fonction operations[] = {construire_statique, construire_depuis_liste, appartient_presentes_statique,
+                             appartient_presentes_chaine, appartient_absentes_statique, appartient_absentes_chaine};
+    test_rapidite(operations, 6, taille);
+
+    // Tous les éléments doivent être retrouvés, et les absents rejetés
+    size_t nb_presents = 0, nb_absents = 0;
+    for (size_t i = 0; i < taille; i++) {
+        nb_presents += appartient_statique(ens_statique, cles_presentes[i]);
+        nb_absents += appartient_statique(ens_statique, cles_absentes[i]);
+    }
+    size_t octets_cles = ens_statique->nb_cles * sizeof(type_base);
+    printf("Présents retrouvés : %zu / %zu, absents acceptés : %zu\n", nb_presents, taille, nb_absents);
+    printf("Bits par élément hors clés : %.2f (pilotes et renvois), %zu seaux ; "
+           "octets par élément : %.1f (statique), %.1f (listes chaînées)\n",
+           8.0 * (double)(memoire_statique(ens_statique) - octets_cles) / (double)ens_statique->nb_cles,
+           ens_statique->nb_seaux,
+           (double)memoire_statique(ens_statique) / (double)ens_statique->nb_cles,
+           (double)(ens_chaine->taille * sizeof(struct Noeud) + ens_chaine->nb_alveoles * sizeof(ListeChainee)) / (double)ens_chaine->taille);
+
+    liberer_ensemble_statique(ens_statique);
+    liberer_ensemble(ens_chaine);
+    liberer_liste(liste_cles);
+    liberer_cles();
+}
+
+// Zipfian traces: the key of rank r (from 0) is requested with a probability
+// proportional to 1 / (r + 1)^s
+static type_base* trace;
+static size_t capacite_cache;
+
+static void generer_zipf(type_base* t, size_t n, size_t nb_cles, double s) {
+    // Fonction de répartition, puis recherche dichotomique d'un nombre uniforme
+    double* repartition = malloc(nb_cles * sizeof(double));
+    double somme = 0;
+    for (size_t r = 0; r < nb_cles; r++) {
+        somme += pow((double)(r + 1), -s);
+        repartition[r] = somme;
+    }
+    for (size_t i = 0; i < n; i++) {
+        double u = (double)(aleatoire() >> 11) / 9007199254740992.0 * somme;
+        size_t bas = 0, haut = nb_cles - 1;
+        while (bas < haut) {
+            size_t milieu = (bas + haut) / 2;
+            if (repartition[milieu] < u) {
+                bas = milieu + 1;
+            } else {
+                haut = milieu;
+            }
+        }
+        t[i] = (type_base)bas;
+    }
+    free(repartition);
+}
+
+// Replays the trace through a cache (a miss loads the key), returns the number of hits
+static size_t rejouer(enum PolitiqueCache politique, size_t taille) {
+    Cache c = cache_vide(capacite_cache, politique);
+    for (size_t i = 0; i < taille; i++) {
+        if (obtenir_cache(c, trace[i]) == NULL) {
+            inserer_ou_maj_cache(c, trace[i], (type_valeur)i);
+        }
+    }
+    size_t succes = c->nb_succes;
+    liberer_cache(c);
+    return succes;
+}
+
+static void rejouer_lru(size_t taille) {
+    nb_trouves = rejouer(POLITIQUE_LRU, taille);
+}
+
+static void rejouer_clock(size_t taille) {
+    nb_trouves = rejouer(POLITIQUE_CLOCK, taille);
+}
+
+static void rejouer_2q(size_t taille) {
+    nb_trouves = rejouer(POLITIQUE_2Q, taille);
+}
+
+// The former approach: the values in a Dictionnaire, the last use of each
+// key in another, and a scan of the resident keys to find the oldest one
+static void rejouer_dictionnaires(size_t taille) {
+    Dictionnaire valeurs = dictionnaire_vide();
+    Dictionnaire recence = dictionnaire_vide();
+    Liste residentes = liste_vide();
+    size_t succes = 0;
+    for (size_t i = 0; i < taille; i++) {
+        type_base cle = trace[i];
+        if (obtenir(valeurs, cle) != NULL) {
+            *obtenir(recence, cle) = (type_valeur)i;
+            succes++;
+            continue;
+        }
+        if (longueur(residentes) == capacite_cache) {
+            size_t plus_ancienne = 0;
+            type_valeur t_min = *obtenir(recence, residentes->tableau[0]);
+            for (size_t j = 1; j < longueur(residentes); j++) {
+                type_valeur t = *obtenir(recence, residentes->tableau[j]);
+                if (t < t_min) {
+                    t_min = t;
+                    plus_ancienne = j;
+                }
+            }
+            supprimer_cle(valeurs, residentes->tableau[plus_ancienne]);
+            supprimer_cle(recence, residentes->tableau[plus_ancienne]);
+            residentes->tableau[plus_ancienne] = residentes->tableau[longueur(residentes) - 1];
+            supprimer_dernier(residentes);
+        }
+        inserer_ou_maj(valeurs, cle, (type_valeur)i);
+        inserer_ou_maj(recence, cle, (type_valeur)i);
+        ajouter_en_fin(residentes, cle);
+    }
+    nb_trouves = succes;
+    liberer_liste(residentes);
+    liberer_dictionnaire(recence);
+    liberer_dictionnaire(valeurs);
+}
+
+void benchmark_cache(size_t taille) {
+    trace = malloc(taille * sizeof(type_base));
+    const char* noms[] = {"LRU", "CLOCK", "2Q"};
+
+    // Taux de succès : Zipf 0,8 et 0,99, puis Zipf 0,99 dont un quart des
+    // requêtes sont des parcours de clés jamais revues
+    printf("\n**** Cache : taux de succès sur %zu requêtes parmi %zu clés ****\n", taille, taille);
+    for (int t = 0; t < 3; t++) {
+        generer_zipf(trace, taille, taille, t == 0 ? 0.8 : 0.99);
+        if (t == 2) {
+            for (size_t i = 0; i < taille; i++) {
+                if ((i / 10000) % 4 == 3) {
+                    trace[i] = (type_base)(taille + i);
+                }
+            }
+        }
+        const char* traces[] = {"Zipf 0.8 ", "Zipf 0.99", "Zipf 0.99 + parcours"};
+        for (size_t diviseur = 100; diviseur >= 10; diviseur /= 10) {
+            capacite_cache = taille / diviseur;
+            printf("%-20s, capacité %7zu :", traces[t], capacite_cache);
+            for (int p = 0; p < 3; p++) {
+                printf(" %s %.1f %%%s", noms[p], 100.0 * (double)rejouer((enum PolitiqueCache)p, taille) / (double)taille,
+                       p < 2 ? "," : "\n");
+            }
+        }
+    }
+
+    generer_zipf(trace, taille, taille, 0.99);
+    capacite_cache = taille / 1000;
+    printf("\n**** Cache (Zipf 0.99, capacité %zu) : 1. LRU, 2. CLOCK, 3. 2Q ****\n", capacite_cache);
+    fonction rejeux[] = {rejouer_lru, rejouer_clock, rejouer_2q};
+    test_rapidite(rejeux, 3, taille);
+
+    // Une éviction parcourt toutes les clés : dix fois moins de requêtes suffisent
+    printf("\n**** Cache (Zipf 0.99, capacité %zu) : 1. LRU, 2. deux Dictionnaire et "
+           "recherche de la plus ancienne ****\n", capacite_cache);
+    fonction rejeux_lents[] = {rejouer_lru, rejouer_dictionnaires};
+    test_rapidite(rejeux_lents, 2, taille / 10);
+
+    free(trace);
+}
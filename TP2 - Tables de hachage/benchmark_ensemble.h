@@ -0,0 +1,247 @@
+/**
+ * @file benchmark_ensemble.h
+ * @author
+ * */
+
+#ifndef __BENCHMARK__ENSEMBLE__H__
+#define __BENCHMARK__ENSEMBLE__H__
+
+#include <stdlib.h>
+
+/**
+ * @brief Le nombre d'éléments utilisé par défaut pour les benchmarks des ensembles.
+ */
+#define TAILLE_BENCHMARK 1000000
+
+/**
+ * @brief Compare `appartient` (table chaînée) et `appartient_eg`
+ * (table à sondage par groupes) sur des recherches fructueuses puis
+ * infructueuses. \n
+ * Les deux tables contiennent **taille** éléments aléatoires ; chaque
+ * fonction chronométrée effectue **taille** recherches.
+ * @param taille le nombre d'éléments (et de recherches).
+ */
+void benchmark_ensemble_groupe(size_t taille);
+
+/**
+ * @brief Compare les fonctions de hachage de `hachage.h`. \n
+ * Pour chaque fonction, on chronomètre la construction d'un ensemble de
+ * **taille** éléments suivie de **taille** recherches infructueuses, puis
+ * on mesure la qualité de la répartition dans les alvéoles pour des clés
+ * aléatoires, consécutives et espacées de 1024 : longueur maximale d'une
+ * alvéole et nombre moyen de comparaisons d'une recherche fructueuse
+ * (environ 1 + taille / (2 * nb_alveoles) pour une répartition uniforme).
+ * @param taille le nombre d'éléments.
+ */
+void benchmark_fonctions_hachage(size_t taille);
+
+/**
+ * @brief Compare la latence de `ajouter` avec un redimensionnement d'un
+ * coup et avec un redimensionnement progressif. \n
+ * Chaque insertion est chronométrée individuellement ; on affiche la
+ * médiane, les centiles 99, 99.9 et 99.99 ainsi que le maximum.
+ * @param taille le nombre d'insertions.
+ */
+void benchmark_redimensionnement_progressif(size_t taille);
+
+/**
+ * @brief Compare les noeuds alloués avec malloc et ceux d'une réserve. \n
+ * On chronomètre la construction (ajout de **taille** éléments, suppression
+ * d'un élément sur deux, ajout de **taille** / 2 nouveaux éléments, puis
+ * libération), ainsi que des recherches fructueuses dans l'ensemble obtenu.
+ * On affiche aussi le nombre d'allocations et de libérations demandées au système.
+ * @param taille le nombre d'éléments.
+ */
+void benchmark_reserve_noeuds(size_t taille);
+
+/**
+ * @brief Mesure le débit (en millions d'opérations par seconde) de
+ * l'ensemble concurrent et d'un `Ensemble` protégé par un unique verrou,
+ * de 1 à **nb_threads_max** threads, pour un mélange à dominante de lectures
+ * (90 % de recherches, 5 % d'ajouts, 5 % de suppressions) puis à dominante
+ * d'écritures (20 %, 40 %, 40 %). \n
+ * L'ensemble contient initialement **taille** éléments ; chaque thread
+ * effectue **taille** opérations.
+ * @param taille le nombre d'éléments (et d'opérations par thread),
+ * @param nb_threads_max le nombre maximal de threads.
+ */
+void benchmark_ensemble_concurrent(size_t taille, int nb_threads_max);
+
+/**
+ * @brief Compare les opérations une par une et par lots sur un grand ensemble
+ * (à choisir bien plus grand que le dernier niveau de cache). \n
+ * On chronomètre la construction avec `ajouter` puis avec `ajouter_lot`,
+ * et **taille** recherches fructueuses puis infructueuses avec `appartient`
+ * puis avec `appartient_lot`.
+ * @param taille le nombre d'éléments.
+ */
+void benchmark_lots(size_t taille);
+
+/**
+ * @brief Compare l'union et l'intersection d'un ensemble A de **taille** éléments
+ * et d'un ensemble B de taille / 4 éléments (dont la moitié sont dans A)
+ * calculées "à la main" (`ensemble_vers_liste` puis `ajouter`/`appartient`)
+ * avec `ensemble_union` et `ensemble_intersection` ; puis chronomètre
+ * `ensemble_difference`, `est_sous_ensemble`, et les versions parallèles.
+ * @param taille le nombre d'éléments de A,
+ * @param nb_threads le nombre de threads des versions parallèles.
+ */
+void benchmark_operations_ensemblistes(size_t taille, int nb_threads);
+
+/**
+ * @brief Mesure l'effet du filtre de Bloom (`ensemble_utiliser_filtre`) sur
+ * un ensemble de **taille** éléments, sans filtre puis avec 4, 8, 12 et 16 bits
+ * par clé : taux de faux positifs, puis durée de **taille** recherches
+ * infructueuses et fructueuses.
+ * @param taille le nombre d'éléments.
+ */
+void benchmark_filtre_bloom(size_t taille);
+
+/**
+ * @brief Compare un ensemble avec doublons et un multi-ensemble
+ * (`ensemble_mode_multiensemble`) sur **taille** éléments tirés selon une loi
+ * très déséquilibrée (log-uniforme entre 1 et **taille** : quelques éléments
+ * reviennent très souvent) : durée des ajouts, des recherches infructueuses
+ * et des suppressions, nombre de noeuds, mémoire et plus longue liste chaînée.
+ * @param taille le nombre d'éléments ajoutés.
+ */
+void benchmark_multiensemble(size_t taille);
+
+/**
+ * @brief Chronomètre `interner` sur **taille** chaînes distinctes de 22 octets
+ * qui ont un long préfixe commun ("utilisateur_" suivi de 10 chiffres) :
+ * premiers internements, internements de chaînes déjà présentes, puis
+ * recherches de chaînes absentes ; affiche aussi la mémoire utilisée par chaîne.
+ * @param taille le nombre de chaînes.
+ */
+void benchmark_ensemble_chaines(size_t taille);
+
+/**
+ * @brief Compare `Ensemble` et `EnsembleCompresse` sur des identifiants denses :
+ * A contient chaque entier de [0, 2 taille[ avec probabilité 1/2 (ajoutés dans
+ * le désordre) et B l'intervalle [taille, 2 taille[ (optimisé en plages) :
+ * construction de A, **taille** recherches, union et intersection de A et B,
+ * puis mémoire utilisée par élément.
+ * @param taille la taille de B.
+ */
+void benchmark_ensemble_compresse(size_t taille);
+
+/**
+ * @brief Compare le démarrage d'un programme qui reconstruit un ensemble de
+ * **taille** éléments (par `ajouter`) avec le chargement d'un instantané
+ * (`charger_ensemble_groupe`, avec et sans vérification de la somme de contrôle),
+ * puis chronomètre **taille** recherches dans l'instantané projeté.
+ * Le fichier est écrit dans le répertoire courant, puis supprimé.
+ * @param taille le nombre d'éléments.
+ */
+void benchmark_instantane(size_t taille);
+
+/**
+ * @brief Chronomètre le chargement de **taille** éléments avec `ajouter`, sans
+ * indication de taille (environ log2(taille) redimensionnements), avec
+ * `ensemble_avec_capacite`, puis avec un facteur de charge maximal de 1
+ * (deux fois moins d'alvéoles) ; compare les recherches qui suivent. \n
+ * Chronomètre ensuite un ensemble qu'on vide puis qu'on remplit à nouveau,
+ * sans puis avec `ensemble_reserver` (qui évite les réductions).
+ * @param taille le nombre d'éléments.
+ */
+void benchmark_capacite(size_t taille);
+
+/**
+ * @brief Mesure le coût des statistiques (`ensemble_activer_statistiques`) sur
+ * **taille** recherches fructueuses et infructueuses, puis affiche le diagnostic
+ * (`ensemble_diagnostic`) d'un ensemble de **taille** éléments, avec
+ * `hachage_fibonacci` puis avec un hachage naïf qui répartit mal les clés.
+ * @param taille le nombre d'éléments.
+ */
+void benchmark_statistiques(size_t taille);
+
+/**
+ * @brief Compare `EnsembleCoucou` et `Ensemble` sur **taille** éléments :
+ * construction, recherches fructueuses et infructueuses, facteur de charge
+ * atteint avant chaque agrandissement, mémoire par élément, puis centiles de
+ * la durée d'une recherche (chaque recherche est chronométrée seule, ce qui
+ * ajoute la durée de lecture de l'horloge).
+ * @param taille le nombre d'éléments.
+ */
+void benchmark_ensemble_coucou(size_t taille);
+
+/**
+ * @brief Chronomètre la construction d'un ensemble à partir d'une liste de
+ * **taille** éléments : avec `ajouter` (sans puis avec `ensemble_avec_capacite`),
+ * puis avec `liste_vers_ensemble_parallele` sur 1 puis **nb_threads** threads.
+ * @param taille le nombre d'éléments,
+ * @param nb_threads le nombre de threads de la dernière construction.
+ */
+void benchmark_construction_parallele(size_t taille, int nb_threads);
+
+/**
+ * @brief Compare `EnsembleDeroule` et `Ensemble` sur **taille** éléments :
+ * construction, recherches fructueuses et infructueuses, puis remplissage
+ * des blocs et mémoire par élément.
+ * @param taille le nombre d'éléments.
+ */
+void benchmark_ensemble_deroule(size_t taille);
+
+/**
+ * @brief Chronomètre un ensemble dont toutes les clés tombent dans la même
+ * alvéole (les entiers de 0 à **taille** - 1 avec un hachage naïf qui garde
+ * leurs bits de poids fort) : sa liste est arborisée (voir SEUIL_ARBORISATION). \n
+ * **taille** est ramenée à 32768 au plus.
+ * @param taille le nombre de clés.
+ */
+void benchmark_arborisation(size_t taille);
+
+/**
+ * @brief Compare `DictionnaireOrdonne` et `Dictionnaire` sur **taille** clés :
+ * construction, recherches, liste des clés, puis vérifie que l'ordre
+ * d'insertion est conservé et affiche la mémoire par clé.
+ * @param taille le nombre de clés.
+ */
+void benchmark_dictionnaire_ordonne(size_t taille);
+
+/**
+ * @brief Compare `grouper_compter` et `jointure_hachage` avec les mêmes
+ * opérations écrites avec un `Dictionnaire`, sur une colonne de **taille**
+ * rangées dont les clés viennent d'une colonne de **taille** / 16 clés
+ * distinctes (la jointure relie chaque rangée à sa clé).
+ * @param taille le nombre de rangées.
+ */
+void benchmark_operateurs(size_t taille);
+
+/**
+ * @brief Compare `HyperLogLog` et `CountMin` avec un `Ensemble` et un
+ * `Dictionnaire` exacts sur un flot de **taille** clés (biaisé vers certaines
+ * clés) : débit des mises à jour, puis précision selon la mémoire.
+ * @param taille le nombre de clés du flot.
+ */
+void benchmark_esquisses(size_t taille);
+
+/**
+ * @brief Compare les fonctions de hachage de `hachage.h` sur **taille** clés
+ * de 64 bits de la forme k << 32 (consécutives ou aléatoires), dont les 32 bits
+ * de poids faible sont nuls : construction suivie de recherches infructueuses,
+ * puis répartition dans les alvéoles (comme `benchmark_fonctions_hachage`). \n
+ * Ne fait rien sans `-DCLES_64_BITS`.
+ * @param taille le nombre de clés.
+ */
+void benchmark_cles_64_bits(size_t taille);
+
+/**
+ * @brief Compare `EnsembleStatique` et `Ensemble` sur **taille** éléments :
+ * construction depuis une liste, recherches (présents et absents), puis
+ * vérifie les réponses et affiche la mémoire par élément.
+ * @param taille le nombre d'éléments.
+ */
+void benchmark_ensemble_statique(size_t taille);
+
+/**
+ * @brief Compare les politiques de `Cache` (LRU, CLOCK, 2Q) sur des suites de
+ * **taille** requêtes tirées selon une loi de Zipf (avec ou sans parcours) :
+ * taux de succès selon la capacité, puis débit, comparé à un cache fait de
+ * deux `Dictionnaire` qui cherche la clé la plus ancienne parmi toutes.
+ * @param taille le nombre de requêtes (et de clés possibles).
+ */
+void benchmark_cache(size_t taille);
+
+#endif
@@ -0,0 +1,269 @@
+#include "cache_lru.h"
+#include "ensemble.h"
+#include "hachage.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+// The three sentinels are the first nodes; a node's file is the index of
+// the sentinel of its list
+#define FILE_PRINCIPALE 0
+#define FILE_ENTREE 1
+#define FILE_FANTOMES 2
+#define FILE_LIBRE 3
+#define NB_SENTINELLES 3
+
+// An empty case of the hash table, or the end of the free list
+#define AUCUN UINT32_MAX
+
+static void* allouer(size_t taille) {
+    void* p = malloc(taille);
+    if (p == NULL) {
+        fprintf(stderr, "Erreur: Échec de l'allocation de mémoire.\n");
+        exit(EXIT_FAILURE);
+    }
+    return p;
+}
+
+static inline size_t case_initiale(Cache c, type_base cle) {
+    return hachage_murmur3(objet_vers_nombre(cle), c->graine) & (c->nb_cases - 1);
+}
+
+// Case holding the node of cle, or the empty case where it would go
+static inline size_t chercher_case(Cache c, type_base cle) {
+    size_t masque = c->nb_cases - 1;
+    size_t i = case_initiale(c, cle);
+    while (c->cases[i] != AUCUN && c->noeuds[c->cases[i]].cle != cle) {
+        i = (i + 1) & masque;
+    }
+    return i;
+}
+
+// Empties case i, moving back the following cases of the cluster that
+// would no longer be reachable (backward shift deletion)
+static void effacer_case(Cache c, size_t i) {
+    size_t masque = c->nb_cases - 1;
+    size_t j = i;
+    while (true) {
+        j = (j + 1) & masque;
+        if (c->cases[j] == AUCUN) {
+            break;
+        }
+        // Le noeud de la case j peut remonter en i si sa case initiale n'est pas dans ]i, j]
+        size_t k = case_initiale(c, c->noeuds[c->cases[j]].cle);
+        if (((j - k) & masque) >= ((j - i) & masque)) {
+            c->cases[i] = c->cases[j];
+            i = j;
+        }
+    }
+    c->cases[i] = AUCUN;
+}
+
+static inline void retirer(Cache c, uint32_t i) {
+    struct NoeudCache* n = &(c->noeuds[i]);
+    c->noeuds[n->precedent].suivant = n->suivant;
+    c->noeuds[n->suivant].precedent = n->precedent;
+}
+
+static inline void mettre_en_tete(Cache c, uint32_t i, uint8_t file) {
+    struct NoeudCache* n = &(c->noeuds[i]);
+    struct NoeudCache* sentinelle = &(c->noeuds[file]);
+    n->precedent = file;
+    n->suivant = sentinelle->suivant;
+    c->noeuds[sentinelle->suivant].precedent = i;
+    sentinelle->suivant = i;
+    n->file = file;
+}
+
+static inline uint32_t queue(Cache c, uint8_t file) {
+    return c->noeuds[file].precedent;
+}
+
+// Removes node i from the hash table and from its list, and puts it back
+// in the free list (the counters are updated by the caller)
+static void liberer_noeud_cache(Cache c, uint32_t i) {
+    effacer_case(c, chercher_case(c, c->noeuds[i].cle));
+    retirer(c, i);
+    c->noeuds[i].file = FILE_LIBRE;
+    c->noeuds[i].suivant = c->libres;
+    c->libres = i;
+}
+
+// Evicts one key (the cache is full): afterwards, a node is free
+static void evincer(Cache c) {
+    uint32_t victime;
+    if (c->politique == POLITIQUE_CLOCK) {
+        // L'aiguille fait au plus deux tours : le premier remet les bits à 0
+        uint32_t fin = (uint32_t)(NB_SENTINELLES + c->capacite);
+        while (true) {
+            victime = c->aiguille;
+            c->aiguille = c->aiguille + 1 == fin ? NB_SENTINELLES : c->aiguille + 1;
+            if (c->noeuds[victime].file == FILE_LIBRE) {
+                continue;
+            }
+            if (c->noeuds[victime].reference == 0) {
+                break;
+            }
+            c->noeuds[victime].reference = 0;
+        }
+    } else if (c->politique == POLITIQUE_2Q && c->nb_entree > 0
+               && (c->nb_entree >= c->capacite_entree || c->noeuds[FILE_PRINCIPALE].suivant == FILE_PRINCIPALE)) {
+        // La plus ancienne clé de la file d'entrée devient un fantôme (elle garde sa case)
+        victime = queue(c, FILE_ENTREE);
+        retirer(c, victime);
+        c->nb_entree--;
+        c->taille--;
+        c->nb_evictions++;
+        if (c->capacite_fantomes == 0) {
+            mettre_en_tete(c, victime, FILE_FANTOMES);
+            liberer_noeud_cache(c, victime);
+            return;
+        }
+        if (c->nb_fantomes == c->capacite_fantomes) {
+            liberer_noeud_cache(c, queue(c, FILE_FANTOMES));
+            c->nb_fantomes--;
+        }
+        mettre_en_tete(c, victime, FILE_FANTOMES);
+        c->nb_fantomes++;
+        return;
+    } else {
+        victime = queue(c, FILE_PRINCIPALE);
+    }
+    liberer_noeud_cache(c, victime);
+    c->taille--;
+    c->nb_evictions++;
+}
+
+// Marks the key of node i as used
+static inline void utiliser(Cache c, uint32_t i) {
+    if (c->politique == POLITIQUE_CLOCK) {
+        c->noeuds[i].reference = 1;
+    } else if (c->noeuds[i].file == FILE_PRINCIPALE) {
+        retirer(c, i);
+        mettre_en_tete(c, i, FILE_PRINCIPALE);
+    }
+    // 2Q : un succès dans la file d'entrée ne change rien
+}
+
+Cache cache_vide(size_t capacite, enum PolitiqueCache politique) {
+    srand(time(NULL)); // Seed the random number generator
+
+    Cache c = allouer(sizeof(struct TableCache));
+    c->capacite = capacite < 1 ? 1 : capacite;
+    c->politique = politique;
+    c->capacite_entree = c->capacite * POURCENTAGE_ENTREE_2Q / 100;
+    c->capacite_entree = c->capacite_entree < 1 ? 1 : c->capacite_entree;
+    c->capacite_fantomes = politique == POLITIQUE_2Q ? c->capacite * POURCENTAGE_FANTOMES_2Q / 100 : 0;
+    size_t nb_noeuds = NB_SENTINELLES + c->capacite + c->capacite_fantomes;
+    if (nb_noeuds >= AUCUN / 2) {
+        fprintf(stderr, "Erreur: Capacité du cache trop grande.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // Au moins deux cases par noeud : le sondage reste court
+    c->nb_cases = 8;
+    while (c->nb_cases < 2 * nb_noeuds) {
+        c->nb_cases *= 2;
+    }
+    c->cases = allouer(c->nb_cases * sizeof(uint32_t));
+    memset(c->cases, 0xFF, c->nb_cases * sizeof(uint32_t));
+
+    // Les sentinelles forment des listes vides ; tous les autres noeuds sont libres
+    c->noeuds = allouer(nb_noeuds * sizeof(struct NoeudCache));
+    for (uint32_t s = 0; s < NB_SENTINELLES; s++) {
+        c->noeuds[s].precedent = s;
+        c->noeuds[s].suivant = s;
+        c->noeuds[s].file = (uint8_t)s;
+    }
+    c->libres = AUCUN;
+    for (size_t i = nb_noeuds; i > NB_SENTINELLES; i--) {
+        c->noeuds[i - 1].file = FILE_LIBRE;
+        c->noeuds[i - 1].suivant = c->libres;
+        c->libres = (uint32_t)(i - 1);
+    }
+
+    c->taille = 0;
+    c->nb_entree = 0;
+    c->nb_fantomes = 0;
+    c->aiguille = NB_SENTINELLES;
+    c->nb_succes = 0;
+    c->nb_echecs = 0;
+    c->nb_evictions = 0;
+    c->graine = ((uint64_t)rand() << 32) ^ (uint64_t)rand();
+    return c;
+}
+
+type_valeur* obtenir_cache(Cache c, type_base cle) {
+    uint32_t i = c->cases[chercher_case(c, cle)];
+    if (i == AUCUN || c->noeuds[i].file == FILE_FANTOMES) {
+        c->nb_echecs++;
+        return NULL;
+    }
+    c->nb_succes++;
+    utiliser(c, i);
+    return &(c->noeuds[i].valeur);
+}
+
+void inserer_ou_maj_cache(Cache c, type_base cle, type_valeur v) {
+    uint32_t i = c->cases[chercher_case(c, cle)];
+    if (i != AUCUN && c->noeuds[i].file != FILE_FANTOMES) {
+        c->noeuds[i].valeur = v;
+        utiliser(c, i);
+        return;
+    }
+
+    if (i != AUCUN) {
+        // Un fantôme redemandé passe dans la liste principale ; on le retire des
+        // fantômes avant d'évincer, pour qu'il ne soit pas libéré entre-temps
+        retirer(c, i);
+        c->nb_fantomes--;
+        c->noeuds[i].file = FILE_PRINCIPALE;
+        if (c->taille == c->capacite) {
+            evincer(c);
+        }
+        mettre_en_tete(c, i, FILE_PRINCIPALE);
+    } else {
+        if (c->taille == c->capacite) {
+            evincer(c);
+        }
+        // L'éviction a pu décaler des cases : on cherche à nouveau
+        i = c->libres;
+        c->libres = c->noeuds[i].suivant;
+        c->cases[chercher_case(c, cle)] = i;
+        c->noeuds[i].cle = cle;
+        c->noeuds[i].reference = 0;
+        if (c->politique == POLITIQUE_2Q) {
+            mettre_en_tete(c, i, FILE_ENTREE);
+            c->nb_entree++;
+        } else {
+            mettre_en_tete(c, i, FILE_PRINCIPALE);
+        }
+    }
+    c->noeuds[i].valeur = v;
+    c->taille++;
+}
+
+bool supprimer_cle_cache(Cache c, type_base cle) {
+    uint32_t i = c->cases[chercher_case(c, cle)];
+    if (i == AUCUN) {
+        return false;
+    }
+    uint8_t file = c->noeuds[i].file;
+    liberer_noeud_cache(c, i);
+    if (file == FILE_FANTOMES) {
+        c->nb_fantomes--;
+        return false;
+    }
+    if (file == FILE_ENTREE) {
+        c->nb_entree--;
+    }
+    c->taille--;
+    return true;
+}
+
+void liberer_cache(Cache c) {
+    free(c->noeuds);
+    free(c->cases);
+    free(c);
+}
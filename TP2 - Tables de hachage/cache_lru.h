@@ -0,0 +1,170 @@
+/**
+ * @file cache_lru.h
+ * @author
+ * */
+
+#ifndef __CACHE__LRU__H__
+#define __CACHE__LRU__H__
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "liste_chainee.h"
+
+
+/* Description des structures */
+
+/**
+ * @brief Les politiques d'éviction possibles d'un cache.
+ */
+enum PolitiqueCache{
+	POLITIQUE_LRU, /**< On évince la clé utilisée le moins récemment. */
+	POLITIQUE_CLOCK, /**< Approximation de LRU (algorithme de l'horloge) : un succès
+	* ne déplace rien, il met seulement un bit de référence à 1. */
+	POLITIQUE_2Q /**< Une file d'entrée et une file LRU (Johnson et Shasha 1994) :
+	* une clé vue une seule fois, par exemple lors d'un parcours, ne chasse pas les
+	* clés souvent utilisées. */
+};
+
+/**
+ * @brief La part de la capacité réservée à la file d'entrée (2Q), en pourcentage.
+ */
+#define POURCENTAGE_ENTREE_2Q 25
+
+/**
+ * @brief Le nombre de clés "fantômes" que retient 2Q (clés évincées de la file
+ * d'entrée, sans leur valeur), en pourcentage de la capacité.
+ */
+#define POURCENTAGE_FANTOMES_2Q 50
+
+/**
+ * @brief Un noeud du cache. Les noeuds sont tous alloués à la création du
+ * cache, dans un seul tableau ; les listes sont chaînées par indices dans
+ * ce tableau (32 bits au lieu d'un pointeur de 64 bits).
+ */
+struct NoeudCache{
+	type_base cle; /**< La clé. */
+	type_valeur valeur; /**< La valeur associée à la clé (inutilisée pour un fantôme). */
+	uint32_t precedent; /**< Le noeud précédent dans sa liste. */
+	uint32_t suivant; /**< Le noeud suivant dans sa liste (ou dans la liste des noeuds libres). */
+	uint8_t file; /**< La liste qui contient le noeud (libre, principale, entrée ou fantômes). */
+	uint8_t reference; /**< Le bit de référence (CLOCK). */
+};
+
+/**
+ * @brief Structure codant un cache de taille fixe qui associe des valeurs
+ * à des clés. \n
+ * Une table de hachage (sondage linéaire, `hachage_murmur3`) donne, pour
+ * chaque clé, l'indice de son noeud dans **noeuds** : une seule recherche
+ * suffit pour trouver la valeur et la place de la clé dans l'ordre d'éviction.
+ * Les suppressions décalent les cases suivantes vers l'arrière (pas de
+ * marqueur de case supprimée), pour que la table ne se remplisse pas de
+ * marqueurs quand le cache tourne. \n
+ * Les trois premiers noeuds sont les sentinelles de listes circulaires
+ * doublement chaînées (principale, entrée et fantômes) : on retire un noeud
+ * ou on le remet en tête sans aucun test. Selon **politique** :
+ * @li LRU : la liste principale va de la clé la plus récente à la plus
+ * ancienne, qui est évincée ;
+ * @li CLOCK : les noeuds ne sont jamais déplacés ; une aiguille parcourt le
+ * tableau des noeuds et évince le premier dont le bit de référence est à 0,
+ * en remettant à 0 ceux qu'elle dépasse ;
+ * @li 2Q : une nouvelle clé entre dans la file d'entrée (premier entré,
+ * premier sorti) ; en en sortant, elle devient un fantôme. Une clé
+ * redemandée pendant qu'elle est fantôme passe dans la liste principale (LRU). \n
+ * Toutes les opérations sont en O(1) (en moyenne, et au pire O(capacité) pour
+ * un tour d'aiguille de CLOCK), sans aucune allocation après la création.
+ */
+struct TableCache{
+
+	struct NoeudCache* noeuds; /**< Les noeuds (sentinelles comprises). */
+
+	uint32_t* cases; /**< La table de hachage : l'indice d'un noeud, ou UINT32_MAX pour une case vide. */
+
+	size_t nb_cases; /**< Le nombre de cases (une puissance de deux, au moins deux fois le nombre de noeuds). */
+
+	size_t capacite; /**< Le nombre maximal de clés (sans compter les fantômes). */
+
+	size_t taille; /**< Le nombre de clés. */
+
+	size_t capacite_entree; /**< La taille maximale de la file d'entrée (2Q). */
+
+	size_t nb_entree; /**< Le nombre de clés dans la file d'entrée (2Q). */
+
+	size_t capacite_fantomes; /**< Le nombre maximal de fantômes (2Q). */
+
+	size_t nb_fantomes; /**< Le nombre de fantômes (2Q). */
+
+	uint32_t libres; /**< Le premier noeud libre (chaînés par **suivant**), ou UINT32_MAX. */
+
+	uint32_t aiguille; /**< Le prochain noeud examiné par l'aiguille (CLOCK). */
+
+	enum PolitiqueCache politique; /**< La politique d'éviction. */
+
+	size_t nb_succes; /**< Le nombre d'appels à `obtenir_cache` qui ont trouvé la clé. */
+
+	size_t nb_echecs; /**< Le nombre d'appels à `obtenir_cache` qui ne l'ont pas trouvée. */
+
+	size_t nb_evictions; /**< Le nombre de clés évincées pour faire de la place. */
+
+	uint64_t graine; /**< La graine aléatoire passée à `hachage_murmur3`. */
+};
+
+/**
+ * @brief Le type "Cache" associe des valeurs à au plus **capacite** clés ;
+ * au-delà, ajouter une clé en évince une autre.
+ */
+typedef struct TableCache* Cache;
+
+
+/* Prototype des fonctions */
+
+/**
+ * @brief Renvoie un cache vide, avec tous ses noeuds déjà alloués. \n
+ * **Complexité :** O(capacite)
+ * @param capacite le nombre maximal de clés (au moins 1),
+ * @param politique la politique d'éviction.
+ * @returns un cache vide.
+ */
+Cache cache_vide(size_t capacite, enum PolitiqueCache politique);
+
+/**
+ * @brief Renvoie l'adresse de la valeur associée à une clé, et la marque comme
+ * utilisée (elle remonte en tête pour LRU, son bit de référence passe à 1 pour
+ * CLOCK). Compte un succès ou un échec. \n
+ * Le pointeur reste valide jusqu'au prochain ajout ou à la prochaine suppression. \n
+ * **Complexité :** O(1) (en moyenne)
+ * @param c un cache,
+ * @param cle une clé.
+ * @returns l'adresse de la valeur associée à **cle** si la clé est dans **c**,
+ * NULL sinon (un fantôme de 2Q n'est pas dans le cache).
+ */
+type_valeur* obtenir_cache(Cache c, type_base cle);
+
+/**
+ * @brief Associe une valeur à une clé : la valeur est remplacée si la clé est
+ * dans le cache ; sinon la clé est ajoutée, en évinçant une autre clé si le
+ * cache est plein. \n
+ * **Complexité :** O(1) (en moyenne)
+ * @param c un cache,
+ * @param cle une clé,
+ * @param v la valeur à associer à **cle**.
+ */
+void inserer_ou_maj_cache(Cache c, type_base cle, type_valeur v);
+
+/**
+ * @brief Retire une clé (et sa valeur) du cache. \n
+ * **Complexité :** O(1) (en moyenne)
+ * @param c un cache,
+ * @param cle la clé à retirer.
+ * @returns **true** si la clé était dans le cache, **false** sinon.
+ */
+bool supprimer_cle_cache(Cache c, type_base cle);
+
+/**
+ * @brief Libère la mémoire associée à un cache. \n
+ * **Complexité :** O(1)
+ * @param c un cache.
+ */
+void liberer_cache(Cache c);
+
+#endif
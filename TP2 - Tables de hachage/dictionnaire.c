@@ -0,0 +1,39 @@
+#include "dictionnaire.h"
+#include "ensemble.h"
+#include <stdlib.h>
+
+Dictionnaire dictionnaire_vide() {
+    return ensemble_vide();
+}
+
+void inserer_ou_maj(Dictionnaire d, type_base cle, type_valeur v) {
+    bool existait;
+    trouver_ou_ajouter_noeud(d, cle, &existait)->valeur_associee = v;
+}
+
+type_valeur* obtenir(Dictionnaire d, type_base cle) {
+    ListeChainee n = rechercher_noeud(d, cle);
+    if (n == NULL) {
+        return NULL;
+    }
+    return &(n->valeur_associee);
+}
+
+bool supprimer_cle(Dictionnaire d, type_base cle) {
+    return supprimer_si_present(d, cle);
+}
+
+type_valeur* inserer_ou_maj_avec(Dictionnaire d, type_base cle, fonction_maj maj, void* contexte) {
+    bool existait;
+    ListeChainee n = trouver_ou_ajouter_noeud(d, cle, &existait);
+    maj(&(n->valeur_associee), existait, contexte);
+    return &(n->valeur_associee);
+}
+
+Liste cles_dictionnaire(Dictionnaire d) {
+    return ensemble_vers_liste(d);
+}
+
+void liberer_dictionnaire(Dictionnaire d) {
+    liberer_ensemble(d);
+}
@@ -0,0 +1,111 @@
+/**
+ * @file dictionnaire.h
+ * @author
+ * */
+
+#ifndef __DICTIONNAIRE__H__
+#define __DICTIONNAIRE__H__
+
+#include <stdbool.h>
+#include "ensemble.h"
+#include "liste.h"
+
+
+/**
+ * @brief Un dictionnaire associe une valeur (de type `type_valeur`) à
+ * des clés (de type `type_base`). \n
+ * On le code directement avec la table de hachage des ensembles :
+ * la clé est le champ `valeur` du noeud et la valeur associée est son champ
+ * `valeur_associee`. On profite ainsi de la fonction de hachage, des
+ * redimensionnements et de la réserve de noeuds de `Ensemble`. \n
+ * Contrairement à un ensemble, un dictionnaire n'a pas de doublon : il ne faut
+ * donc pas utiliser `ajouter` sur un dictionnaire.
+ */
+typedef struct TableHachage* Dictionnaire;
+
+
+/* Prototype des fonctions */
+
+/**
+ * @brief Renvoie un dictionnaire sans clé. \n
+ * **Complexité :** O(1)
+ * @returns un dictionnaire vide.
+ */
+Dictionnaire dictionnaire_vide();
+
+/**
+ * @brief Associe une valeur à une clé : la clé est ajoutée si elle
+ * n'était pas dans le dictionnaire, sa valeur est remplacée sinon. \n
+ * **Complexité :** O(1) (en moyenne et en amorti)
+ * @param d un dictionnaire,
+ * @param cle une clé,
+ * @param v la valeur à associer à **cle**.
+ */
+void inserer_ou_maj(Dictionnaire d, type_base cle, type_valeur v);
+
+/**
+ * @brief Renvoie l'adresse de la valeur associée à une clé. \n
+ * On peut modifier la valeur à travers ce pointeur : 
+ * `(*obtenir(d, cle))++;`. Le pointeur reste valide tant que la clé
+ * n'est pas supprimée. \n
+ * **Complexité :** O(1) (en moyenne)
+ * @param d un dictionnaire,
+ * @param cle une clé.
+ * @returns l'adresse de la valeur associée à **cle** si la clé est dans **d**,
+ * NULL sinon.
+ */
+type_valeur* obtenir(Dictionnaire d, type_base cle);
+
+/**
+ * @brief Supprime une clé (et sa valeur) du dictionnaire. \n
+ * **Complexité :** O(1) (en moyenne et en amorti)
+ * @param d un dictionnaire,
+ * @param cle la clé à supprimer.
+ * @returns **true** si la clé était dans le dictionnaire, **false** sinon.
+ */
+bool supprimer_cle(Dictionnaire d, type_base cle);
+
+/**
+ * @brief Alias pour une fonction qui met à jour la valeur associée à une clé. \n
+ * Elle reçoit l'adresse de la valeur, un booléen qui indique si la clé
+ * existait (sinon la valeur n'est pas initialisée) et un contexte libre.
+ */
+typedef void (*fonction_maj)(type_valeur*, bool, void*);
+
+/**
+ * @brief Met à jour la valeur associée à une clé en une seule recherche
+ * (lecture, modification et écriture). \n
+ * Si la clé n'est pas dans le dictionnaire, elle est ajoutée et **maj**
+ * est appelée avec `false` : c'est à elle d'initialiser la valeur. \n
+ * Exemple pour compter des occurrences :
+ * @code void incrementer(type_valeur* v, bool existait, void* contexte){
+ * 	*v = existait ? *v + 1 : 1;
+ * }
+ * ...
+ * inserer_ou_maj_avec(d, x, incrementer, NULL);
+ * @endcode
+ * **Complexité :** O(1) (en moyenne et en amorti) + le coût de **maj**
+ * @param d un dictionnaire,
+ * @param cle une clé,
+ * @param maj la fonction de mise à jour,
+ * @param contexte un pointeur passé tel quel à **maj**.
+ * @returns l'adresse de la valeur associée à **cle**.
+ */
+type_valeur* inserer_ou_maj_avec(Dictionnaire d, type_base cle, fonction_maj maj, void* contexte);
+
+/**
+ * @brief Renvoie la liste des clés du dictionnaire (l'ordre n'a pas d'importance). \n
+ * **Complexité :** O(nombre de clés)
+ * @param d un dictionnaire.
+ * @returns une liste contenant les clés de **d**.
+ */
+Liste cles_dictionnaire(Dictionnaire d);
+
+/**
+ * @brief Libère la mémoire associée à un dictionnaire. \n
+ * **Complexité :** O(nombre de blocs de la réserve)
+ * @param d un dictionnaire.
+ */
+void liberer_dictionnaire(Dictionnaire d);
+
+#endif
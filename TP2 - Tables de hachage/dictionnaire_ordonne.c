@@ -0,0 +1,234 @@
+#include "dictionnaire_ordonne.h"
+#include "ensemble.h"
+#include "hachage.h"
+#include "liste.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+// Reads case i of the index array
+static inline int64_t lire_indice(DictionnaireOrdonne d, size_t i) {
+    switch (d->largeur_indice) {
+        case 1: return ((int8_t*)d->indices)[i];
+        case 2: return ((int16_t*)d->indices)[i];
+        case 4: return ((int32_t*)d->indices)[i];
+        default: return ((int64_t*)d->indices)[i];
+    }
+}
+
+// Writes case i of the index array
+static inline void ecrire_indice(DictionnaireOrdonne d, size_t i, int64_t v) {
+    switch (d->largeur_indice) {
+        case 1: ((int8_t*)d->indices)[i] = (int8_t)v; break;
+        case 2: ((int16_t*)d->indices)[i] = (int16_t)v; break;
+        case 4: ((int32_t*)d->indices)[i] = (int32_t)v; break;
+        default: ((int64_t*)d->indices)[i] = v; break;
+    }
+}
+
+static inline bool est_supprimee(DictionnaireOrdonne d, size_t position) {
+    return (d->supprimees[position / 64] >> (position % 64)) & 1;
+}
+
+// First case of the probe sequence of a key
+static inline size_t premiere_case(DictionnaireOrdonne d, type_base cle) {
+    uint64_t h = hachage_murmur3(objet_vers_nombre(cle), d->graine);
+    return (size_t)(h >> (64 - __builtin_ctzll(d->nb_indices)));
+}
+
+// Returns the case of the index array that holds the entry of cle, or -1 if
+// cle is absent (then *libre is the first case where it can be inserted)
+static int64_t chercher_case(DictionnaireOrdonne d, type_base cle, size_t* libre) {
+    size_t masque = d->nb_indices - 1;
+    size_t premiere_libre = SIZE_MAX;
+
+    // Il reste toujours une case vide : le sondage s'arrête
+    for (size_t i = premiere_case(d, cle);; i = (i + 1) & masque) {
+        int64_t ix = lire_indice(d, i);
+        if (ix == INDICE_VIDE) {
+            if (libre != NULL) {
+                *libre = premiere_libre != SIZE_MAX ? premiere_libre : i;
+            }
+            return -1;
+        }
+        if (ix == INDICE_SUPPRIME) {
+            if (premiere_libre == SIZE_MAX) {
+                premiere_libre = i;
+            }
+        } else if (d->entrees[ix].cle == cle) {
+            return (int64_t)i;
+        }
+    }
+}
+
+// Allocates the arrays for a given number of index cases (a power of two,
+// at least 8), then moves the remaining entries there in the same order
+static void redimensionner_ordonne(DictionnaireOrdonne d, size_t nb_indices) {
+    struct EntreeOrdonnee* anciennes = d->entrees;
+    uint64_t* anciennes_supprimees = d->supprimees;
+    size_t ancien_nb_entrees = d->nb_entrees;
+
+    d->nb_indices = nb_indices;
+    d->largeur_indice = nb_indices <= 128 ? 1 : nb_indices <= 32768 ? 2 : nb_indices <= 2147483648u ? 4 : 8;
+    d->capacite_entrees = nb_indices * 2 / 3;
+
+    free(d->indices);
+    d->indices = malloc(nb_indices * d->largeur_indice);
+    d->entrees = malloc(d->capacite_entrees * sizeof(struct EntreeOrdonnee));
+    d->supprimees = calloc((d->capacite_entrees + 63) / 64, sizeof(uint64_t));
+    if (d->indices == NULL || d->entrees == NULL || d->supprimees == NULL) {
+        fprintf(stderr, "Erreur: Échec de l'allocation de mémoire.\n");
+        exit(EXIT_FAILURE);
+    }
+    memset(d->indices, 0xFF, nb_indices * d->largeur_indice); // INDICE_VIDE partout
+
+    // Les entrées restantes sont recopiées dans l'ordre : aucune case supprimée
+    d->nb_entrees = 0;
+    size_t masque = nb_indices - 1;
+    for (size_t j = 0; j < ancien_nb_entrees; j++) {
+        if ((anciennes_supprimees[j / 64] >> (j % 64)) & 1) {
+            continue;
+        }
+        size_t i = premiere_case(d, anciennes[j].cle);
+        while (lire_indice(d, i) != INDICE_VIDE) {
+            i = (i + 1) & masque;
+        }
+        ecrire_indice(d, i, (int64_t)d->nb_entrees);
+        d->entrees[d->nb_entrees] = anciennes[j];
+        d->nb_entrees++;
+    }
+
+    free(anciennes);
+    free(anciennes_supprimees);
+}
+
+// Number of index cases after a resize with n keys: the smallest power of
+// two (at least 8) above 3n, as in CPython, so the entries array is at most
+// half full afterwards
+static size_t nb_indices_pour(size_t n) {
+    size_t nb = 8;
+    while (nb < 3 * n) {
+        nb *= 2;
+    }
+    return nb;
+}
+
+DictionnaireOrdonne dictionnaire_ordonne_vide() {
+    srand(time(NULL)); // Seed the random number generator
+
+    DictionnaireOrdonne d = malloc(sizeof(struct TableOrdonnee));
+    if (d == NULL) {
+        fprintf(stderr, "Erreur: Échec de l'allocation de mémoire.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    d->indices = NULL;
+    d->entrees = NULL;
+    d->supprimees = NULL;
+    d->nb_entrees = 0;
+    d->taille = 0;
+    d->graine = ((uint64_t)rand() << 32) ^ (uint64_t)rand();
+    redimensionner_ordonne(d, 8);
+
+    return d;
+}
+
+// Returns the value of cle, appending a new entry (whose value is v) if it is absent
+static type_valeur* trouver_ou_inserer(DictionnaireOrdonne d, type_base cle, type_valeur v, bool* existait) {
+    size_t libre;
+    int64_t i = chercher_case(d, cle, &libre);
+    *existait = (i != -1);
+    if (i != -1) {
+        return &(d->entrees[lire_indice(d, (size_t)i)].valeur);
+    }
+
+    // Entrées pleines : on compacte (et on agrandit s'il y a peu de suppressions)
+    if (d->nb_entrees == d->capacite_entrees) {
+        redimensionner_ordonne(d, nb_indices_pour(d->taille));
+        chercher_case(d, cle, &libre);
+    }
+
+    ecrire_indice(d, libre, (int64_t)d->nb_entrees);
+    struct EntreeOrdonnee* entree = &(d->entrees[d->nb_entrees]);
+    entree->cle = cle;
+    entree->valeur = v;
+    d->nb_entrees++;
+    d->taille++;
+    return &(entree->valeur);
+}
+
+void inserer_ou_maj_ordonne(DictionnaireOrdonne d, type_base cle, type_valeur v) {
+    bool existait;
+    *trouver_ou_inserer(d, cle, v, &existait) = v;
+}
+
+type_valeur* obtenir_ordonne(DictionnaireOrdonne d, type_base cle) {
+    int64_t i = chercher_case(d, cle, NULL);
+    return i == -1 ? NULL : &(d->entrees[lire_indice(d, (size_t)i)].valeur);
+}
+
+bool supprimer_cle_ordonne(DictionnaireOrdonne d, type_base cle) {
+    int64_t i = chercher_case(d, cle, NULL);
+    if (i == -1) {
+        return false;
+    }
+
+    size_t position = (size_t)lire_indice(d, (size_t)i);
+    ecrire_indice(d, (size_t)i, INDICE_SUPPRIME);
+    d->supprimees[position / 64] |= (uint64_t)1 << (position % 64);
+    d->taille--;
+
+    // Réduire de moitié (en compactant) si les clés occupent moins du huitième des entrées
+    if (d->nb_indices > 8 && d->taille < d->capacite_entrees / 8) {
+        redimensionner_ordonne(d, d->nb_indices / 2);
+    }
+    return true;
+}
+
+void ajouter_ordonne(DictionnaireOrdonne d, type_base x) {
+    bool existait;
+    trouver_ou_inserer(d, x, 0, &existait);
+}
+
+bool appartient_ordonne(DictionnaireOrdonne d, type_base x) {
+    return chercher_case(d, x, NULL) != -1;
+}
+
+void parcourir_ordonne(DictionnaireOrdonne d, fonction_parcours f, void* contexte) {
+    for (size_t j = 0; j < d->nb_entrees; j++) {
+        if (!est_supprimee(d, j)) {
+            f(d->entrees[j].cle, &(d->entrees[j].valeur), contexte);
+        }
+    }
+}
+
+Liste cles_ordonnees(DictionnaireOrdonne d) {
+    Liste l = liste_vide();
+    for (size_t j = 0; j < d->nb_entrees; j++) {
+        if (!est_supprimee(d, j)) {
+            ajouter_en_fin(l, d->entrees[j].cle);
+        }
+    }
+    return l;
+}
+
+DictionnaireOrdonne liste_vers_ensemble_ordonne(Liste l) {
+    DictionnaireOrdonne d = dictionnaire_ordonne_vide();
+    for (size_t i = 0; i < longueur(l); i++) {
+        ajouter_ordonne(d, element(l, i));
+    }
+    return d;
+}
+
+size_t memoire_ordonne(DictionnaireOrdonne d) {
+    return d->nb_indices * d->largeur_indice + d->capacite_entrees * sizeof(struct EntreeOrdonnee)
+           + (d->capacite_entrees + 63) / 64 * sizeof(uint64_t);
+}
+
+void liberer_dictionnaire_ordonne(DictionnaireOrdonne d) {
+    free(d->indices);
+    free(d->entrees);
+    free(d->supprimees);
+    free(d);
+}
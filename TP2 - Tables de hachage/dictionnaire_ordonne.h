@@ -0,0 +1,194 @@
+/**
+ * @file dictionnaire_ordonne.h
+ * @author
+ * */
+
+#ifndef __DICTIONNAIRE__ORDONNE__H__
+#define __DICTIONNAIRE__ORDONNE__H__
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "liste_chainee.h"
+#include "liste.h"
+
+
+/* Description de la structure */
+
+/**
+ * @brief Une entrée du dictionnaire : une clé et sa valeur.
+ */
+struct EntreeOrdonnee{
+	type_base cle; /**< La clé. */
+	type_valeur valeur; /**< La valeur associée à la clé. */
+};
+
+/**
+ * @brief Structure codant un dictionnaire compact qui garde l'ordre d'insertion
+ * (comme les dictionnaires de CPython). \n
+ * Il y a deux tableaux :
+ * @li **entrees**, dense, contient les entrées dans l'ordre où les clés ont
+ * été ajoutées : un parcours le lit simplement de gauche à droite ;
+ * @li **indices**, la table de hachage proprement dite (sondage linéaire),
+ * ne contient que des petits entiers : la position de l'entrée dans **entrees**,
+ * INDICE_VIDE ou INDICE_SUPPRIME. Ces entiers font 1, 2, 4 ou 8 octets selon
+ * le nombre de cases, ce qui rend les cases vides (au moins un tiers) presque
+ * gratuites. \n
+ * Une suppression marque l'entrée comme supprimée (dans **supprimees**) sans
+ * décaler les suivantes ; les entrées supprimées disparaissent au prochain
+ * redimensionnement, qui recopie les entrées restantes dans le même ordre.
+ * L'ordre d'un parcours ne dépend donc jamais du hachage ni des
+ * redimensionnements. \n
+ * Le nombre de cases de **indices** est une puissance de deux (au moins 8) ;
+ * **entrees** a une capacité des deux tiers de ce nombre.
+ */
+struct TableOrdonnee{
+
+	void* indices; /**< Le tableau des indices (des entiers de **largeur_indice** octets). */
+
+	size_t nb_indices; /**< Le nombre de cases de **indices** (une puissance de deux). */
+
+	int largeur_indice; /**< La taille d'une case de **indices** : 1, 2, 4 ou 8 octets. */
+
+	struct EntreeOrdonnee* entrees; /**< Les entrées, dans l'ordre d'insertion. */
+
+	uint64_t* supprimees; /**< Le bit i est à 1 si l'entrée i a été supprimée. */
+
+	size_t nb_entrees; /**< Le nombre d'entrées utilisées (supprimées comprises). */
+
+	size_t capacite_entrees; /**< La taille du tableau **entrees** (les deux tiers de **nb_indices**). */
+
+	size_t taille; /**< Le nombre de clés. */
+
+	uint64_t graine; /**< La graine aléatoire passée à `hachage_murmur3`. */
+};
+
+/**
+ * @brief Une case de **indices** qui n'a jamais été utilisée.
+ */
+#define INDICE_VIDE (-1)
+
+/**
+ * @brief Une case de **indices** dont l'entrée a été supprimée (le sondage
+ * continue au-delà ; un ajout peut la réutiliser).
+ */
+#define INDICE_SUPPRIME (-2)
+
+/**
+ * @brief Le type "DictionnaireOrdonne" associe des valeurs à des clés sans
+ * doublon, et se parcourt dans l'ordre d'insertion. Avec `ajouter_ordonne` et
+ * `appartient_ordonne`, c'est aussi un ensemble ordonné (les valeurs sont ignorées).
+ */
+typedef struct TableOrdonnee* DictionnaireOrdonne;
+
+/**
+ * @brief Alias pour une fonction appelée sur chaque entrée d'un parcours :
+ * elle reçoit la clé, l'adresse de sa valeur (modifiable) et un contexte libre.
+ */
+typedef void (*fonction_parcours)(type_base, type_valeur*, void*);
+
+
+/* Prototype des fonctions */
+
+/**
+ * @brief Renvoie un dictionnaire ordonné vide (8 indices). \n
+ * **Complexité :** O(1)
+ * @returns un dictionnaire vide.
+ */
+DictionnaireOrdonne dictionnaire_ordonne_vide();
+
+/**
+ * @brief Associe une valeur à une clé : une nouvelle clé est placée après
+ * toutes les autres ; une clé déjà présente garde sa place et sa valeur est
+ * remplacée. \n
+ * **Complexité :** O(1) (en moyenne et en amorti)
+ * @param d un dictionnaire ordonné,
+ * @param cle une clé,
+ * @param v la valeur à associer à **cle**.
+ */
+void inserer_ou_maj_ordonne(DictionnaireOrdonne d, type_base cle, type_valeur v);
+
+/**
+ * @brief Renvoie l'adresse de la valeur associée à une clé. \n
+ * Le pointeur reste valide jusqu'au prochain ajout d'une clé (qui peut
+ * déplacer les entrées). \n
+ * **Complexité :** O(1) (en moyenne)
+ * @param d un dictionnaire ordonné,
+ * @param cle une clé.
+ * @returns l'adresse de la valeur associée à **cle** si la clé est dans **d**,
+ * NULL sinon.
+ */
+type_valeur* obtenir_ordonne(DictionnaireOrdonne d, type_base cle);
+
+/**
+ * @brief Supprime une clé (et sa valeur). Les autres clés gardent leur ordre. \n
+ * Si jamais il reste moins d'un huitième de la capacité, les entrées sont
+ * compactées dans des tableaux deux fois plus petits. \n
+ * **Complexité :** O(1) (en moyenne et en amorti)
+ * @param d un dictionnaire ordonné,
+ * @param cle la clé à supprimer.
+ * @returns **true** si la clé était dans le dictionnaire, **false** sinon.
+ */
+bool supprimer_cle_ordonne(DictionnaireOrdonne d, type_base cle);
+
+/**
+ * @brief Ajoute un élément à la fin s'il n'est pas déjà présent (sa valeur
+ * associée vaut alors 0). \n
+ * **Complexité :** O(1) (en moyenne et en amorti)
+ * @param d un dictionnaire ordonné utilisé comme un ensemble,
+ * @param x une valeur qu'on veut ajouter dans d.
+ */
+void ajouter_ordonne(DictionnaireOrdonne d, type_base x);
+
+/**
+ * @brief Détermine si une clé appartient à un dictionnaire ordonné. \n
+ * **Complexité :** O(1) (en moyenne)
+ * @param d un dictionnaire ordonné,
+ * @param x une clé qu'on recherche dans d.
+ * @returns **true** si x appartient à d, **false** sinon.
+ */
+bool appartient_ordonne(DictionnaireOrdonne d, type_base x);
+
+/**
+ * @brief Appelle une fonction sur chaque entrée, dans l'ordre d'insertion. \n
+ * La fonction ne doit ni ajouter ni supprimer de clé. \n
+ * **Complexité :** O(nombre d'entrées) + le coût des appels
+ * @param d un dictionnaire ordonné,
+ * @param f la fonction à appeler,
+ * @param contexte un pointeur passé tel quel à **f**.
+ */
+void parcourir_ordonne(DictionnaireOrdonne d, fonction_parcours f, void* contexte);
+
+/**
+ * @brief Renvoie la liste des clés dans l'ordre d'insertion. \n
+ * **Complexité :** O(nombre d'entrées)
+ * @param d un dictionnaire ordonné.
+ * @returns une liste contenant les clés de **d**.
+ */
+Liste cles_ordonnees(DictionnaireOrdonne d);
+
+/**
+ * @brief Convertit une liste en un ensemble ordonné : chaque élément apparaît
+ * une fois, à la place de sa première occurrence. \n
+ * **Complexité :** O(taille de la liste) (en moyenne)
+ * @param l une liste.
+ * @returns un dictionnaire ordonné contenant les éléments de l.
+ */
+DictionnaireOrdonne liste_vers_ensemble_ordonne(Liste l);
+
+/**
+ * @brief Renvoie la mémoire utilisée par les tableaux d'un dictionnaire ordonné. \n
+ * **Complexité :** O(1)
+ * @param d un dictionnaire ordonné.
+ * @returns un nombre d'octets.
+ */
+size_t memoire_ordonne(DictionnaireOrdonne d);
+
+/**
+ * @brief Libère la mémoire associée à un dictionnaire ordonné. \n
+ * **Complexité :** O(1)
+ * @param d un dictionnaire ordonné.
+ */
+void liberer_dictionnaire_ordonne(DictionnaireOrdonne d);
+
+#endif
@@ -3,171 +3,1312 @@
 #include "liste.h" 
 #include <stdlib.h>
 #include <stdio.h>
+#include <stdint.h>
+#include <math.h>
+#include <stdatomic.h>
+#include <pthread.h>
 #include <time.h>
 
 // Function to calculate the hash value (alveole)
 size_t alveole(Ensemble e, type_base x) {
-    // Calculate the hash value using a random constant A and bitwise AND operation
-    size_t hash = (size_t)(e->A * (objet_vers_nombre(x) & 4294967295) * e->nb_alveoles);
-    return hash % e->nb_alveoles; // Return the bucket index
+    // nb_alveoles is a power of two: keep the high bits of the hash code
+    uint64_t hash = e->hachage(objet_vers_nombre(x), e->graine);
+    return (size_t)(hash >> (64 - __builtin_ctzll(e->nb_alveoles)));
 }
 
-// Function to create an empty ensemble
-Ensemble ensemble_vide() {
+// Recomputes the resize thresholds for the current number of buckets
+static void calculer_seuils(Ensemble e) {
+    e->seuil_agrandissement = (size_t)(e->charge_max * (double)e->nb_alveoles);
+    if (e->seuil_agrandissement == 0) {
+        e->seuil_agrandissement = 1; // Sinon chaque ajout agrandirait la table
+    }
+    e->seuil_reduction = e->nb_alveoles > e->nb_alveoles_min ? (size_t)(e->charge_min * (double)e->nb_alveoles) : 0;
+}
+
+// Smallest number of buckets (a power of two, at least 8) that holds n
+// elements without reaching the growth threshold
+static size_t nb_alveoles_pour(Ensemble e, size_t n) {
+    size_t nb = 8;
+    while ((size_t)(e->charge_max * (double)nb) < n) {
+        nb *= 2;
+    }
+    return nb;
+}
+
+// Function to create an empty ensemble with a given hash function
+Ensemble ensemble_vide_avec_hachage(fonction_hachage hachage) {
     srand(time(NULL)); // Seed the random number generator
 
     // Allocate memory for the ensemble structure
     Ensemble e = (Ensemble)malloc(sizeof(struct TableHachage));
 
     e->nb_alveoles = 8; // Initial number of buckets
-    e->table = (ListeChainee*)malloc(e->nb_alveoles * sizeof(ListeChainee)); // Allocate memory for the array of linked lists
+    e->table = (ListeChainee*)calloc(e->nb_alveoles, sizeof(ListeChainee)); // Allocate memory for the array of (empty) linked lists
 
     e->taille = 0; // Initial number of elements
-    e->A = ((double)rand() / RAND_MAX) * 0.5 + 0.25; // Random constant A between 0.25 and 0.75
+    e->graine = ((uint64_t)rand() << 32) ^ (uint64_t)rand(); // Random seed of the hash function
+    e->hachage = hachage;
+
+    e->ancienne_table = NULL; // No resize in progress
+    e->ancien_nb_alveoles = 0;
+    e->prochaine_alveole = 0;
+    e->progressif = false;
+    e->table_suivante = NULL; // No table prepared for the next growth
+    e->octets_prepares = 0;
+
+    e->reserve = reserve_vide(); // Nodes come from the slab allocator by default
+
+    e->filtre = NULL; // No Bloom filter by default
+    e->nb_suppressions_filtre = 0;
+
+    e->multiensemble = false; // Each duplicate is a node by default
+
+    e->charge_max = 0.5; // Grow when there are more than half as many elements as buckets
+    e->charge_min = 0.125; // Shrink when there are less than an eighth
+    e->nb_alveoles_min = 8;
+    calculer_seuils(e);
+
+    e->statistiques = NULL; // No counters by default
+    e->arbres = NULL; // No long chain yet
     
     return e; // Return the empty ensemble
 }
 
-// Function to add an element to the ensemble
-void ajouter(Ensemble e, type_base x) {
+// Function to create an empty ensemble
+Ensemble ensemble_vide() {
+    return ensemble_vide_avec_hachage(hachage_fibonacci);
+}
 
-    // Check if the load factor exceeds 0.5
+// Bucket of x in the old table (during an incremental resize)
+static size_t ancienne_alveole(Ensemble e, type_base x) {
+    uint64_t hash = e->hachage(objet_vers_nombre(x), e->graine);
+    return (size_t)(hash >> (64 - __builtin_ctzll(e->ancien_nb_alveoles)));
+}
 
-    if (e->taille >= e->nb_alveoles / 2) {
-        // Reallocate the hash table with double the number of slots
+// Number of nodes of a linked list, counting at most max + 1 of them
+static size_t longueur_bornee(ListeChainee l, size_t max) {
+    size_t n = 0;
+    for (; l != NULL && n <= max; l = l->suivant) {
+        n++;
+    }
+    return n;
+}
+
+// Builds the AVL tree of the values of a bucket of the table
+static void arboriser(Ensemble e, size_t index) {
+    if (e->arbres == NULL) {
+        e->arbres = calloc(e->nb_alveoles, sizeof(avl));
+        if (e->arbres == NULL) {
+            fprintf(stderr, "Erreur: Échec de l'allocation de mémoire.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    for (ListeChainee current = e->table[index]; current != NULL; current = current->suivant) {
+        e->arbres[index] = inserer_avl(e->arbres[index], current->valeur);
+    }
+}
+
+// Gives a tree to every bucket of the table longer than SEUIL_ARBORISATION
+static void arboriser_longues_listes(Ensemble e) {
+    for (size_t i = 0; i < e->nb_alveoles; i++) {
+        if ((e->arbres == NULL || e->arbres[i] == NULL)
+            && longueur_bornee(e->table[i], SEUIL_ARBORISATION) > SEUIL_ARBORISATION) {
+            arboriser(e, i);
+        }
+    }
+}
+
+// Keeps the tree of a bucket up to date after x has been added to its list,
+// or gives it one if the list has become too long
+static void apres_ajout_alveole(Ensemble e, size_t index, type_base x) {
+    if (e->arbres != NULL && e->arbres[index] != NULL) {
+        e->arbres[index] = inserer_avl(e->arbres[index], x);
+    } else if (e->table[index]->suivant != NULL
+               && longueur_bornee(e->table[index], SEUIL_ARBORISATION) > SEUIL_ARBORISATION) {
+        arboriser(e, index);
+    }
+}
+
+// Keeps the tree of a bucket up to date after x has been removed from its
+// list, and drops it once the list is short again
+static void apres_suppression_alveole(Ensemble e, size_t index, type_base x) {
+    if (e->arbres == NULL || e->arbres[index] == NULL) {
+        return;
+    }
+    e->arbres[index] = supprimer_avl(e->arbres[index], x);
+    if (longueur_bornee(e->table[index], SEUIL_DESARBORISATION) <= SEUIL_DESARBORISATION) {
+        liberer_avl(e->arbres[index]);
+        e->arbres[index] = NULL;
+    }
+}
+
+// True if x is in the list of a bucket of the table (read in its tree if it has one)
+static bool dans_alveole(Ensemble e, size_t index, type_base x) {
+    if (e->arbres != NULL && e->arbres[index] != NULL) {
+        return rechercher_abr(e->arbres[index], x);
+    }
+    return rechercher_lc(e->table[index], x) != NULL;
+}
+
+// Moves the nodes of (at most) nb buckets of the old table into the new one.
+// The nodes are relinked, not copied: no allocation.
+static void migrer_alveoles(Ensemble e, size_t nb) {
+
+    while (nb > 0 && e->ancienne_table != NULL) {
+
+        ListeChainee current = e->ancienne_table[e->prochaine_alveole];
+
+        while (current != NULL) {
 
-        size_t new_nb_alveoles = e->nb_alveoles * 2;
+            ListeChainee next = current->suivant;
+            size_t new_hash_code = alveole(e, current->valeur);
+            current->suivant = e->table[new_hash_code];
+            e->table[new_hash_code] = current;
+            if (e->arbres != NULL && e->arbres[new_hash_code] != NULL) {
+                e->arbres[new_hash_code] = inserer_avl(e->arbres[new_hash_code], current->valeur);
+            }
+            current = next;
+
+        }
 
-        ListeChainee* new_table = malloc(new_nb_alveoles * sizeof(ListeChainee));
+        e->prochaine_alveole++;
+        nb--;
 
-        // Initialize the new table with empty linked lists
-        for (size_t i = 0; i < new_nb_alveoles; i++) {
-            new_table[i] = liste_chainee_init();
+        // Libérer l'ancienne table de hachage une fois vidée
+        if (e->prochaine_alveole == e->ancien_nb_alveoles) {
+            free(e->ancienne_table);
+            e->ancienne_table = NULL;
+
+            // Des clés qui se percutaient avant se percutent encore : on regarde
+            // les listes de la nouvelle table si l'ancienne avait des arbres
+            if (e->arbres != NULL) {
+                arboriser_longues_listes(e);
+            }
         }
+    }
+}
+
+// Replaces the table by an empty one of a given size, the old one being kept
+// aside until all its buckets are migrated (right away if not progressive).
+static void redimensionner(Ensemble e, size_t new_nb_alveoles) {
+    struct timespec debut;
+    if (e->statistiques != NULL) {
+        clock_gettime(CLOCK_MONOTONIC, &debut);
+    }
 
-        // Réaffecter les éléments de l'ancienne table à la nouvelle
+    // Terminer un éventuel redimensionnement en cours
+    migrer_alveoles(e, SIZE_MAX);
+
+    e->ancienne_table = e->table;
+    e->ancien_nb_alveoles = e->nb_alveoles;
+    e->prochaine_alveole = 0;
+
+    // Les arbres décrivent les alvéoles de l'ancienne table : ils seront reconstruits
+    // à la fin de la migration (le tableau reste alloué pour s'en souvenir)
+    if (e->arbres != NULL) {
         for (size_t i = 0; i < e->nb_alveoles; i++) {
+            liberer_avl(e->arbres[i]);
+        }
+        free(e->arbres);
+        e->arbres = calloc(new_nb_alveoles, sizeof(avl));
+    }
+
+    // Un agrandissement reprend la table préparée à l'avance (vide, et déjà en mémoire)
+    if (e->table_suivante != NULL && new_nb_alveoles == 2 * e->nb_alveoles) {
+        e->table = e->table_suivante;
+    } else {
+        free(e->table_suivante);
+        e->table = calloc(new_nb_alveoles, sizeof(ListeChainee));
+    }
+    e->table_suivante = NULL;
+    e->nb_alveoles = new_nb_alveoles;
+    calculer_seuils(e);
+
+    if (!e->progressif) {
+        migrer_alveoles(e, SIZE_MAX);
+    }
+
+    if (e->statistiques != NULL) {
+        struct StatistiquesEnsemble* s = e->statistiques;
+        struct timespec fin;
+        clock_gettime(CLOCK_MONOTONIC, &fin);
+        uint64_t duree = (uint64_t)(fin.tv_sec - debut.tv_sec) * 1000000000ULL + (uint64_t)fin.tv_nsec - (uint64_t)debut.tv_nsec;
+        s->duree_redimensionnements += duree;
+        s->duree_max_redimensionnement = duree > s->duree_max_redimensionnement ? duree : s->duree_max_redimensionnement;
+        if (new_nb_alveoles > e->ancien_nb_alveoles) {
+            s->nb_agrandissements++;
+        } else {
+            s->nb_reductions++;
+        }
+    }
+}
+
+// Smaller tables come from the heap (below the mmap threshold of malloc),
+// whose pages are usually already there: they are not prepared
+#define TAILLE_MIN_PREPARATION (128 * 1024)
+
+// In progressive mode, once the set is half way to its next growth, allocates
+// the table of that growth and touches its pages OCTETS_PAR_PREPARATION bytes
+// at a time, keeping ahead of the additions. The page faults of the new table
+// then hit a few additions instead of about one in a hundred.
+static void preparer_agrandissement(Ensemble e) {
+    size_t octets = 2 * e->nb_alveoles * sizeof(ListeChainee);
+    size_t moitie = e->seuil_agrandissement / 2;
+    if (!e->progressif || octets < TAILLE_MIN_PREPARATION || e->taille < moitie) {
+        return;
+    }
+    if (e->table_suivante == NULL) {
+        e->table_suivante = calloc(2 * e->nb_alveoles, sizeof(ListeChainee));
+        if (e->table_suivante == NULL) {
+            fprintf(stderr, "Erreur: Échec de l'allocation de mémoire.\n");
+            exit(EXIT_FAILURE);
+        }
+        e->octets_prepares = 0;
+    }
+
+    // Tout doit être touché aux trois quarts du chemin (à mi-chemin depuis la moitié)
+    size_t du = (double)(e->taille - moitie) * 2.0 >= (double)(e->seuil_agrandissement - moitie)
+                ? octets : (size_t)((double)octets * 2.0 * (double)(e->taille - moitie)
+                                    / (double)(e->seuil_agrandissement - moitie));
+    if (e->octets_prepares >= octets || e->octets_prepares > du) {
+        return;
+    }
+    size_t fin = e->octets_prepares + OCTETS_PAR_PREPARATION < octets ? e->octets_prepares + OCTETS_PAR_PREPARATION : octets;
+    volatile char* pages = (volatile char*)e->table_suivante;
+    for (size_t o = e->octets_prepares; o < fin; o += 4096) {
+        pages[o] = 0; // Une écriture suffit à faire allouer la page
+    }
+    e->octets_prepares = fin;
+}
+
+// Resizes the table if its size is outside the thresholds. The new number of
+// buckets puts the load factor at charge_max / 2 at most, as after a growth.
+static void ajuster_nb_alveoles(Ensemble e) {
+    if (e->taille >= e->seuil_agrandissement || e->taille < e->seuil_reduction) {
+        size_t new_nb_alveoles = nb_alveoles_pour(e, 2 * e->taille + 1);
+        if (new_nb_alveoles < e->nb_alveoles_min) {
+            new_nb_alveoles = e->nb_alveoles_min;
+        }
+        if (new_nb_alveoles != e->nb_alveoles) {
+            redimensionner(e, new_nb_alveoles);
+        }
+    }
+}
+
+Ensemble ensemble_avec_capacite(size_t n) {
+    Ensemble e = ensemble_vide();
+    ensemble_reserver(e, n);
+    return e;
+}
+
+void ensemble_reserver(Ensemble e, size_t n) {
+    e->nb_alveoles_min = nb_alveoles_pour(e, n);
+    if (e->nb_alveoles_min > e->nb_alveoles) {
+        redimensionner(e, e->nb_alveoles_min);
+    } else {
+        calculer_seuils(e);
+    }
+}
+
+void ensemble_facteurs_de_charge(Ensemble e, double charge_min, double charge_max) {
+    if (!(charge_max > 0) || !(charge_min >= 0) || charge_max < 4 * charge_min) {
+        fprintf(stderr, "Erreur: Facteurs de charge invalides (il faut 0 <= 4 * charge_min <= charge_max et charge_max > 0).\n");
+        exit(EXIT_FAILURE);
+    }
+    e->charge_min = charge_min;
+    e->charge_max = charge_max;
+    calculer_seuils(e);
+    ajuster_nb_alveoles(e);
+}
+
+void ensemble_activer_statistiques(Ensemble e, bool activer) {
+    free(e->statistiques);
+    e->statistiques = NULL;
+
+    if (activer) {
+        e->statistiques = calloc(1, sizeof(struct StatistiquesEnsemble));
+        if (e->statistiques == NULL) {
+            fprintf(stderr, "Erreur: Échec de l'allocation de mémoire.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+}
+
+size_t ensemble_histogramme_alveoles(Ensemble e, size_t* histogramme, size_t nb_classes) {
+    migrer_alveoles(e, SIZE_MAX);
+
+    size_t plus_longue = 0;
+    for (size_t k = 0; k < nb_classes; k++) {
+        histogramme[k] = 0;
+    }
+    for (size_t i = 0; i < e->nb_alveoles; i++) {
+        size_t longueur_liste = 0;
+        for (ListeChainee current = e->table[i]; current != NULL; current = current->suivant) {
+            longueur_liste++;
+        }
+        histogramme[longueur_liste < nb_classes - 1 ? longueur_liste : nb_classes - 1]++;
+        plus_longue = longueur_liste > plus_longue ? longueur_liste : plus_longue;
+    }
+    return plus_longue;
+}
+
+// Number of classes of the histogram printed by ensemble_diagnostic
+#define NB_CLASSES_DIAGNOSTIC 9
+
+void ensemble_diagnostic(Ensemble e, FILE* sortie) {
+    size_t histogramme[NB_CLASSES_DIAGNOSTIC];
+    size_t plus_longue = ensemble_histogramme_alveoles(e, histogramme, NB_CLASSES_DIAGNOSTIC);
+
+    // Un noeud par élément distinct en mode multi-ensemble, un par occurrence sinon
+    double charge = (double)e->taille / (double)e->nb_alveoles;
+    fprintf(sortie, "Ensemble : %zu éléments%s, %zu alvéoles, facteur de charge %.3f "
+            "(agrandissement à %zu éléments, réduction sous %zu)\n",
+            e->taille, e->multiensemble ? " distincts" : "", e->nb_alveoles, charge,
+            e->seuil_agrandissement, e->seuil_reduction);
 
-            Cellule* current = e->table[i];
+    // Loi de Poisson de paramètre charge : P(k) = exp(-charge) charge^k / k!
+    fprintf(sortie, "Longueur des listes : nombre d'alvéoles (attendu avec un hachage idéal)\n");
+    double probabilite = exp(-charge), cumul = 0;
+    for (size_t k = 0; k < NB_CLASSES_DIAGNOSTIC; k++) {
+        double attendu = (k < NB_CLASSES_DIAGNOSTIC - 1 ? probabilite : 1 - cumul) * (double)e->nb_alveoles;
+        fprintf(sortie, "  %s%zu : %zu (%.0f)\n", k < NB_CLASSES_DIAGNOSTIC - 1 ? "" : ">=", k, histogramme[k], attendu);
+        cumul += probabilite;
+        probabilite *= charge / (double)(k + 1);
+    }
+    fprintf(sortie, "Plus longue liste : %zu noeuds\n", plus_longue);
+
+    struct StatistiquesEnsemble* s = e->statistiques;
+    if (s == NULL) {
+        fprintf(sortie, "Statistiques désactivées (voir ensemble_activer_statistiques)\n");
+        return;
+    }
+    fprintf(sortie, "Recherches fructueuses : %zu, %.3f sondages en moyenne, %zu au plus\n",
+            s->nb_recherches_fructueuses,
+            s->nb_recherches_fructueuses ? (double)s->nb_sondages_fructueux / (double)s->nb_recherches_fructueuses : 0.0,
+            s->max_sondages_fructueux);
+    fprintf(sortie, "Recherches infructueuses : %zu, %.3f sondages en moyenne, %zu au plus\n",
+            s->nb_recherches_infructueuses,
+            s->nb_recherches_infructueuses ? (double)s->nb_sondages_infructueux / (double)s->nb_recherches_infructueuses : 0.0,
+            s->max_sondages_infructueux);
+    fprintf(sortie, "Redimensionnements : %zu agrandissements, %zu réductions, %.3f ms au total, %.3f ms au plus\n",
+            s->nb_agrandissements, s->nb_reductions,
+            (double)s->duree_redimensionnements / 1e6, (double)s->duree_max_redimensionnement / 1e6);
+}
+
+void ensemble_redimensionnement_progressif(Ensemble e, bool progressif) {
+    e->progressif = progressif;
+    if (!progressif) {
+        migrer_alveoles(e, SIZE_MAX);
+        free(e->table_suivante);
+        e->table_suivante = NULL;
+    }
+}
+
+void ensemble_utiliser_reserve(Ensemble e, bool avec_reserve) {
+    if (e->taille != 0) {
+        fprintf(stderr, "Erreur: L'ensemble n'est pas vide.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (avec_reserve && e->reserve == NULL) {
+        e->reserve = reserve_vide();
+    } else if (!avec_reserve && e->reserve != NULL) {
+        liberer_reserve(e->reserve);
+        e->reserve = NULL;
+    }
+}
 
-            while (current != NULL) {
+// Rebuilds the Bloom filter from the elements of the table, with room for
+// 1.5 times as many elements as now (so rebuilds stay O(1) amortised)
+static void reconstruire_filtre(Ensemble e, int bits_par_cle) {
+    uint64_t graine = e->filtre != NULL ? e->filtre->graine : e->graine ^ 0x5851F42D4C957F2DULL;
+    size_t capacite = e->taille < 64 ? 64 : e->taille + e->taille / 2;
 
-                Cellule* next = current->suivant;
-                size_t new_hash_code = alveole(e, current->valeur);
-                inserer_en_tete(&(new_table[new_hash_code]), current->valeur);
-                e->taille++;
-                free(current);
-                current = next;
+    if (e->filtre != NULL) {
+        liberer_filtre_bloom(e->filtre);
+    }
+    e->filtre = filtre_bloom_vide(capacite, bits_par_cle, graine);
+    e->nb_suppressions_filtre = 0;
 
+    if (e->ancienne_table != NULL) {
+        for (size_t i = e->prochaine_alveole; i < e->ancien_nb_alveoles; i++) {
+            for (ListeChainee current = e->ancienne_table[i]; current != NULL; current = current->suivant) {
+                filtre_bloom_ajouter(e->filtre, objet_vers_nombre(current->valeur));
             }
         }
-        
-        // Libérer l'ancienne table de hachage
-        free(e->table);
-        
-        // Mettre à jour la nouvelle table et le nombre d'alvéoles
-        e->table = new_table;
-        e->nb_alveoles = new_nb_alveoles;
+    }
+    for (size_t i = 0; i < e->nb_alveoles; i++) {
+        for (ListeChainee current = e->table[i]; current != NULL; current = current->suivant) {
+            filtre_bloom_ajouter(e->filtre, objet_vers_nombre(current->valeur));
+        }
+    }
+}
+
+// Keeps the Bloom filter (if any) up to date after x has been added
+static void filtre_apres_ajout(Ensemble e, type_base x) {
+    if (e->filtre == NULL) {
+        return;
+    }
+    filtre_bloom_ajouter(e->filtre, objet_vers_nombre(x));
+    if (e->filtre->nb_cles > e->filtre->capacite) {
+        reconstruire_filtre(e, e->filtre->bits_par_cle);
+    }
+}
+
+// Keeps the Bloom filter (if any) up to date after an element has been removed
+static void filtre_apres_suppression(Ensemble e) {
+    if (e->filtre == NULL) {
+        return;
+    }
+    e->nb_suppressions_filtre++;
+    if (e->nb_suppressions_filtre > e->taille / 2) {
+        reconstruire_filtre(e, e->filtre->bits_par_cle);
+    }
+}
+
+// False if x is surely not in the ensemble (according to its Bloom filter)
+static inline bool peut_appartenir(Ensemble e, type_base x) {
+    return e->filtre == NULL || filtre_bloom_contient(e->filtre, objet_vers_nombre(x));
+}
+
+void ensemble_utiliser_filtre(Ensemble e, int bits_par_cle) {
+    if (bits_par_cle > 0) {
+        reconstruire_filtre(e, bits_par_cle);
+    } else if (e->filtre != NULL) {
+        liberer_filtre_bloom(e->filtre);
+        e->filtre = NULL;
+    }
+}
+
+void ensemble_mode_multiensemble(Ensemble e, bool multiensemble) {
+    if (e->taille != 0) {
+        fprintf(stderr, "Erreur: L'ensemble n'est pas vide.\n");
+        exit(EXIT_FAILURE);
+    }
+    e->multiensemble = multiensemble;
+}
+
+// Function to add an element to the ensemble
+void ajouter(Ensemble e, type_base x) {
+
+    // En mode multi-ensemble, un doublon incrémente le compteur de son noeud
+    if (e->multiensemble) {
+        bool existait;
+        ListeChainee n = trouver_ou_ajouter_noeud(e, x, &existait);
+        n->valeur_associee = existait ? n->valeur_associee + 1 : 1;
+        return;
+    }
+
+    migrer_alveoles(e, NB_ALVEOLES_MIGREES);
+    preparer_agrandissement(e);
+
+    // Check if the load factor reaches charge_max (0.5 by default)
+    if (e->taille >= e->seuil_agrandissement) {
+        // Reallocate the hash table with double the number of slots
+        redimensionner(e, e->nb_alveoles * 2);
     }
 
     // Add the element to the appropriate alveole
-    size_t index = alveole(e, x) % e->nb_alveoles;
-    liste_chainee_ajouter(e->table[index], x);
+    size_t index = alveole(e, x);
+    e->table[index] = ajouter_debut_reserve(e->table[index], x, e->reserve);
+    apres_ajout_alveole(e, index, x);
     e->taille++;
+    filtre_apres_ajout(e, x);
 }
 
-bool appartient(Ensemble e, type_base x) {
+// Looks for x without touching the counters, and adds the number of nodes
+// compared to *nb_sondages
+static ListeChainee rechercher_en_comptant(Ensemble e, type_base x, size_t* nb_sondages) {
     // Calculer l'alvéole où rechercher l'élément
     size_t hash_code = alveole(e, x);
+
+    // Le filtre de Bloom écarte la plupart des éléments absents. L'alvéole est
+    // préchargée avant : pour un élément présent, les deux défauts de cache se recouvrent.
+    if (e->filtre != NULL) {
+        __builtin_prefetch(&(e->table[hash_code]));
+        if (!filtre_bloom_contient(e->filtre, objet_vers_nombre(x))) {
+            return NULL;
+        }
+    }
     
-    // Parcourir la liste chaînée correspondante
-    Cellule* current = e->table[hash_code];
+    // Parcourir la liste chaînée correspondante (si son arbre dit que x y est)
+    ListeChainee current = e->table[hash_code];
+    if (e->arbres != NULL && e->arbres[hash_code] != NULL) {
+        (*nb_sondages)++;
+        if (!rechercher_abr(e->arbres[hash_code], x)) {
+            current = NULL;
+        }
+    }
 
     while (current != NULL) {
+        (*nb_sondages)++;
         if (current->valeur == x) {
             // L'élément a été trouvé
-            return true;
+            return current;
         }
         current = current->suivant;
     }
     
+    // Pendant un redimensionnement, l'élément peut être dans une alvéole pas encore migrée
+    if (e->ancienne_table != NULL) {
+        size_t old_hash_code = ancienne_alveole(e, x);
+        if (old_hash_code >= e->prochaine_alveole) {
+            for (current = e->ancienne_table[old_hash_code]; current != NULL; current = current->suivant) {
+                (*nb_sondages)++;
+                if (current->valeur == x) {
+                    return current;
+                }
+            }
+        }
+    }
+
     // L'élément n'a pas été trouvé dans la liste
-    return false;
+    return NULL;
 }
 
-void supprimer(Ensemble e, type_base x) {
+// Adds a lookup to the counters (if they are enabled)
+static void compter_recherche(Ensemble e, bool trouve, size_t nb_sondages) {
+    if (e->statistiques != NULL) {
+        struct StatistiquesEnsemble* s = e->statistiques;
+        if (trouve) {
+            s->nb_recherches_fructueuses++;
+            s->nb_sondages_fructueux += nb_sondages;
+            s->max_sondages_fructueux = nb_sondages > s->max_sondages_fructueux ? nb_sondages : s->max_sondages_fructueux;
+        } else {
+            s->nb_recherches_infructueuses++;
+            s->nb_sondages_infructueux += nb_sondages;
+            s->max_sondages_infructueux = nb_sondages > s->max_sondages_infructueux ? nb_sondages : s->max_sondages_infructueux;
+        }
+    }
+}
+
+ListeChainee rechercher_noeud(Ensemble e, type_base x) {
+    size_t nb_sondages = 0;
+    ListeChainee n = rechercher_en_comptant(e, x, &nb_sondages);
+    compter_recherche(e, n != NULL, nb_sondages);
+    return n;
+}
+
+bool appartient(Ensemble e, type_base x) {
+    // Dans une alvéole arborisée, l'arbre suffit : inutile de chercher le noeud
+    if (e->arbres != NULL && e->ancienne_table == NULL) {
+        size_t index = alveole(e, x);
+        if (e->arbres[index] != NULL) {
+            bool trouve = peut_appartenir(e, x) && rechercher_abr(e->arbres[index], x);
+            compter_recherche(e, trouve, 1);
+            return trouve;
+        }
+    }
+    return rechercher_noeud(e, x) != NULL;
+}
+
+// Number of nodes of value x in a linked list
+static size_t compter_lc(ListeChainee l, type_base x) {
+    size_t nb = 0;
+    for (; l != NULL; l = l->suivant) {
+        nb += (l->valeur == x);
+    }
+    return nb;
+}
+
+size_t multiplicite(Ensemble e, type_base x) {
+    if (e->multiensemble) {
+        ListeChainee n = rechercher_noeud(e, x);
+        return n == NULL ? 0 : (size_t)n->valeur_associee;
+    }
+
+    if (!peut_appartenir(e, x)) {
+        return 0;
+    }
+
+    // Pendant un redimensionnement, les occurrences les plus anciennes peuvent
+    // être dans une alvéole pas encore migrée
+    size_t nb = compter_lc(e->table[alveole(e, x)], x);
+    if (e->ancienne_table != NULL) {
+        size_t old_hash_code = ancienne_alveole(e, x);
+        if (old_hash_code >= e->prochaine_alveole) {
+            nb += compter_lc(e->ancienne_table[old_hash_code], x);
+        }
+    }
+    return nb;
+}
+
+ListeChainee trouver_ou_ajouter_noeud(Ensemble e, type_base x, bool* existait) {
+
+    migrer_alveoles(e, NB_ALVEOLES_MIGREES);
+    preparer_agrandissement(e);
+
+    // Check if the load factor reaches charge_max (before the probe, so that
+    // the bucket found is still the right one when we insert)
+    if (e->taille >= e->seuil_agrandissement) {
+        redimensionner(e, e->nb_alveoles * 2);
+    }
+
+    size_t index = alveole(e, x);
+    bool possible = peut_appartenir(e, x); // Sinon, inutile de parcourir les listes
+    ListeChainee n = (possible && dans_alveole(e, index, x)) ? rechercher_lc(e->table[index], x) : NULL;
+
+    if (n == NULL && possible && e->ancienne_table != NULL) {
+        size_t old_hash_code = ancienne_alveole(e, x);
+        if (old_hash_code >= e->prochaine_alveole) {
+            n = rechercher_lc(e->ancienne_table[old_hash_code], x);
+        }
+    }
+
+    *existait = (n != NULL);
+    if (n == NULL) {
+        e->table[index] = ajouter_debut_reserve(e->table[index], x, e->reserve);
+        apres_ajout_alveole(e, index, x);
+        e->taille++;
+        n = e->table[index];
+        filtre_apres_ajout(e, x);
+    }
+    return n;
+}
+
+bool supprimer_si_present(Ensemble e, type_base x) {
+    migrer_alveoles(e, NB_ALVEOLES_MIGREES);
+
+    if (!peut_appartenir(e, x)) {
+        return false;
+    }
+
+    // En mode multi-ensemble, on ne retire le noeud qu'à sa dernière occurrence
+    if (e->multiensemble) {
+        ListeChainee n = rechercher_noeud(e, x);
+        if (n == NULL) {
+            return false;
+        }
+        if (n->valeur_associee > 1) {
+            n->valeur_associee--;
+            return true;
+        }
+    }
+
     // Calculer l'alvéole où chercher et supprimer l'élément
-    size_t hash_code = alveole(e, x);
+    size_t index = alveole(e, x);
+    ListeChainee* alveole_x = &(e->table[index]);
+
+    // Si l'élément n'y est pas, il est peut-être dans une alvéole pas encore migrée
+    if (!dans_alveole(e, index, x)) {
+        if (e->ancienne_table == NULL) {
+            return false;
+        }
+        size_t old_hash_code = ancienne_alveole(e, x);
+        if (old_hash_code < e->prochaine_alveole
+            || rechercher_lc(e->ancienne_table[old_hash_code], x) == NULL) {
+            return false;
+        }
+        alveole_x = &(e->ancienne_table[old_hash_code]);
+    }
     
-    // Rechercher l'élément dans la liste chaînée correspondante
-    e->table[hash_code] = supprimer_lc(e->table[hash_code], x);
+    // Supprimer l'élément de la liste chaînée correspondante
+    *alveole_x = supprimer_lc_reserve(*alveole_x, x, e->reserve);
+    if (alveole_x == &(e->table[index])) {
+        apres_suppression_alveole(e, index, x);
+    }
     
     // Décrémenter le nombre d'éléments dans la table
     e->taille--;
     
-    // Vérifier si le nombre d'éléments devient inférieur au huitième du nombre d'alvéoles
-    if (e->nb_alveoles >= 16 && e->taille < e->nb_alveoles / 8) {
-
+    // Vérifier si le nombre d'éléments devient inférieur au huitième du nombre
+    // d'alvéoles (charge_min), sans descendre sous la capacité réservée
+    if (e->taille < e->seuil_reduction) {
         // Réallouer une nouvelle table de hachage avec la moitié des alvéoles
-        size_t new_nb_alveoles = e->nb_alveoles / 2;
-
-        ListeChainee* new_table = calloc(new_nb_alveoles, sizeof(ListeChainee));
-        
-        // Réinitialiser le nombre d'éléments dans la nouvelle table
-        e->taille = 0;
-        
-        // Réaffecter les éléments de l'ancienne table à la nouvelle
-        for (size_t i = 0; i < e->nb_alveoles; i++) {
+        redimensionner(e, e->nb_alveoles / 2);
+    }
+
+    filtre_apres_suppression(e);
+    return true;
+}
+
+void supprimer(Ensemble e, type_base x) {
+    if (!supprimer_si_present(e, x)) {
+        fprintf(stderr, "Erreur: " FORMAT_BASE " n'est pas présent dans l'ensemble.\n", x);
+        exit(EXIT_FAILURE);
+    }
+}
+
+
+void appartient_lot(Ensemble e, const type_base* cles, size_t n, bool* resultats) {
+
+    // Pendant un redimensionnement progressif, on recherche les clés une par une
+    // (sans toucher aux compteurs : plusieurs threads peuvent lire l'ensemble)
+    if (e->ancienne_table != NULL) {
+        size_t nb_sondages = 0;
+        for (size_t i = 0; i < n; i++) {
+            resultats[i] = rechercher_en_comptant(e, cles[i], &nb_sondages) != NULL;
+        }
+        return;
+    }
+
+    size_t alveoles[2][TAILLE_LOT];
+    ListeChainee courants[TAILLE_LOT];
+
+    // Hacher le premier groupe et précharger ses alvéoles
+    for (size_t j = 0; j < TAILLE_LOT && j < n; j++) {
+        alveoles[0][j] = alveole(e, cles[j]);
+        __builtin_prefetch(&(e->table[alveoles[0][j]]));
+    }
+
+    for (size_t debut = 0, g = 0; debut < n; debut += TAILLE_LOT, g ^= 1) {
+        size_t m = (n - debut < TAILLE_LOT) ? n - debut : TAILLE_LOT;
+
+        // 1. Hacher le groupe suivant et précharger ses alvéoles
+        for (size_t j = 0; j < TAILLE_LOT && debut + TAILLE_LOT + j < n; j++) {
+            alveoles[g ^ 1][j] = alveole(e, cles[debut + TAILLE_LOT + j]);
+            __builtin_prefetch(&(e->table[alveoles[g ^ 1][j]]));
+        }
+
+        // 2. Lire les têtes des listes (déjà en cache) et précharger les premiers noeuds
+        for (size_t j = 0; j < m; j++) {
+            courants[j] = peut_appartenir(e, cles[debut + j]) ? e->table[alveoles[g][j]] : NULL;
+            resultats[debut + j] = false;
+            if (courants[j] != NULL && e->arbres != NULL && e->arbres[alveoles[g][j]] != NULL) {
+                // Alvéole arborisée : l'arbre répond tout de suite
+                resultats[debut + j] = rechercher_abr(e->arbres[alveoles[g][j]], cles[debut + j]);
+                courants[j] = NULL;
+            }
+            if (courants[j] != NULL) {
+                __builtin_prefetch(courants[j]);
+            }
+        }
+
+        // 3. Avancer d'un noeud dans chaque liste à tour de rôle, en préchargeant
+        // le noeud suivant : les défauts de cache des m listes se recouvrent
+        size_t nb_actifs = m;
+        while (nb_actifs > 0) {
+            nb_actifs = 0;
+            for (size_t j = 0; j < m; j++) {
+                ListeChainee c = courants[j];
+                if (c == NULL) {
+                    continue;
+                }
+                if (c->valeur == cles[debut + j]) {
+                    resultats[debut + j] = true;
+                    courants[j] = NULL;
+                    continue;
+                }
+                c = c->suivant;
+                courants[j] = c;
+                if (c != NULL) {
+                    __builtin_prefetch(c);
+                    nb_actifs++;
+                }
+            }
+        }
+    }
+}
+
+void ajouter_lot(Ensemble e, const type_base* cles, size_t n) {
+
+    // En mode multi-ensemble, on ne sait pas combien de noeuds il faudra
+    if (e->multiensemble) {
+        for (size_t i = 0; i < n; i++) {
+            ajouter(e, cles[i]);
+        }
+        return;
+    }
+
+    // Une seule réallocation, à la taille finale
+    size_t new_nb_alveoles = nb_alveoles_pour(e, e->taille + n);
+    if (new_nb_alveoles > e->nb_alveoles) {
+        redimensionner(e, new_nb_alveoles);
+    }
+    migrer_alveoles(e, SIZE_MAX);
+
+    // Les alvéoles sont calculées et préchargées TAILLE_LOT clés à l'avance
+    size_t alveoles[TAILLE_LOT];
+    for (size_t i = 0; i < TAILLE_LOT && i < n; i++) {
+        alveoles[i] = alveole(e, cles[i]);
+        __builtin_prefetch(&(e->table[alveoles[i]]), 1);
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        size_t index = alveoles[i % TAILLE_LOT];
+        if (i + TAILLE_LOT < n) {
+            alveoles[i % TAILLE_LOT] = alveole(e, cles[i + TAILLE_LOT]);
+            __builtin_prefetch(&(e->table[alveoles[i % TAILLE_LOT]]), 1);
+        }
+        e->table[index] = ajouter_debut_reserve(e->table[index], cles[i], e->reserve);
+        apres_ajout_alveole(e, index, cles[i]);
+    }
+    e->taille += n;
+
+    if (e->filtre != NULL) {
+        if (e->filtre->nb_cles + n > e->filtre->capacite) {
+            reconstruire_filtre(e, e->filtre->bits_par_cle);
+        } else {
+            for (size_t i = 0; i < n; i++) {
+                filtre_bloom_ajouter(e->filtre, objet_vers_nombre(cles[i]));
+            }
+        }
+    }
+}
+
+
+// Number of keys handed to appartient_lot at once by the set operations
+#define TAILLE_TAMPON 256
+
+// Empty result of a set operation: same hash function and seed as the set it
+// is filled from, and enough buckets for `capacite` elements
+static Ensemble ensemble_resultat(Ensemble modele, size_t capacite) {
+    Ensemble r = ensemble_vide_avec_hachage(modele->hachage);
+    r->graine = modele->graine;
+    r->charge_min = modele->charge_min;
+    r->charge_max = modele->charge_max;
+
+    free(r->table);
+    r->nb_alveoles = nb_alveoles_pour(r, capacite);
+    r->table = calloc(r->nb_alveoles, sizeof(ListeChainee));
+    calculer_seuils(r);
+    return r;
+}
+
+// Adds the keys of the buffer to r (without duplicates, and without resize
+// check), keeping only those whose membership in `autre` is `garder`
+// (all of them if `autre` is NULL). Returns the number of keys added.
+static size_t vider_tampon(Ensemble r, Reserve reserve, Ensemble autre, bool garder,
+                           const type_base* tampon, size_t n) {
+    bool presents[TAILLE_TAMPON];
+    if (autre != NULL) {
+        appartient_lot(autre, tampon, n, presents);
+    }
+
+    size_t nb_ajoutes = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (autre != NULL && presents[i] != garder) {
+            continue;
+        }
+        size_t index = alveole(r, tampon[i]);
+        if (rechercher_lc(r->table[index], tampon[i]) == NULL) {
+            r->table[index] = ajouter_debut_reserve(r->table[index], tampon[i], reserve);
+            nb_ajoutes++;
+        }
+    }
+    return nb_ajoutes;
+}
+
+// Filters the chains table[debut..fin[ into r (see vider_tampon)
+static size_t filtrer_alveoles(Ensemble r, Reserve reserve, ListeChainee* table,
+                               size_t debut, size_t fin, Ensemble autre, bool garder) {
+    type_base tampon[TAILLE_TAMPON];
+    size_t n = 0;
+    size_t nb_ajoutes = 0;
 
-            e->table[i] = liste_chainee_vers_liste(e->table[i]);
-            
-            while (e->table[i] != NULL) {
-                type_base element = extraire_premier(&(e->table[i]));
-                size_t new_hash_code = alveole(e, element);
-                inserer_en_tete(&(new_table[new_hash_code]), element);
-                e->taille++;
+    for (size_t i = debut; i < fin; i++) {
+        for (ListeChainee current = table[i]; current != NULL; current = current->suivant) {
+            tampon[n] = current->valeur;
+            n++;
+            if (n == TAILLE_TAMPON) {
+                nb_ajoutes += vider_tampon(r, reserve, autre, garder, tampon, n);
+                n = 0;
             }
         }
-        
-        // Libérer l'ancienne table de hachage
-        free(e->table);
-        
-        // Mettre à jour la nouvelle table et le nombre d'alvéoles
-        e->table = new_table;
-        e->nb_alveoles = new_nb_alveoles;
     }
+    return nb_ajoutes + vider_tampon(r, reserve, autre, garder, tampon, n);
+}
+
+// Filters every element of `source` into r, in the calling thread
+static void filtrer(Ensemble r, Ensemble source, Ensemble autre, bool garder) {
+    if (source->ancienne_table != NULL) {
+        r->taille += filtrer_alveoles(r, r->reserve, source->ancienne_table, source->prochaine_alveole,
+                                      source->ancien_nb_alveoles, autre, garder);
+    }
+    r->taille += filtrer_alveoles(r, r->reserve, source->table, 0, source->nb_alveoles, autre, garder);
+}
+
+// Work shared by the threads of a parallel filter. The bucket ranges of
+// `source` are cut into nb_parts parts (a power of two): since r uses the same
+// hash and seed, part p of `source` only fills part p of r.
+struct Filtrage {
+    Ensemble r;
+    Ensemble source;
+    Ensemble autre;
+    bool garder;
+    size_t nb_parts;
+    atomic_size_t prochaine_part;
+};
+
+// One thread of a parallel filter, with its own node reserve
+struct ThreadFiltrage {
+    struct Filtrage* filtrage;
+    Reserve reserve;
+    size_t nb_ajoutes;
+    pthread_t id;
+};
+
+static void* filtrer_parts(void* arg) {
+    struct ThreadFiltrage* t = arg;
+    struct Filtrage* f = t->filtrage;
+    size_t taille_part = f->source->nb_alveoles / f->nb_parts;
+
+    size_t p;
+    while ((p = atomic_fetch_add(&f->prochaine_part, 1)) < f->nb_parts) {
+        t->nb_ajoutes += filtrer_alveoles(f->r, t->reserve, f->source->table, p * taille_part,
+                                          (p + 1) * taille_part, f->autre, f->garder);
+    }
+    return NULL;
 }
 
+// Filters every element of `source` into r with nb_threads threads
+// (r must have been created by ensemble_resultat(source, ...))
+static void filtrer_parallele(Ensemble r, Ensemble source, Ensemble autre, bool garder, int nb_threads) {
+
+    // Pendant un redimensionnement progressif, les plages ne se correspondent pas
+    if (nb_threads <= 1 || source->ancienne_table != NULL) {
+        filtrer(r, source, autre, garder);
+        return;
+    }
+
+    // Des parts plus nombreuses que les threads, pour équilibrer la charge
+    size_t nb_max = source->nb_alveoles < r->nb_alveoles ? source->nb_alveoles : r->nb_alveoles;
+    struct Filtrage f = {r, source, autre, garder, 1, 0};
+    while (f.nb_parts < 64 * (size_t)nb_threads && f.nb_parts * 2 <= nb_max) {
+        f.nb_parts *= 2;
+    }
+
+    struct ThreadFiltrage* threads = malloc(nb_threads * sizeof(struct ThreadFiltrage));
+    for (int i = 0; i < nb_threads; i++) {
+        threads[i].filtrage = &f;
+        threads[i].reserve = r->reserve != NULL ? reserve_vide() : NULL;
+        threads[i].nb_ajoutes = 0;
+    }
+    for (int i = 1; i < nb_threads; i++) {
+        pthread_create(&threads[i].id, NULL, filtrer_parts, &threads[i]);
+    }
+    filtrer_parts(&threads[0]);
+
+    for (int i = 0; i < nb_threads; i++) {
+        if (i > 0) {
+            pthread_join(threads[i].id, NULL);
+        }
+        r->taille += threads[i].nb_ajoutes;
+        if (threads[i].reserve != NULL) {
+            fusionner_reserves(r->reserve, threads[i].reserve);
+        }
+    }
+    free(threads);
+}
+
+Ensemble ensemble_union_parallele(Ensemble a, Ensemble b, int nb_threads) {
+    Ensemble grand = a->taille >= b->taille ? a : b;
+    Ensemble petit = a->taille >= b->taille ? b : a;
+
+    Ensemble r = ensemble_resultat(grand, a->taille + b->taille);
+    filtrer_parallele(r, grand, NULL, true, nb_threads);
+    // Les éléments du petit ensemble ne tombent pas dans les mêmes plages :
+    // on les ajoute dans le thread appelant
+    filtrer(r, petit, grand, false);
+    ajuster_nb_alveoles(r); // Si le résultat est beaucoup plus petit que prévu
+    if (a->arbres != NULL || b->arbres != NULL) {
+        arboriser_longues_listes(r); // Même hachage et même graine : les mêmes clés se percutent
+    }
+    return r;
+}
+
+Ensemble ensemble_intersection_parallele(Ensemble a, Ensemble b, int nb_threads) {
+    Ensemble grand = a->taille >= b->taille ? a : b;
+    Ensemble petit = a->taille >= b->taille ? b : a;
+
+    Ensemble r = ensemble_resultat(petit, petit->taille);
+    filtrer_parallele(r, petit, grand, true, nb_threads);
+    ajuster_nb_alveoles(r); // Si le résultat est beaucoup plus petit que prévu
+    if (a->arbres != NULL || b->arbres != NULL) {
+        arboriser_longues_listes(r); // Même hachage et même graine : les mêmes clés se percutent
+    }
+    return r;
+}
+
+Ensemble ensemble_difference_parallele(Ensemble a, Ensemble b, int nb_threads) {
+    Ensemble r = ensemble_resultat(a, a->taille);
+    filtrer_parallele(r, a, b, false, nb_threads);
+    ajuster_nb_alveoles(r); // Si le résultat est beaucoup plus petit que prévu
+    if (a->arbres != NULL || b->arbres != NULL) {
+        arboriser_longues_listes(r); // Même hachage et même graine : les mêmes clés se percutent
+    }
+    return r;
+}
+
+Ensemble ensemble_union(Ensemble a, Ensemble b) {
+    return ensemble_union_parallele(a, b, 1);
+}
+
+Ensemble ensemble_intersection(Ensemble a, Ensemble b) {
+    return ensemble_intersection_parallele(a, b, 1);
+}
+
+Ensemble ensemble_difference(Ensemble a, Ensemble b) {
+    return ensemble_difference_parallele(a, b, 1);
+}
+
+// True if the n buffered elements all belong to `autre`
+static bool tampon_inclus(Ensemble autre, const type_base* tampon, size_t n) {
+    bool presents[TAILLE_TAMPON];
+    appartient_lot(autre, tampon, n, presents);
+    for (size_t j = 0; j < n; j++) {
+        if (!presents[j]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// True if every element of the chains table[debut..fin[ belongs to `autre`
+static bool alveoles_incluses(ListeChainee* table, size_t debut, size_t fin, Ensemble autre) {
+    type_base tampon[TAILLE_TAMPON];
+    size_t n = 0;
+
+    for (size_t i = debut; i < fin; i++) {
+        for (ListeChainee current = table[i]; current != NULL; current = current->suivant) {
+            tampon[n] = current->valeur;
+            n++;
+            if (n == TAILLE_TAMPON) {
+                if (!tampon_inclus(autre, tampon, n)) {
+                    return false;
+                }
+                n = 0;
+            }
+        }
+    }
+    return n == 0 || tampon_inclus(autre, tampon, n);
+}
+
+bool est_sous_ensemble(Ensemble a, Ensemble b) {
+    if (a->ancienne_table != NULL
+        && !alveoles_incluses(a->ancienne_table, a->prochaine_alveole, a->ancien_nb_alveoles, b)) {
+        return false;
+    }
+    return alveoles_incluses(a->table, 0, a->nb_alveoles, b);
+}
 
 // Function to free the memory associated with the ensemble
 void liberer_ensemble(Ensemble e) {
-    for (size_t i = 0; i < e->nb_alveoles; i++) {
-        liberer_liste_chainee(e->table[i]);
+    if (e->filtre != NULL) {
+        liberer_filtre_bloom(e->filtre);
+    }
+    free(e->statistiques);
+    if (e->arbres != NULL) {
+        for (size_t i = 0; i < e->nb_alveoles; i++) {
+            liberer_avl(e->arbres[i]);
+        }
+        free(e->arbres);
+        e->arbres = NULL; // La migration ci-dessous ne doit plus toucher aux arbres
+    }
+    if (e->reserve != NULL) {
+        // Every node belongs to the slab allocator: free the blocks, not the chains
+        liberer_reserve(e->reserve);
+        free(e->ancienne_table);
+    } else {
+        migrer_alveoles(e, SIZE_MAX);
+        for (size_t i = 0; i < e->nb_alveoles; i++) {
+            liberer_liste_chainee(e->table[i]);
+        }
     }
     free(e->table);
+    free(e->table_suivante);
     free(e);
 }
 
+// Appends the elements of a linked list to a list (each one repeated as many
+// times as it occurs, in multiset mode)
+static void ajouter_chaine_en_fin(Liste l, ListeChainee current, bool multiensemble) {
+    while (current != NULL) {
+        int nb_occurrences = multiensemble ? current->valeur_associee : 1;
+        for (int k = 0; k < nb_occurrences; k++) {
+            ajouter_en_fin (l, current->valeur);
+        }
+        current = current->suivant;
+    }
+}
+
 // Function to convert an ensemble to a list
 Liste ensemble_vers_liste(Ensemble e) {
     Liste nouvelle_liste = liste_vide();
-    for (size_t i = 0; i < e->nb_alveoles; i++) {
-        ListeChainee current = e->table[i];
-        while (current != NULL) {
-            ajouter_en_fin (nouvelle_liste, current->valeur);
-            current = current->suivant;
+    if (e->ancienne_table != NULL) {
+        for (size_t i = e->prochaine_alveole; i < e->ancien_nb_alveoles; i++) {
+            ajouter_chaine_en_fin(nouvelle_liste, e->ancienne_table[i], e->multiensemble);
         }
     }
+    for (size_t i = 0; i < e->nb_alveoles; i++) {
+        ajouter_chaine_en_fin(nouvelle_liste, e->table[i], e->multiensemble);
+    }
     return nouvelle_liste;
 }
 
-// Function to convert a list to an ensemble
-Ensemble liste_vers_ensemble(Liste l) {
-    Ensemble e = ensemble_vide();
-    Liste current = l;
-    while (current != NULL) {
-        ajouter(e, current->valeur);
-        current = current->suivant;
+// Below this many elements per thread, a bulk build adds the keys one by one
+#define NB_MIN_CLES_PAR_THREAD 65536
+
+// Largest number of buckets in a part of a bulk build: the chain heads of a
+// part (256 Kio) stay in the cache while its keys are added
+#define NB_MAX_ALVEOLES_PAR_PART 32768
+
+// Largest number of parts of a bulk build: beyond that, the partitioning pass
+// writes to too many places at once
+#define NB_MAX_PARTS 1024
+
+// Work shared by the threads of a bulk build. Each thread counts, then
+// scatters, a slice of the list by part (the top bits of the hash code, that
+// is a range of buckets); then the parts are filled one at a time by whichever
+// thread takes them, so no two threads ever touch the same bucket.
+struct Construction {
+    Ensemble e;
+    const type_base* cles;
+    size_t nb_cles;
+    type_base* reparties; // The keys, grouped by part
+    size_t* debuts; // debuts[t * nb_parts + p]: where thread t writes the keys of part p
+    size_t* debuts_parts; // Part p is reparties[debuts_parts[p]..debuts_parts[p + 1][
+    size_t nb_parts;
+    int decalage_part;
+    int nb_threads;
+    int etape; // 0: count, 1: scatter, 2: fill
+    atomic_size_t prochaine_part;
+    atomic_bool longues_listes; // Set if a list is longer than SEUIL_ARBORISATION
+};
+
+// One thread of a bulk build, with its own node reserve
+struct ThreadConstruction {
+    struct Construction* construction;
+    int numero;
+    Reserve reserve;
+    pthread_t id;
+};
+
+static void* construire_parts(void* arg) {
+    struct ThreadConstruction* t = arg;
+    struct Construction* c = t->construction;
+    Ensemble e = c->e;
+    size_t debut = c->nb_cles * t->numero / c->nb_threads;
+    size_t fin = c->nb_cles * (t->numero + 1) / c->nb_threads;
+    size_t* debuts = c->debuts + t->numero * c->nb_parts;
+
+    if (c->etape == 0) {
+        for (size_t i = debut; i < fin; i++) {
+            debuts[e->hachage(objet_vers_nombre(c->cles[i]), e->graine) >> c->decalage_part]++;
+        }
+    } else if (c->etape == 1) {
+        for (size_t i = debut; i < fin; i++) {
+            size_t p = e->hachage(objet_vers_nombre(c->cles[i]), e->graine) >> c->decalage_part;
+            c->reparties[debuts[p]] = c->cles[i];
+            debuts[p]++;
+        }
+    } else {
+        size_t p;
+        while ((p = atomic_fetch_add(&c->prochaine_part, 1)) < c->nb_parts) {
+            size_t debut_alveoles = SIZE_MAX, fin_alveoles = 0;
+            for (size_t i = c->debuts_parts[p]; i < c->debuts_parts[p + 1]; i++) {
+                size_t index = alveole(e, c->reparties[i]);
+                e->table[index] = ajouter_debut_reserve(e->table[index], c->reparties[i], t->reserve);
+                debut_alveoles = index < debut_alveoles ? index : debut_alveoles;
+                fin_alveoles = index + 1 > fin_alveoles ? index + 1 : fin_alveoles;
+            }
+
+            // Les listes de la part sont encore dans le cache : on cherche les trop longues
+            for (size_t i = debut_alveoles; i < fin_alveoles; i++) {
+                if (longueur_bornee(e->table[i], SEUIL_ARBORISATION) > SEUIL_ARBORISATION) {
+                    atomic_store(&c->longues_listes, true);
+                    break;
+                }
+            }
+        }
+    }
+    return NULL;
+}
+
+// Runs the current step of a bulk build on every thread (the first one being
+// the calling thread)
+static void etape_construction(struct ThreadConstruction* threads, int nb_threads) {
+    for (int i = 1; i < nb_threads; i++) {
+        pthread_create(&threads[i].id, NULL, construire_parts, &threads[i]);
+    }
+    construire_parts(&threads[0]);
+    for (int i = 1; i < nb_threads; i++) {
+        pthread_join(threads[i].id, NULL);
+    }
+}
+
+// Function to convert a list to an ensemble, with several threads
+Ensemble liste_vers_ensemble_parallele(Liste l, int nb_threads) {
+    size_t n = longueur(l);
+    Ensemble e = ensemble_avec_capacite(n);
+
+    if (nb_threads < 1) {
+        nb_threads = 1;
     }
+    if (nb_threads > 1 && n < NB_MIN_CLES_PAR_THREAD * (size_t)nb_threads) {
+        nb_threads = (int)(n / NB_MIN_CLES_PAR_THREAD) + 1;
+    }
+
+    // Petite liste : les têtes de listes chaînées tiennent déjà dans le cache
+    if (nb_threads == 1 && e->nb_alveoles <= NB_MAX_ALVEOLES_PAR_PART) {
+        for (size_t i = 0; i < n; i++) {
+            ajouter(e, element(l, i));
+        }
+        ensemble_reserver(e, 0); // La capacité n'était qu'une indication : la table pourra être réduite
+        return e;
+    }
+
+    // Assez de parts pour que chacune tienne dans le cache, et pour équilibrer la charge
+    struct Construction c = {e, l->tableau, n, NULL, NULL, NULL, 1, 64, nb_threads, 0, 0, false};
+    while (c.nb_parts < e->nb_alveoles && c.nb_parts < NB_MAX_PARTS
+           && (e->nb_alveoles / c.nb_parts > NB_MAX_ALVEOLES_PAR_PART || c.nb_parts < 16 * (size_t)nb_threads)) {
+        c.nb_parts *= 2;
+    }
+    c.decalage_part = 64 - __builtin_ctzll(c.nb_parts); // Au moins 8 parts : le décalage est inférieur à 64
+
+    c.reparties = malloc(n * sizeof(type_base));
+    c.debuts = calloc(nb_threads * c.nb_parts, sizeof(size_t));
+    c.debuts_parts = malloc((c.nb_parts + 1) * sizeof(size_t));
+    struct ThreadConstruction* threads = malloc(nb_threads * sizeof(struct ThreadConstruction));
+    if (c.reparties == NULL || c.debuts == NULL || c.debuts_parts == NULL || threads == NULL) {
+        fprintf(stderr, "Erreur: Échec de l'allocation de mémoire.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < nb_threads; i++) {
+        threads[i].construction = &c;
+        threads[i].numero = i;
+        threads[i].reserve = e->reserve != NULL ? reserve_vide() : NULL;
+    }
+
+    etape_construction(threads, nb_threads);
+
+    // Les compteurs deviennent des positions : la part p commence après les parts
+    // précédentes, et le thread t y écrit après les threads précédents
+    size_t position = 0;
+    for (size_t p = 0; p < c.nb_parts; p++) {
+        c.debuts_parts[p] = position;
+        for (int t = 0; t < nb_threads; t++) {
+            size_t nb = c.debuts[t * c.nb_parts + p];
+            c.debuts[t * c.nb_parts + p] = position;
+            position += nb;
+        }
+    }
+    c.debuts_parts[c.nb_parts] = position;
+
+    c.etape = 1;
+    etape_construction(threads, nb_threads);
+    c.etape = 2;
+    etape_construction(threads, nb_threads);
+
+    for (int i = 0; i < nb_threads; i++) {
+        if (threads[i].reserve != NULL) {
+            fusionner_reserves(e->reserve, threads[i].reserve);
+        }
+    }
+    e->taille = n;
+    ensemble_reserver(e, 0);
+    if (atomic_load(&c.longues_listes)) {
+        arboriser_longues_listes(e);
+    }
+
+    free(threads);
+    free(c.debuts_parts);
+    free(c.debuts);
+    free(c.reparties);
     return e;
 }
+
+// Function to convert a list to an ensemble
+Ensemble liste_vers_ensemble(Liste l) {
+    return liste_vers_ensemble_parallele(l, 1);
+}
@@ -7,40 +7,168 @@
 #define __ENSEMBLE__H__
 
 #include <stdlib.h>
+#include <stdio.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include "hachage.h"
 #include "liste_chainee.h"
+#include "reserve_noeuds.h"
+#include "filtre_bloom.h"
+#include "avl.h"
 #include "liste.h"
 
 /* Description de la structure */
 
+/**
+ * @brief Les compteurs d'un ensemble dont les statistiques sont activées
+ * (voir `ensemble_activer_statistiques`). \n
+ * Un "sondage" est la comparaison de x avec un noeud d'une liste chaînée :
+ * une recherche écartée par le filtre de Bloom compte donc 0 sondage, et la
+ * recherche dans l'arbre d'une alvéole (voir SEUIL_ARBORISATION) en compte 1.
+ */
+struct StatistiquesEnsemble{
+	size_t nb_recherches_fructueuses; /**< Le nombre de recherches qui ont trouvé l'élément. */
+	size_t nb_sondages_fructueux; /**< Le nombre total de sondages de ces recherches. */
+	size_t max_sondages_fructueux; /**< Le plus grand nombre de sondages d'une de ces recherches. */
+	size_t nb_recherches_infructueuses; /**< Le nombre de recherches d'un élément absent. */
+	size_t nb_sondages_infructueux; /**< Le nombre total de sondages de ces recherches. */
+	size_t max_sondages_infructueux; /**< Le plus grand nombre de sondages d'une de ces recherches. */
+	size_t nb_agrandissements; /**< Le nombre de redimensionnements qui ont augmenté le nombre d'alvéoles. */
+	size_t nb_reductions; /**< Le nombre de redimensionnements qui l'ont diminué. */
+	uint64_t duree_redimensionnements; /**< La durée totale des redimensionnements, en nanosecondes. */
+	uint64_t duree_max_redimensionnement; /**< La durée du plus long, en nanosecondes. */
+};
+
 /**
  * @brief Structure codant une table de hachage \n
- * On autorisera à avoir des doublons.
+ * On autorisera à avoir des doublons : chaque occurrence est un noeud de la
+ * liste chaînée de son alvéole, sauf en mode multi-ensemble (voir
+ * `ensemble_mode_multiensemble`) où chaque élément distinct n'a qu'un noeud,
+ * dont le champ `valeur_associee` compte les occurrences.
  * Par contre, on s'imposera les contraintes suivantes :
  * @li le nombre d'alvéoles vaut au minimum le double du nombre d'éléments 
  * (sauf si la taille est inférieure à 2)
  * @li le nombre d'alvéoles vaut au maximum l'octuple du nombre d'éléments
- * @li la fonction de hachage sera une fonction multiplicative randomisée :
- * elle sera de la forme  `k -> |_ A * (k & 4294967295) * nb_alveoles _| modulo nb_alveoles`,
- * où A est un réel (aléatoire) entre 0.25 et 0.75. \n
- * (k & 4294967295) est l'opération qui permet de garder les 32 bits les plus faibles de k :
- * le problème c'est que l'opération k * nb_alveoles fait perdre de la précision
- * si k est supérieur à 2**32.
+ * (sauf s'il vaut 8, ou la capacité réservée par `ensemble_reserver`)
+ * @li ces deux rapports (facteurs de charge 1/2 et 1/8) sont ceux par défaut :
+ * on peut les changer pour chaque ensemble avec `ensemble_facteurs_de_charge`
+ * @li le nombre d'alvéoles est une puissance de deux
+ * @li la fonction de hachage est choisie à la création de l'ensemble 
+ * parmi celles de `hachage.h` (par défaut `hachage_fibonacci`) ; elle est
+ * randomisée par une graine aléatoire. Le numéro d'alvéole est formé des
+ * bits de poids fort du code de hachage.
+ * @li une alvéole dont la liste dépasse SEUIL_ARBORISATION noeuds reçoit en
+ * plus un AVL de ses valeurs (voir `avl.h`) : la liste reste la référence
+ * (les noeuds ne bougent pas), l'arbre dit en O(log n) si une valeur y est.
  */
  
 struct TableHachage{
 	
 	ListeChainee* table; /**< L'adresse de la table de hachage (listes chaînées). */
 	
-	size_t nb_alveoles; /**< La taille du tableau **table** */
+	size_t nb_alveoles; /**< La taille du tableau **table** (une puissance de deux) */
 	
 	size_t taille;  /**< Le nombre d'éléments dans la table. */
 	
-	double A; /**< La constante A dans la fonction de hachage
-	* `k -> |_ A * (k & 4294967295) * nb_alveoles _| modulo nb_alveoles`,
-	* où k est l'entier associé à l'objet.  */
+	uint64_t graine; /**< La graine aléatoire passée à la fonction de hachage. */
+	
+	fonction_hachage hachage; /**< Un pointeur vers la fonction de hachage
+	* utilisée par cet ensemble. \n
+	* `hachage_multiplicatif_reel` correspond à l'ancienne fonction
+	* `k -> |_ A * (k & 4294967295) * nb_alveoles _| modulo nb_alveoles`. */
+	
+	ListeChainee* ancienne_table; /**< Pendant un redimensionnement progressif, 
+	* la table d'avant le redimensionnement (dont les alvéoles n'ont pas toutes
+	* été migrées) ; le pointeur nul sinon. */
+	
+	size_t ancien_nb_alveoles; /**< La taille du tableau **ancienne_table** */
+	
+	size_t prochaine_alveole; /**< Les alvéoles de **ancienne_table** d'indice
+	* inférieur à **prochaine_alveole** ont déjà été migrées (elles sont vides). */
+	
+	bool progressif; /**< Si vrai, les redimensionnements sont progressifs :
+	* chaque appel à `ajouter` ou `supprimer` migre au plus NB_ALVEOLES_MIGREES 
+	* alvéoles de l'ancienne table vers la nouvelle. Sinon, tout est migré d'un coup. */
+	
+	ListeChainee* table_suivante; /**< En mode progressif, la table (vide) du prochain
+	* agrandissement (2 * **nb_alveoles** alvéoles), allouée à l'avance et dont les pages
+	* sont touchées petit à petit ; le pointeur nul sinon. */
+	
+	size_t octets_prepares; /**< Le nombre d'octets de **table_suivante** déjà touchés. */
+	
+	Reserve reserve; /**< La réserve d'où viennent les noeuds des listes chaînées 
+	* (voir `reserve_noeuds.h`). Si c'est le pointeur nul, les noeuds sont 
+	* alloués un par un avec malloc. */
+	
+	FiltreBloom filtre; /**< Un filtre de Bloom contenant (au moins) tous les
+	* éléments de l'ensemble, consulté avant de parcourir une alvéole
+	* (voir `ensemble_utiliser_filtre`) ; le pointeur nul s'il n'y en a pas. */
+	
+	size_t nb_suppressions_filtre; /**< Le nombre d'éléments supprimés depuis la
+	* construction du filtre (ils y sont toujours). */
+	
+	bool multiensemble; /**< Si vrai, les doublons ne sont pas des noeuds séparés :
+	* le champ `valeur_associee` de chaque noeud est le nombre d'occurrences de
+	* son élément, et **taille** est le nombre d'éléments distincts. */
+	
+	double charge_max; /**< Le facteur de charge (nombre d'éléments par alvéole)
+	* à partir duquel `ajouter` double le nombre d'alvéoles (1/2 par défaut). */
+	
+	double charge_min; /**< Le facteur de charge en dessous duquel `supprimer`
+	* divise le nombre d'alvéoles par deux (1/8 par défaut ; 0 pour ne jamais réduire). */
+	
+	size_t nb_alveoles_min; /**< Le nombre d'alvéoles en dessous duquel on ne
+	* réduit jamais la table (8, ou plus après `ensemble_reserver`). */
+	
+	size_t seuil_agrandissement; /**< **charge_max** * **nb_alveoles**, recalculé à chaque
+	* redimensionnement : on agrandit quand la taille atteint ce seuil. */
+	
+	size_t seuil_reduction; /**< **charge_min** * **nb_alveoles** (0 si **nb_alveoles**
+	* vaut **nb_alveoles_min**) : on réduit quand la taille passe en dessous. */
+	
+	struct StatistiquesEnsemble* statistiques; /**< Les compteurs de l'ensemble
+	* (voir `ensemble_activer_statistiques`) ; le pointeur nul s'ils sont désactivés. */
+	
+	avl* arbres; /**< Pour chaque alvéole de **table**, l'AVL des valeurs de sa liste
+	* si elle a été arborisée, NULL sinon ; le pointeur nul si aucune liste n'a
+	* jamais dépassé SEUIL_ARBORISATION noeuds. */
 };
 
+/**
+ * @brief Le nombre d'alvéoles de l'ancienne table migrées à chaque appel
+ * à `ajouter` ou `supprimer` pendant un redimensionnement progressif. \n
+ * Il en faut au moins 2 pour que la migration d'un agrandissement soit finie
+ * avant le suivant ; si un redimensionnement arrive avant la fin de la
+ * migration précédente, celle-ci est terminée d'un coup.
+ */
+#define NB_ALVEOLES_MIGREES 8
+
+/**
+ * @brief En mode progressif, le nombre d'octets de la table du prochain
+ * agrandissement touchés d'un coup par un ajout (voir
+ * `ensemble_redimensionnement_progressif`) : 32 pages, soit environ un ajout
+ * sur 2000 qui paie 32 défauts de page (quelques dizaines de microsecondes).
+ */
+#define OCTETS_PAR_PREPARATION (128 * 1024)
+
+/**
+ * @brief Une alvéole dont la liste chaînée dépasse ce nombre de noeuds est
+ * "arborisée" : on construit (avec `inserer_avl`) un AVL de ses valeurs,
+ * tenu à jour à chaque ajout et suppression. `appartient` n'y lit alors plus
+ * la liste : une recherche coûte O(log n) même si des clés mal réparties
+ * (ou choisies exprès) tombent toutes dans la même alvéole. \n
+ * Avec un bon hachage et un facteur de charge 1/2, une liste a moins d'une
+ * chance sur 10^8 de dépasser 8 noeuds : les arbres restent exceptionnels.
+ */
+#define SEUIL_ARBORISATION 8
+
+/**
+ * @brief Une alvéole arborisée qui redescend à ce nombre de noeuds perd son
+ * arbre (l'écart avec SEUIL_ARBORISATION évite de construire et détruire
+ * l'arbre à chaque ajout et suppression autour du seuil).
+ */
+#define SEUIL_DESARBORISATION 6
+
 /**
  * @brief On implémente notre type "Ensemble" avec une table de hachage.
  */
@@ -72,17 +200,70 @@ static inline size_t objet_vers_nombre(type_base x){
  * @brief Renvoie un ensemble sans élément à l'intérieur. \n
  * Le nombre d'alvéoles initial est fixé à 8.
  * La table sera allouée dynamiquement.
- * On choisira A comme un réel aléatoire entre 0.25 et 0.75. \n
+ * Les noeuds des listes chaînées viendront d'une réserve propre à l'ensemble.
+ * La fonction de hachage est `hachage_fibonacci` et la graine est aléatoire. \n
  * (Ne pas oubliez de changer la graine en fonction du temps!)
  * @returns un ensemble vide
  */
 Ensemble ensemble_vide();
 
+/**
+ * @brief Renvoie un ensemble vide qui utilisera une fonction de hachage donnée. \n
+ * Par exemple `ensemble_vide_avec_hachage(hachage_murmur3)`.
+ * **Complexité :** O(1)
+ * @param hachage une fonction de hachage (voir `hachage.h`).
+ * @returns un ensemble vide
+ */
+Ensemble ensemble_vide_avec_hachage(fonction_hachage hachage);
+
+/**
+ * @brief Renvoie un ensemble vide qui a déjà assez d'alvéoles pour **n** éléments :
+ * les **n** premiers ajouts ne redimensionnent pas la table
+ * (voir `ensemble_reserver`). \n
+ * **Complexité :** O(n)
+ * @param n le nombre d'éléments prévu.
+ * @returns un ensemble vide
+ */
+Ensemble ensemble_avec_capacite(size_t n);
+
+/**
+ * @brief Agrandit la table (si besoin) pour qu'elle puisse contenir **n** éléments
+ * sans redimensionnement, et interdit de la réduire en dessous de cette capacité :
+ * un ensemble qu'on vide puis qu'on remplit à nouveau garde ses alvéoles. \n
+ * `ensemble_reserver(e, 0)` lève cette interdiction (sans réduire la table tout de suite).
+ * **Complexité :** O(taille de e + nombre d'alvéoles nécessaires)
+ * @param e un ensemble,
+ * @param n le nombre d'éléments prévu.
+ */
+void ensemble_reserver(Ensemble e, size_t n);
+
+/**
+ * @brief Change les facteurs de charge (nombre d'éléments par alvéole) qui
+ * déclenchent les redimensionnements d'un ensemble : `ajouter` double le nombre
+ * d'alvéoles quand le facteur de charge atteint **charge_max**, et `supprimer` le
+ * divise par deux quand il passe sous **charge_min**. \n
+ * Pour éviter qu'une suite d'ajouts et de suppressions autour d'un seuil ne
+ * redimensionne la table à chaque appel (hystérésis), il faut
+ * **charge_max** >= 4 * **charge_min** : après un redimensionnement, le facteur
+ * de charge est à un facteur 2 des deux seuils, et il faut doubler ou diviser
+ * par deux la taille avant le redimensionnement suivant. \n
+ * Une valeur de **charge_max** supérieure à 1 économise des alvéoles au prix
+ * de listes chaînées plus longues. Si la table ne respecte plus les nouveaux
+ * seuils, elle est redimensionnée tout de suite. \n
+ * Déclenche une erreur si **charge_max** <= 0, **charge_min** < 0, ou
+ * **charge_max** < 4 * **charge_min**.
+ * **Complexité :** O(1) (O(taille de e) si la table est redimensionnée)
+ * @param e un ensemble,
+ * @param charge_min le facteur de charge minimal (1/8 par défaut ; 0 pour ne jamais réduire),
+ * @param charge_max le facteur de charge maximal (1/2 par défaut).
+ */
+void ensemble_facteurs_de_charge(Ensemble e, double charge_min, double charge_max);
+
 /**
  * @brief Donne le numéro de l'alvéole où est censée se trouver une certaine valeur. \n
- * La fonction en question est `k -> |_ A * (k & 4294967295) * nb_alveoles _| modulo nb_alveoles`. 
- * Au préalable, on utilisera la fonction `objet_vers_nombre` afin de transformer
- * notre paramètre en size_t.
+ * On transforme d'abord x en entier avec `objet_vers_nombre`, on le passe
+ * à la fonction de hachage de l'ensemble, puis on garde les log2(nb_alveoles)
+ * bits de poids fort du code obtenu (aucun calcul de modulo). \n
  * **Complexité :** O(1) (sous condition que la transformation en entier s'effectue en temps constant)
  * @param e un ensemble, 
  * @param x une valeur,
@@ -91,13 +272,127 @@ Ensemble ensemble_vide();
 size_t alveole(Ensemble e, type_base x);
 
 
+/**
+ * @brief Active ou désactive le redimensionnement progressif d'un ensemble. \n
+ * En mode progressif, un redimensionnement alloue la nouvelle table et garde
+ * l'ancienne à côté ; les alvéoles sont ensuite migrées petit à petit par les
+ * appels à `ajouter` et `supprimer`, et `appartient` regarde dans les deux tables.
+ * Aucun appel ne paie donc le déplacement de tous les éléments. \n
+ * Sur une grande table, les pages de la nouvelle table ne sont réellement
+ * allouées par le système qu'à leur première écriture, et ces écritures
+ * viennent des ajouts (dans des alvéoles au hasard) : chaque défaut de page
+ * (quelques microsecondes) tomberait sur un ajout différent, et environ 1 %
+ * des ajouts seraient lents, au lieu d'un seul gros redimensionnement. Pour
+ * l'éviter, une fois la moitié du chemin vers le prochain agrandissement
+ * parcourue, la nouvelle table est allouée à l'avance et ses pages sont
+ * touchées par paquets de OCTETS_PAR_PREPARATION octets : moins d'un ajout sur
+ * mille paie ces défauts, mais chacun en paie plusieurs d'un coup (le 99,99e
+ * centile des ajouts monte). En contrepartie aussi, la table suivante occupe
+ * déjà la mémoire pendant la seconde moitié du remplissage. \n
+ * Désactiver le mode termine la migration en cours.
+ * **Complexité :** O(1) (O(taille de l'ensemble) si on désactive pendant une migration)
+ * @param e un ensemble,
+ * @param progressif **true** pour activer le mode progressif, **false** pour le désactiver.
+ */
+void ensemble_redimensionnement_progressif(Ensemble e, bool progressif);
+
+/**
+ * @brief Choisit si les noeuds d'un ensemble (vide) viennent d'une réserve
+ * de noeuds ou sont alloués un par un avec malloc. \n
+ * Avec une réserve, les noeuds sont regroupés dans des blocs contigus et
+ * `liberer_ensemble` ne parcourt plus les listes chaînées. \n
+ * Déclenche une erreur si l'ensemble n'est pas vide.
+ * **Complexité :** O(1)
+ * @param e un ensemble vide,
+ * @param avec_reserve **true** pour utiliser une réserve, **false** pour utiliser malloc.
+ */
+void ensemble_utiliser_reserve(Ensemble e, bool avec_reserve);
+
+/**
+ * @brief Place (ou retire) un filtre de Bloom par blocs devant l'ensemble
+ * (voir `filtre_bloom.h`). \n
+ * Une recherche infructueuse ne lit alors en général qu'une ligne de cache
+ * du filtre, au lieu de l'alvéole et de sa liste chaînée. \n
+ * Le filtre est tenu à jour par les ajouts. Comme on ne peut pas y retirer
+ * une clé, il est reconstruit à partir de la table quand le nombre de
+ * suppressions depuis sa construction dépasse la moitié de la taille ; il est
+ * aussi reconstruit (prévu pour une fois et demie la taille) quand il a reçu plus de clés que prévu.
+ * **Complexité :** O(taille de l'ensemble)
+ * @param e un ensemble,
+ * @param bits_par_cle le nombre de bits du filtre par élément,
+ * ou 0 pour retirer le filtre.
+ */
+void ensemble_utiliser_filtre(Ensemble e, int bits_par_cle);
+
+/**
+ * @brief Choisit si un ensemble (vide) range ses doublons dans des noeuds séparés,
+ * ou s'il ne garde qu'un noeud par élément distinct avec son nombre d'occurrences
+ * (mode multi-ensemble). \n
+ * En mode multi-ensemble, les listes chaînées et la mémoire ne grandissent pas
+ * avec les doublons (même si quelques éléments sont très fréquents), et
+ * `supprimer` se contente de décrémenter le compteur. Le nombre d'occurrences
+ * d'un élément ne doit pas dépasser le maximum de `type_valeur`. \n
+ * Un multi-ensemble ne doit pas servir de dictionnaire. \n
+ * Déclenche une erreur si l'ensemble n'est pas vide.
+ * **Complexité :** O(1)
+ * @param e un ensemble vide,
+ * @param multiensemble **true** pour compter les occurrences, **false** pour
+ * ranger chaque occurrence dans son propre noeud.
+ */
+void ensemble_mode_multiensemble(Ensemble e, bool multiensemble);
+
+/**
+ * @brief Active (et remet à zéro) ou désactive les statistiques d'un ensemble. \n
+ * Quand elles sont activées, chaque recherche (`appartient`, `rechercher_noeud`...)
+ * compte ses sondages, et chaque redimensionnement est compté et chronométré.
+ * Le coût est de quelques additions par recherche et de deux lectures de
+ * l'horloge par redimensionnement : on peut les laisser en production. \n
+ * Les recherches par lot (`appartient_lot`, et donc les opérations ensemblistes,
+ * qui peuvent lire l'ensemble depuis plusieurs threads) ne sont pas comptées. \n
+ * En mode progressif, seule la partie d'un redimensionnement faite d'un coup
+ * (l'allocation de la nouvelle table) est chronométrée.
+ * **Complexité :** O(1)
+ * @param e un ensemble,
+ * @param activer **true** pour activer les statistiques (remises à zéro),
+ * **false** pour les désactiver.
+ */
+void ensemble_activer_statistiques(Ensemble e, bool activer);
+
+/**
+ * @brief Calcule l'histogramme des longueurs des listes chaînées des alvéoles. \n
+ * Pendant un redimensionnement progressif, la migration est d'abord terminée.
+ * **Complexité :** O(taille de e + nombre d'alvéoles)
+ * @param e un ensemble,
+ * @param histogramme un tableau de **nb_classes** entiers : `histogramme[k]` sera
+ * le nombre d'alvéoles qui contiennent k noeuds, sauf la dernière case qui compte
+ * les alvéoles d'au moins **nb_classes** - 1 noeuds,
+ * @param nb_classes la taille du tableau (au moins 1).
+ * @returns la longueur de la plus longue liste chaînée.
+ */
+size_t ensemble_histogramme_alveoles(Ensemble e, size_t* histogramme, size_t nb_classes);
+
+/**
+ * @brief Écrit un diagnostic de l'ensemble : taille, nombre d'alvéoles, facteur
+ * de charge, histogramme des longueurs des listes comparé à celui qu'on
+ * attendrait d'une fonction de hachage idéale (une loi de Poisson de paramètre
+ * le facteur de charge), et les compteurs si les statistiques sont activées. \n
+ * Une fonction de hachage qui répartit mal les clés se voit à un excès
+ * d'alvéoles vides et de longues listes par rapport à la loi de Poisson. \n
+ * **Complexité :** O(taille de e + nombre d'alvéoles)
+ * @param e un ensemble,
+ * @param sortie le fichier où écrire (par exemple stdout ou stderr).
+ */
+void ensemble_diagnostic(Ensemble e, FILE* sortie);
+
 /**
  * @brief Ajoute un élément dans la table de hachage. \n
  * On utilisera la fonction `alveole` pour savoir dans quelle case ajouter l'élément.
  * On s'autorisera à avoir des doublons. \n
- * Si jamais le nombre d'éléments devient supérieur à la moitié du nombre d'alvéoles,
+ * Si jamais le nombre d'éléments devient supérieur à la moitié du nombre d'alvéoles
+ * (ou à **charge_max** fois le nombre d'alvéoles, voir `ensemble_facteurs_de_charge`),
  * on réallouera un nouvelle table de hachage où on a doublé de nombre d'alvéoles.
- * **Complexité :** O(1) (en amorti)
+ * **Complexité :** O(1) (en amorti ; en mode progressif, aucun appel ne paie
+ * le déplacement de toute la table)
  * @param e un ensemble,
  * @param x une valeur qu'on veut ajouter dans e.
  */
@@ -114,13 +409,26 @@ void ajouter(Ensemble e, type_base x);
  */
 bool appartient(Ensemble e, type_base x);
 
+/**
+ * @brief Renvoie le nombre d'occurrences d'un élément dans un ensemble. \n
+ * **Complexité :** O(1) (en moyenne) en mode multi-ensemble ;
+ * O(longueur de la liste chaînée de x) sinon
+ * @param e un ensemble,
+ * @param x une valeur.
+ * @returns le nombre d'occurrences de x dans e (0 si x n'appartient pas à e).
+ */
+size_t multiplicite(Ensemble e, type_base x);
+
 
 
 /**
  * @brief Supprime une occurrence d'un élément dans la table de hachage. \n
- * Si jamais le nombre d'éléments devient inférieur au huitième du nombre d'alvéoles,
+ * Si jamais le nombre d'éléments devient inférieur au huitième du nombre d'alvéoles
+ * (ou à **charge_min** fois le nombre d'alvéoles),
  * on réallouera un nouvelle table de hachage où on a reduit de moitié le nombre d'alvéoles
- * (sauf si le nombre d'alvéoles devient inférieur à 8). \n
+ * (sauf si le nombre d'alvéoles devient inférieur à 8, ou à la capacité réservée). \n
+ * En mode multi-ensemble, on décrémente le nombre d'occurrences, et on ne
+ * retire le noeud que quand il tombe à zéro. \n
  * Déclenche une erreur si jamais la valeur n'est pas dans e. \n
  * **Complexité :** O(1) (en moyenne et en amorti)
  * @param e un ensemble,
@@ -129,10 +437,164 @@ bool appartient(Ensemble e, type_base x);
 void supprimer(Ensemble e, type_base x);
 
 
+/**
+ * @brief Le nombre de clés traitées ensemble par `appartient_lot` et
+ * la distance de préchargement de `ajouter_lot`.
+ */
+#define TAILLE_LOT 16
+
+/**
+ * @brief Détermine pour chaque clé d'un tableau si elle appartient à l'ensemble. \n
+ * Les clés sont traitées par groupes de TAILLE_LOT : pendant qu'on traite un
+ * groupe, on hache le suivant et on précharge ses alvéoles ; puis on parcourt
+ * les listes chaînées du groupe à tour de rôle, un noeud à la fois, en
+ * préchargeant le noeud suivant. Les défauts de cache des différentes clés se
+ * recouvrent donc au lieu de s'additionner (utile quand la table ne tient pas en cache).
+ * **Complexité :** O(n) (en moyenne)
+ * @param e un ensemble,
+ * @param cles un tableau de **n** valeurs,
+ * @param n le nombre de valeurs,
+ * @param resultats un tableau de **n** booléens : `resultats[i]` sera mis à
+ * **true** si `cles[i]` appartient à e, **false** sinon.
+ */
+void appartient_lot(Ensemble e, const type_base* cles, size_t n, bool* resultats);
+
+/**
+ * @brief Ajoute toutes les valeurs d'un tableau dans l'ensemble (doublons compris). \n
+ * La table est agrandie une seule fois, directement à sa taille finale,
+ * puis les alvéoles sont préchargées TAILLE_LOT clés à l'avance.
+ * **Complexité :** O(taille de e + n)
+ * @param e un ensemble,
+ * @param cles un tableau de **n** valeurs,
+ * @param n le nombre de valeurs.
+ */
+void ajouter_lot(Ensemble e, const type_base* cles, size_t n);
+
+
+/* Opérations ensemblistes.
+ * Les ensembles donnés ne sont pas modifiés (ils peuvent être égaux).
+ * Le résultat est un nouvel ensemble **sans doublon**, créé directement avec
+ * assez d'alvéoles : il n'est jamais redimensionné pendant qu'on le remplit
+ * (sauf une fois à la fin s'il est beaucoup plus petit que prévu).
+ * Il utilise la fonction de hachage et la graine de l'ensemble qu'on parcourt :
+ * chaque plage d'alvéoles de cet ensemble correspond alors à une plage d'alvéoles
+ * du résultat, ce qui permet de répartir le travail entre **nb_threads** threads
+ * sans verrou. Les appartenances à l'autre ensemble sont testées par lots
+ * (voir `appartient_lot`). */
+
+/**
+ * @brief Renvoie l'union de deux ensembles. \n
+ * On recopie le plus grand des deux (en parallèle par plages d'alvéoles),
+ * puis on ajoute les éléments du plus petit qui n'y sont pas.
+ * **Complexité :** O(taille de a + taille de b) (en moyenne)
+ * @param a un ensemble,
+ * @param b un ensemble,
+ * @param nb_threads le nombre de threads à utiliser (1 pour tout faire dans le thread appelant).
+ * @returns un nouvel ensemble contenant une fois chaque élément de a ou de b.
+ */
+Ensemble ensemble_union_parallele(Ensemble a, Ensemble b, int nb_threads);
+
+/**
+ * @brief Renvoie l'intersection de deux ensembles. \n
+ * On ne parcourt que le plus petit des deux.
+ * **Complexité :** O(min(taille de a, taille de b)) (en moyenne)
+ * @param a un ensemble,
+ * @param b un ensemble,
+ * @param nb_threads le nombre de threads à utiliser.
+ * @returns un nouvel ensemble contenant une fois chaque élément de a et de b.
+ */
+Ensemble ensemble_intersection_parallele(Ensemble a, Ensemble b, int nb_threads);
+
+/**
+ * @brief Renvoie la différence de deux ensembles. \n
+ * **Complexité :** O(taille de a) (en moyenne)
+ * @param a un ensemble,
+ * @param b un ensemble,
+ * @param nb_threads le nombre de threads à utiliser.
+ * @returns un nouvel ensemble contenant une fois chaque élément de a qui n'est pas dans b.
+ */
+Ensemble ensemble_difference_parallele(Ensemble a, Ensemble b, int nb_threads);
+
+/**
+ * @brief Comme `ensemble_union_parallele(a, b, 1)`.
+ * @param a un ensemble,
+ * @param b un ensemble.
+ * @returns l'union de a et b.
+ */
+Ensemble ensemble_union(Ensemble a, Ensemble b);
+
+/**
+ * @brief Comme `ensemble_intersection_parallele(a, b, 1)`.
+ * @param a un ensemble,
+ * @param b un ensemble.
+ * @returns l'intersection de a et b.
+ */
+Ensemble ensemble_intersection(Ensemble a, Ensemble b);
+
+/**
+ * @brief Comme `ensemble_difference_parallele(a, b, 1)`.
+ * @param a un ensemble,
+ * @param b un ensemble.
+ * @returns les éléments de a qui ne sont pas dans b.
+ */
+Ensemble ensemble_difference(Ensemble a, Ensemble b);
+
+/**
+ * @brief Détermine si tous les éléments d'un ensemble appartiennent à un autre. \n
+ * On s'arrête au premier élément absent. (À cause des doublons, on ne peut pas
+ * conclure en comparant seulement les tailles.)
+ * **Complexité :** O(taille de a) (en moyenne)
+ * @param a un ensemble,
+ * @param b un ensemble.
+ * @returns **true** si tout élément de a appartient à b, **false** sinon.
+ */
+bool est_sous_ensemble(Ensemble a, Ensemble b);
+
+/* Fonctions qui donnent accès aux noeuds de la table.
+ * Elles servent à construire d'autres structures sur la table de hachage
+ * (par exemple les dictionnaires de `dictionnaire.h`). */
+
+/**
+ * @brief Renvoie l'adresse du noeud contenant une valeur donnée. \n
+ * **Complexité :** O(1) (en moyenne)
+ * @param e un ensemble,
+ * @param x une valeur qu'on recherche dans e.
+ * @returns un noeud de valeur x si x appartient à e, NULL sinon.
+ */
+ListeChainee rechercher_noeud(Ensemble e, type_base x);
+
+/**
+ * @brief Renvoie le noeud contenant une valeur donnée, en l'ajoutant
+ * s'il n'existe pas (sans créer de doublon). \n
+ * On ne calcule l'alvéole et on ne parcourt la liste chaînée qu'une seule fois. \n
+ * Le noeud garde la même adresse jusqu'à ce qu'il soit supprimé
+ * (les redimensionnements déplacent les liens, pas les noeuds).
+ * **Complexité :** O(1) (en moyenne et en amorti)
+ * @param e un ensemble,
+ * @param x une valeur,
+ * @param existait adresse d'un booléen mis à **true** si x était déjà dans e,
+ * à **false** si le noeud vient d'être ajouté.
+ * @returns un noeud de valeur x.
+ */
+ListeChainee trouver_ou_ajouter_noeud(Ensemble e, type_base x, bool* existait);
+
+/**
+ * @brief Comme `supprimer`, mais ne déclenche pas d'erreur si la valeur
+ * n'est pas dans l'ensemble. \n
+ * **Complexité :** O(1) (en moyenne et en amorti)
+ * @param e un ensemble,
+ * @param x une valeur dont on veut supprimer une occurrence dans e.
+ * @returns **true** si une occurrence de x a été supprimée, **false** sinon.
+ */
+bool supprimer_si_present(Ensemble e, type_base x);
+
+
 /**
  * @brief Libère la mémoire associée à un ensemble. \n
- * On désallouera chaque liste chaînée, la table, ainsi que la structure elle-même.
- * **Complexité :** O(1) 
+ * On désallouera chaque liste chaînée (ou d'un coup les blocs de la réserve),
+ * la table, ainsi que la structure elle-même.
+ * **Complexité :** O(nombre de blocs de la réserve) avec une réserve,
+ * O(taille de l'ensemble) sinon
  * @param e un ensemble.
  */
 void liberer_ensemble(Ensemble e);
@@ -140,8 +602,9 @@ void liberer_ensemble(Ensemble e);
 
 /**
  * @brief Convertit un ensemble en une liste (voir TP précédent) \n
- * L'ensemble n'est pas modifié. \n
- * **Complexité :** O(taille de l'ensemble)
+ * L'ensemble n'est pas modifié. En mode multi-ensemble, chaque élément est
+ * répété autant de fois qu'il a d'occurrences. \n
+ * **Complexité :** O(taille de l'ensemble + taille de la liste)
  * @param e un ensemble.
  * @returns une liste contenant les mêmes éléments que **e** (l'ordre n'a 
  * pas d'importance).
@@ -149,9 +612,26 @@ void liberer_ensemble(Ensemble e);
 Liste ensemble_vers_liste(Ensemble e);
 
 /**
- * @brief Convertit une liste en un ensemble. \n
- * La liste n'est pas modifiée. \n
+ * @brief Convertit une liste en un ensemble, avec plusieurs threads. \n
+ * La liste n'est pas modifiée. La table est créée directement avec assez
+ * d'alvéoles (`ensemble_avec_capacite`) : elle n'est jamais redimensionnée. \n
+ * Pour une grande liste, les clés sont d'abord réparties (tri par base) selon
+ * les bits de poids fort de leur code de hachage, qui sont aussi ceux du numéro
+ * d'alvéole : chaque part correspond à une plage d'alvéoles assez petite pour
+ * tenir dans le cache. Chaque thread compte puis répartit une tranche de la
+ * liste, puis les threads remplissent les parts une à une, chacun avec sa
+ * réserve de noeuds, sans verrou (deux parts n'ont aucune alvéole en commun). \n
+ * La répartition utilise un tableau temporaire de la taille de la liste. \n
  * **Complexité :** O(taille de la liste)
+ * @param l une liste,
+ * @param nb_threads le nombre de threads à utiliser (réduit pour que chacun
+ * ait au moins 65536 clés).
+ * @returns un ensemble contenant les mêmes élements que **l**.
+ */
+Ensemble liste_vers_ensemble_parallele(Liste l, int nb_threads);
+
+/**
+ * @brief Comme `liste_vers_ensemble_parallele(l, 1)`.
  * @param l une liste.
  * @returns un ensemble contenant les mêmes élements que **l**.
  */
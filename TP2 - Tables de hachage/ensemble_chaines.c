@@ -0,0 +1,175 @@
+#include "ensemble_chaines.h"
+#include "hachage.h"
+#include "liste.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+// Bucket of a hash code (nb_alveoles is a power of two: keep the high bits)
+static inline size_t alveole_chaine(EnsembleChaines e, uint64_t h) {
+    return (size_t)(h >> (64 - __builtin_ctzll(e->nb_alveoles)));
+}
+
+// Allocates an array of empty buckets
+static int32_t* alveoles_vides(size_t nb_alveoles) {
+    int32_t* alveoles = malloc(nb_alveoles * sizeof(int32_t));
+    if (alveoles == NULL) {
+        fprintf(stderr, "Erreur: Échec de l'allocation de mémoire.\n");
+        exit(EXIT_FAILURE);
+    }
+    memset(alveoles, 0xFF, nb_alveoles * sizeof(int32_t)); // Every bucket is -1
+    return alveoles;
+}
+
+EnsembleChaines ensemble_chaines_vide() {
+    srand(time(NULL)); // Seed the random number generator
+
+    EnsembleChaines e = malloc(sizeof(struct TableChaines));
+    if (e == NULL) {
+        fprintf(stderr, "Erreur: Échec de l'allocation de mémoire.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    e->nb_alveoles = 8;
+    e->alveoles = alveoles_vides(e->nb_alveoles);
+    e->entrees = NULL;
+    e->nb_entrees = 0;
+    e->capacite_entrees = 0;
+    e->taille = 0;
+    e->graine = ((uint64_t)rand() << 32) ^ (uint64_t)rand();
+    e->arene = arene_vide();
+
+    return e;
+}
+
+// Doubles the number of buckets. The chains are rebuilt from the cached hash
+// codes: no string is read again.
+static void agrandir(EnsembleChaines e) {
+    free(e->alveoles);
+    e->nb_alveoles *= 2;
+    e->alveoles = alveoles_vides(e->nb_alveoles);
+
+    for (size_t id = 0; id < e->nb_entrees; id++) {
+        struct EntreeChaine* entree = &(e->entrees[id]);
+        if (entree->octets != NULL) {
+            size_t index = alveole_chaine(e, entree->hachage);
+            entree->suivant = e->alveoles[index];
+            e->alveoles[index] = (int32_t)id;
+        }
+    }
+}
+
+// Returns the address of the link (bucket or `suivant` field) that points to
+// the entry of the string, or to -1 at the end of its chain if it is absent
+static int32_t* rechercher_lien(EnsembleChaines e, const char* s, size_t longueur, uint64_t h) {
+    int32_t* lien = &(e->alveoles[alveole_chaine(e, h)]);
+
+    while (*lien != -1) {
+        const struct EntreeChaine* entree = &(e->entrees[*lien]);
+        // Le code de hachage et la longueur éliminent presque tous les candidats
+        if (entree->hachage == h && entree->longueur == longueur
+            && memcmp(entree->octets, s, longueur) == 0) {
+            return lien;
+        }
+        lien = &(e->entrees[*lien].suivant);
+    }
+    return lien;
+}
+
+int identifiant_chaine(EnsembleChaines e, const char* s, size_t longueur) {
+    uint64_t h = hachage_octets(s, longueur, e->graine);
+    return *rechercher_lien(e, s, longueur, h);
+}
+
+int interner(EnsembleChaines e, const char* s, size_t longueur) {
+    uint64_t h = hachage_octets(s, longueur, e->graine);
+    int32_t id = *rechercher_lien(e, s, longueur, h);
+    if (id != -1) {
+        return id;
+    }
+
+    if (e->nb_entrees >= INT32_MAX || longueur > UINT32_MAX) {
+        fprintf(stderr, "Erreur: Trop de chaînes ou chaîne trop longue.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (e->nb_entrees == e->capacite_entrees) {
+        e->capacite_entrees = e->capacite_entrees == 0 ? 8 : e->capacite_entrees * 2;
+        struct EntreeChaine* entrees = realloc(e->entrees, e->capacite_entrees * sizeof(struct EntreeChaine));
+        if (entrees == NULL) {
+            fprintf(stderr, "Erreur: Échec de l'allocation de mémoire.\n");
+            exit(EXIT_FAILURE);
+        }
+        e->entrees = entrees;
+    }
+
+    if (e->taille >= e->nb_alveoles / 2) {
+        agrandir(e);
+    }
+
+    // La nouvelle chaîne est placée en tête de la liste de son alvéole
+    id = (int32_t)e->nb_entrees;
+    struct EntreeChaine* entree = &(e->entrees[id]);
+    size_t index = alveole_chaine(e, h);
+    entree->hachage = h;
+    entree->octets = arene_copier(e->arene, s, longueur);
+    entree->longueur = (uint32_t)longueur;
+    entree->suivant = e->alveoles[index];
+    e->alveoles[index] = id;
+    e->nb_entrees++;
+    e->taille++;
+    return id;
+}
+
+const char* chaine_de_identifiant(EnsembleChaines e, int id, size_t* longueur) {
+    if (id < 0 || (size_t)id >= e->nb_entrees) {
+        fprintf(stderr, "Erreur: %d n'est pas un identifiant de chaîne.\n", id);
+        exit(EXIT_FAILURE);
+    }
+    if (longueur != NULL) {
+        *longueur = e->entrees[id].longueur;
+    }
+    return e->entrees[id].octets;
+}
+
+void ajouter_chaine(EnsembleChaines e, const char* s, size_t longueur) {
+    interner(e, s, longueur);
+}
+
+bool appartient_chaine(EnsembleChaines e, const char* s, size_t longueur) {
+    return identifiant_chaine(e, s, longueur) != -1;
+}
+
+void supprimer_chaine(EnsembleChaines e, const char* s, size_t longueur) {
+    uint64_t h = hachage_octets(s, longueur, e->graine);
+    int32_t* lien = rechercher_lien(e, s, longueur, h);
+
+    if (*lien == -1) {
+        fprintf(stderr, "Erreur: %.*s n'est pas présente dans l'ensemble.\n", (int)longueur, s);
+        exit(EXIT_FAILURE);
+    }
+
+    struct EntreeChaine* entree = &(e->entrees[*lien]);
+    *lien = entree->suivant;
+    entree->octets = NULL;
+    entree->suivant = -1;
+    e->taille--;
+}
+
+Liste identifiants_chaines(EnsembleChaines e) {
+    Liste l = liste_vide();
+    for (size_t id = 0; id < e->nb_entrees; id++) {
+        if (e->entrees[id].octets != NULL) {
+            ajouter_en_fin(l, (type_base)id);
+        }
+    }
+    return l;
+}
+
+void liberer_ensemble_chaines(EnsembleChaines e) {
+    liberer_arene(e->arene);
+    free(e->entrees);
+    free(e->alveoles);
+    free(e);
+}
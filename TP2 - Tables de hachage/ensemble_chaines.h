@@ -0,0 +1,160 @@
+/**
+ * @file ensemble_chaines.h
+ * @author
+ * */
+
+#ifndef __ENSEMBLE__CHAINES__H__
+#define __ENSEMBLE__CHAINES__H__
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "arene.h"
+#include "liste.h"
+
+
+/* Description de la structure */
+
+/**
+ * @brief Une chaîne de l'ensemble. Son identifiant est sa position dans le
+ * tableau des entrées.
+ */
+struct EntreeChaine{
+	uint64_t hachage; /**< Le code de hachage de la chaîne (calculé une seule fois). */
+	const char* octets; /**< L'adresse des octets de la chaîne, dans l'arène
+	* (suivis d'un octet nul), ou NULL si la chaîne a été supprimée. */
+	uint32_t longueur; /**< Le nombre d'octets de la chaîne. */
+	int32_t suivant; /**< L'identifiant de la chaîne suivante dans la même alvéole,
+	* ou -1 si c'est la dernière. */
+};
+
+/**
+ * @brief Structure codant une table de hachage de chaînes d'octets, qui donne à
+ * chaque chaîne un identifiant entier. \n
+ * Les chaînes sont stockées dans un tableau d'entrées ; chaque alvéole contient
+ * l'identifiant de la première chaîne de sa liste, et chaque entrée celui de la
+ * suivante (des listes chaînées par indices, sans allocation de noeud). \n
+ * Chaque entrée garde la longueur et le code de hachage (`hachage_octets`) de sa
+ * chaîne : une recherche compare d'abord les codes de hachage et les longueurs,
+ * et n'appelle memcmp que si les deux sont égaux ; un agrandissement ne relit
+ * aucune chaîne. Les octets des chaînes sont copiés dans une arène (voir `arene.h`). \n
+ * Contrairement à `Ensemble`, il n'y a pas de doublon. Le nombre d'alvéoles est
+ * une puissance de deux, au moins le double du nombre de chaînes. Il ne diminue
+ * jamais : les identifiants ne changent pas, et une chaîne supprimée garde son
+ * identifiant (il n'est pas réutilisé) et ses octets dans l'arène.
+ */
+struct TableChaines{
+
+	int32_t* alveoles; /**< Le tableau des alvéoles (-1 pour une alvéole vide). */
+
+	size_t nb_alveoles; /**< La taille du tableau **alveoles** (une puissance de deux). */
+
+	struct EntreeChaine* entrees; /**< Le tableau des entrées, indicé par les identifiants. */
+
+	size_t nb_entrees; /**< Le nombre d'entrées (chaînes supprimées comprises). */
+
+	size_t capacite_entrees; /**< La taille du tableau **entrees**. */
+
+	size_t taille; /**< Le nombre de chaînes dans l'ensemble. */
+
+	uint64_t graine; /**< La graine aléatoire passée à `hachage_octets`. */
+
+	Arene arene; /**< L'arène qui contient les octets des chaînes. */
+};
+
+/**
+ * @brief Le type "EnsembleChaines" est un ensemble de chaînes d'octets.
+ */
+typedef struct TableChaines* EnsembleChaines;
+
+
+/* Prototype des fonctions */
+
+/**
+ * @brief Renvoie un ensemble de chaînes vide (8 alvéoles). \n
+ * **Complexité :** O(1)
+ * @returns un ensemble vide.
+ */
+EnsembleChaines ensemble_chaines_vide();
+
+/**
+ * @brief Renvoie l'identifiant d'une chaîne, en l'ajoutant si elle n'est pas
+ * dans l'ensemble ("internement"). \n
+ * Les identifiants sont attribués dans l'ordre 0, 1, 2... : on peut donc les
+ * ranger dans les structures d'entiers (`Ensemble`, `Liste`, tableaux...). \n
+ * **Complexité :** O(longueur) (en moyenne et en amorti)
+ * @param e un ensemble de chaînes,
+ * @param s l'adresse des octets de la chaîne (pas forcément terminée par un octet nul),
+ * @param longueur le nombre d'octets de la chaîne.
+ * @returns l'identifiant de la chaîne.
+ */
+int interner(EnsembleChaines e, const char* s, size_t longueur);
+
+/**
+ * @brief Renvoie l'identifiant d'une chaîne sans l'ajouter. \n
+ * **Complexité :** O(longueur) (en moyenne)
+ * @param e un ensemble de chaînes,
+ * @param s l'adresse des octets de la chaîne,
+ * @param longueur le nombre d'octets de la chaîne.
+ * @returns l'identifiant de la chaîne, ou -1 si elle n'est pas dans e.
+ */
+int identifiant_chaine(EnsembleChaines e, const char* s, size_t longueur);
+
+/**
+ * @brief Renvoie la chaîne qui a un identifiant donné. \n
+ * **Complexité :** O(1)
+ * @param e un ensemble de chaînes,
+ * @param id un identifiant renvoyé par `interner`,
+ * @param longueur adresse où écrire la longueur de la chaîne (ou NULL).
+ * @returns l'adresse des octets de la chaîne (suivis d'un octet nul), valable
+ * jusqu'à la libération de e ; NULL si la chaîne a été supprimée.
+ */
+const char* chaine_de_identifiant(EnsembleChaines e, int id, size_t* longueur);
+
+/**
+ * @brief Ajoute une chaîne dans l'ensemble (rien ne change si elle y est déjà). \n
+ * **Complexité :** O(longueur) (en moyenne et en amorti)
+ * @param e un ensemble de chaînes,
+ * @param s l'adresse des octets de la chaîne,
+ * @param longueur le nombre d'octets de la chaîne.
+ */
+void ajouter_chaine(EnsembleChaines e, const char* s, size_t longueur);
+
+/**
+ * @brief Détermine si une chaîne appartient à un ensemble. \n
+ * **Complexité :** O(longueur) (en moyenne)
+ * @param e un ensemble de chaînes,
+ * @param s l'adresse des octets de la chaîne,
+ * @param longueur le nombre d'octets de la chaîne.
+ * @returns **true** si la chaîne appartient à e, **false** sinon.
+ */
+bool appartient_chaine(EnsembleChaines e, const char* s, size_t longueur);
+
+/**
+ * @brief Supprime une chaîne de l'ensemble. Son identifiant n'est pas réutilisé,
+ * et ses octets restent dans l'arène. \n
+ * Déclenche une erreur si jamais la chaîne n'est pas dans e. \n
+ * **Complexité :** O(longueur) (en moyenne)
+ * @param e un ensemble de chaînes,
+ * @param s l'adresse des octets de la chaîne,
+ * @param longueur le nombre d'octets de la chaîne.
+ */
+void supprimer_chaine(EnsembleChaines e, const char* s, size_t longueur);
+
+/**
+ * @brief Renvoie la liste des identifiants des chaînes de l'ensemble
+ * (dans l'ordre où elles ont été ajoutées). \n
+ * **Complexité :** O(nombre d'entrées)
+ * @param e un ensemble de chaînes.
+ * @returns une liste d'identifiants.
+ */
+Liste identifiants_chaines(EnsembleChaines e);
+
+/**
+ * @brief Libère la mémoire associée à un ensemble de chaînes (arène comprise). \n
+ * **Complexité :** O(nombre de blocs de l'arène)
+ * @param e un ensemble de chaînes.
+ */
+void liberer_ensemble_chaines(EnsembleChaines e);
+
+#endif
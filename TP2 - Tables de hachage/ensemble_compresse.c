@@ -0,0 +1,836 @@
+#include "ensemble_compresse.h"
+#include "ensemble.h"
+#include "liste.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+// An element seen as an unsigned 32-bit integer, in the same order as type_base
+static inline uint32_t vers_non_signe(type_base x) {
+    return (uint32_t)x ^ 0x80000000u;
+}
+
+static inline type_base vers_type_base(uint32_t u) {
+    return (type_base)(u ^ 0x80000000u);
+}
+
+// With 64-bit keys (CLES_64_BITS), only those that fit in 32 bits can be stored
+static inline bool tient_sur_32_bits(type_base x) {
+    return (type_base)(int32_t)x == x;
+}
+
+static void* allouer(size_t taille) {
+    void* p = malloc(taille);
+    if (p == NULL) {
+        fprintf(stderr, "Erreur: Échec de l'allocation de mémoire.\n");
+        exit(EXIT_FAILURE);
+    }
+    return p;
+}
+
+static void* reallouer(void* p, size_t taille) {
+    p = realloc(p, taille);
+    if (p == NULL) {
+        fprintf(stderr, "Erreur: Échec de l'allocation de mémoire.\n");
+        exit(EXIT_FAILURE);
+    }
+    return p;
+}
+
+
+/* Recherches dans un conteneur */
+
+// Index of the first value >= v in a sorted array (n if there is none)
+static uint32_t premier_superieur_ou_egal(const uint16_t* t, uint32_t n, uint16_t v) {
+    uint32_t debut = 0, fin = n;
+    while (debut < fin) {
+        uint32_t milieu = (debut + fin) / 2;
+        if (t[milieu] < v) {
+            debut = milieu + 1;
+        } else {
+            fin = milieu;
+        }
+    }
+    return debut;
+}
+
+// Index of the last run starting at or before v (-1 if there is none)
+static int64_t derniere_plage_avant(const struct Plage* p, uint32_t n, uint16_t v) {
+    uint32_t debut = 0, fin = n;
+    while (debut < fin) {
+        uint32_t milieu = (debut + fin) / 2;
+        if (p[milieu].debut <= v) {
+            debut = milieu + 1;
+        } else {
+            fin = milieu;
+        }
+    }
+    return (int64_t)debut - 1;
+}
+
+static bool conteneur_contient(const struct Conteneur* c, uint16_t v) {
+    switch (c->type) {
+    case CONTENEUR_TABLEAU: {
+        const uint16_t* t = c->donnees;
+        uint32_t i = premier_superieur_ou_egal(t, c->nb, v);
+        return i < c->nb && t[i] == v;
+    }
+    case CONTENEUR_BITMAP: {
+        const uint64_t* bits = c->donnees;
+        return (bits[v >> 6] >> (v & 63)) & 1;
+    }
+    default: {
+        const struct Plage* p = c->donnees;
+        int64_t i = derniere_plage_avant(p, c->nb, v);
+        return i >= 0 && (uint32_t)(v - p[i].debut) <= p[i].longueur;
+    }
+    }
+}
+
+
+/* Conversions entre représentations */
+
+// Sets the bits debut..fin (included) of a bitmap
+static void mettre_bits(uint64_t* bits, uint32_t debut, uint32_t fin) {
+    uint32_t premier_mot = debut >> 6, dernier_mot = fin >> 6;
+    uint64_t masque_debut = ~0ULL << (debut & 63);
+    uint64_t masque_fin = ~0ULL >> (63 - (fin & 63));
+
+    if (premier_mot == dernier_mot) {
+        bits[premier_mot] |= masque_debut & masque_fin;
+        return;
+    }
+    bits[premier_mot] |= masque_debut;
+    for (uint32_t i = premier_mot + 1; i < dernier_mot; i++) {
+        bits[i] = ~0ULL;
+    }
+    bits[dernier_mot] |= masque_fin;
+}
+
+// Adds the values of a container to a bitmap ("or")
+static void ajouter_bits(const struct Conteneur* c, uint64_t* bits) {
+    switch (c->type) {
+    case CONTENEUR_TABLEAU: {
+        const uint16_t* t = c->donnees;
+        for (uint32_t i = 0; i < c->nb; i++) {
+            bits[t[i] >> 6] |= 1ULL << (t[i] & 63);
+        }
+        break;
+    }
+    case CONTENEUR_BITMAP: {
+        const uint64_t* b = c->donnees;
+        for (int i = 0; i < NB_MOTS_BITMAP; i++) {
+            bits[i] |= b[i];
+        }
+        break;
+    }
+    default: {
+        const struct Plage* p = c->donnees;
+        for (uint32_t i = 0; i < c->nb; i++) {
+            mettre_bits(bits, p[i].debut, (uint32_t)p[i].debut + p[i].longueur);
+        }
+    }
+    }
+}
+
+// Returns a new bitmap holding the values of a container
+static uint64_t* vers_bits(const struct Conteneur* c) {
+    uint64_t* bits = allouer(NB_MOTS_BITMAP * sizeof(uint64_t));
+    memset(bits, 0, NB_MOTS_BITMAP * sizeof(uint64_t));
+    ajouter_bits(c, bits);
+    return bits;
+}
+
+static uint32_t cardinal_bits(const uint64_t* bits) {
+    uint32_t cardinal = 0;
+    for (int i = 0; i < NB_MOTS_BITMAP; i++) {
+        cardinal += (uint32_t)__builtin_popcountll(bits[i]);
+    }
+    return cardinal;
+}
+
+// Number of runs of consecutive ones in a bitmap: a run starts at every set
+// bit whose previous bit is not set
+static uint32_t nb_plages_bits(const uint64_t* bits) {
+    uint32_t nb = 0;
+    uint64_t retenue = 0; // Le dernier bit du mot précédent
+    for (int i = 0; i < NB_MOTS_BITMAP; i++) {
+        nb += (uint32_t)__builtin_popcountll(bits[i] & ~((bits[i] << 1) | retenue));
+        retenue = bits[i] >> 63;
+    }
+    return nb;
+}
+
+// Position of the first bit >= v equal to `valeur` (65536 if there is none)
+static uint32_t prochain_bit(const uint64_t* bits, uint32_t v, bool valeur) {
+    while (v < 65536) {
+        uint64_t mot = valeur ? bits[v >> 6] : ~bits[v >> 6];
+        mot &= ~0ULL << (v & 63);
+        if (mot != 0) {
+            return (v & ~63u) + (uint32_t)__builtin_ctzll(mot);
+        }
+        v = (v & ~63u) + 64;
+    }
+    return 65536;
+}
+
+// Replaces the data of a container by a given bitmap (which it takes), in the
+// representation chosen by its cardinal: array up to CARDINAL_MAX_TABLEAU, bitmap above
+static void remplacer_par_bits(struct Conteneur* c, uint64_t* bits) {
+    if (c->donnees != bits) {
+        free(c->donnees);
+    }
+    c->cardinal = cardinal_bits(bits);
+
+    if (c->cardinal > CARDINAL_MAX_TABLEAU) {
+        c->type = CONTENEUR_BITMAP;
+        c->nb = 0;
+        c->capacite = 0;
+        c->donnees = bits;
+        return;
+    }
+
+    uint16_t* t = allouer((c->cardinal > 0 ? c->cardinal : 1) * sizeof(uint16_t));
+    uint32_t n = 0;
+    for (int i = 0; i < NB_MOTS_BITMAP; i++) {
+        for (uint64_t mot = bits[i]; mot != 0; mot &= mot - 1) {
+            t[n] = (uint16_t)(i * 64 + __builtin_ctzll(mot));
+            n++;
+        }
+    }
+    free(bits);
+    c->type = CONTENEUR_TABLEAU;
+    c->nb = n;
+    c->capacite = n > 0 ? n : 1;
+    c->donnees = t;
+}
+
+// Replaces the data of a container by the runs of a given bitmap (which it frees)
+static void remplacer_par_plages(struct Conteneur* c, uint64_t* bits) {
+    uint32_t nb = nb_plages_bits(bits);
+    struct Plage* p = allouer((nb > 0 ? nb : 1) * sizeof(struct Plage));
+
+    uint32_t n = 0;
+    for (uint32_t v = prochain_bit(bits, 0, true); v < 65536; v = prochain_bit(bits, v, true)) {
+        uint32_t fin = prochain_bit(bits, v, false);
+        p[n].debut = (uint16_t)v;
+        p[n].longueur = (uint16_t)(fin - 1 - v);
+        n++;
+        v = fin;
+    }
+
+    c->cardinal = cardinal_bits(bits);
+    if (c->donnees != bits) {
+        free(c->donnees);
+    }
+    free(bits);
+    c->type = CONTENEUR_PLAGES;
+    c->nb = n;
+    c->capacite = n > 0 ? n : 1;
+    c->donnees = p;
+}
+
+// Number of bytes of the best representation other than runs
+static size_t taille_sans_plages(uint32_t cardinal) {
+    return cardinal <= CARDINAL_MAX_TABLEAU ? 2 * (size_t)cardinal : NB_MOTS_BITMAP * sizeof(uint64_t);
+}
+
+// Turns a run container back into an array or a bitmap if the runs take more room
+static void verifier_plages(struct Conteneur* c) {
+    if (c->type == CONTENEUR_PLAGES && c->nb * sizeof(struct Plage) > taille_sans_plages(c->cardinal)) {
+        remplacer_par_bits(c, vers_bits(c));
+    }
+}
+
+
+/* Ajout et retrait d'une valeur dans un conteneur */
+
+// Makes room for n values or runs of `taille` bytes each
+static void reserver(struct Conteneur* c, uint32_t n, size_t taille) {
+    if (n > c->capacite) {
+        uint32_t capacite = c->capacite * 2 > n ? c->capacite * 2 : n;
+        c->donnees = reallouer(c->donnees, capacite * taille);
+        c->capacite = capacite;
+    }
+}
+
+// Inserts a run at position i
+static void inserer_plage(struct Conteneur* c, uint32_t i, uint16_t debut, uint16_t longueur) {
+    reserver(c, c->nb + 1, sizeof(struct Plage));
+    struct Plage* p = c->donnees;
+    memmove(p + i + 1, p + i, (c->nb - i) * sizeof(struct Plage));
+    p[i].debut = debut;
+    p[i].longueur = longueur;
+    c->nb++;
+}
+
+static void retirer_plage(struct Conteneur* c, uint32_t i) {
+    struct Plage* p = c->donnees;
+    memmove(p + i, p + i + 1, (c->nb - i - 1) * sizeof(struct Plage));
+    c->nb--;
+}
+
+// Returns true if v was not in the container
+static bool conteneur_ajouter(struct Conteneur* c, uint16_t v) {
+    switch (c->type) {
+    case CONTENEUR_TABLEAU: {
+        uint16_t* t = c->donnees;
+        uint32_t i = premier_superieur_ou_egal(t, c->nb, v);
+        if (i < c->nb && t[i] == v) {
+            return false;
+        }
+        if (c->cardinal == CARDINAL_MAX_TABLEAU) {
+            // Le tableau devient un bitmap
+            uint64_t* bits = vers_bits(c);
+            free(c->donnees);
+            c->type = CONTENEUR_BITMAP;
+            c->nb = 0;
+            c->capacite = 0;
+            c->donnees = bits;
+            bits[v >> 6] |= 1ULL << (v & 63);
+            break;
+        }
+        reserver(c, c->nb + 1, sizeof(uint16_t));
+        t = c->donnees;
+        memmove(t + i + 1, t + i, (c->nb - i) * sizeof(uint16_t));
+        t[i] = v;
+        c->nb++;
+        break;
+    }
+    case CONTENEUR_BITMAP: {
+        uint64_t* bits = c->donnees;
+        if ((bits[v >> 6] >> (v & 63)) & 1) {
+            return false;
+        }
+        bits[v >> 6] |= 1ULL << (v & 63);
+        break;
+    }
+    default: {
+        struct Plage* p = c->donnees;
+        int64_t i = derniere_plage_avant(p, c->nb, v);
+        if (i >= 0 && (uint32_t)(v - p[i].debut) <= p[i].longueur) {
+            return false;
+        }
+        bool prolonge_avant = i >= 0 && (uint32_t)p[i].debut + p[i].longueur + 1 == v;
+        bool prolonge_apres = (uint32_t)(i + 1) < c->nb && p[i + 1].debut == (uint32_t)v + 1;
+
+        if (prolonge_avant && prolonge_apres) {
+            // v relie deux plages
+            p[i].longueur = (uint16_t)(p[i].longueur + p[i + 1].longueur + 2);
+            retirer_plage(c, (uint32_t)(i + 1));
+        } else if (prolonge_avant) {
+            p[i].longueur++;
+        } else if (prolonge_apres) {
+            p[i + 1].debut = v;
+            p[i + 1].longueur++;
+        } else {
+            inserer_plage(c, (uint32_t)(i + 1), v, 0);
+        }
+        c->cardinal++;
+        verifier_plages(c);
+        return true;
+    }
+    }
+    c->cardinal++;
+    return true;
+}
+
+// Returns true if v was in the container
+static bool conteneur_retirer(struct Conteneur* c, uint16_t v) {
+    switch (c->type) {
+    case CONTENEUR_TABLEAU: {
+        uint16_t* t = c->donnees;
+        uint32_t i = premier_superieur_ou_egal(t, c->nb, v);
+        if (i == c->nb || t[i] != v) {
+            return false;
+        }
+        memmove(t + i, t + i + 1, (c->nb - i - 1) * sizeof(uint16_t));
+        c->nb--;
+        c->cardinal--;
+        return true;
+    }
+    case CONTENEUR_BITMAP: {
+        uint64_t* bits = c->donnees;
+        if (!((bits[v >> 6] >> (v & 63)) & 1)) {
+            return false;
+        }
+        bits[v >> 6] &= ~(1ULL << (v & 63));
+        c->cardinal--;
+        if (c->cardinal == CARDINAL_MAX_TABLEAU) {
+            remplacer_par_bits(c, bits); // Le bitmap redevient un tableau
+        }
+        return true;
+    }
+    default: {
+        struct Plage* p = c->donnees;
+        int64_t i = derniere_plage_avant(p, c->nb, v);
+        if (i < 0 || (uint32_t)(v - p[i].debut) > p[i].longueur) {
+            return false;
+        }
+        uint32_t fin = (uint32_t)p[i].debut + p[i].longueur;
+
+        if (p[i].longueur == 0) {
+            retirer_plage(c, (uint32_t)i);
+        } else if (v == p[i].debut) {
+            p[i].debut++;
+            p[i].longueur--;
+        } else if (v == fin) {
+            p[i].longueur--;
+        } else {
+            // v coupe la plage en deux
+            p[i].longueur = (uint16_t)(v - 1 - p[i].debut);
+            inserer_plage(c, (uint32_t)(i + 1), (uint16_t)(v + 1), (uint16_t)(fin - v - 1));
+        }
+        c->cardinal--;
+        verifier_plages(c);
+        return true;
+    }
+    }
+}
+
+static struct Conteneur conteneur_copie(const struct Conteneur* c) {
+    struct Conteneur copie = *c;
+    size_t taille;
+    switch (c->type) {
+    case CONTENEUR_TABLEAU:
+        taille = c->nb * sizeof(uint16_t);
+        copie.capacite = c->nb;
+        break;
+    case CONTENEUR_BITMAP:
+        taille = NB_MOTS_BITMAP * sizeof(uint64_t);
+        break;
+    default:
+        taille = c->nb * sizeof(struct Plage);
+        copie.capacite = c->nb;
+    }
+    copie.donnees = allouer(taille > 0 ? taille : 1);
+    memcpy(copie.donnees, c->donnees, taille);
+    return copie;
+}
+
+
+/* Fonctions de l'ensemble */
+
+EnsembleCompresse ensemble_compresse_vide() {
+    EnsembleCompresse e = allouer(sizeof(struct TableConteneurs));
+    e->conteneurs = NULL;
+    e->nb_conteneurs = 0;
+    e->capacite = 0;
+    e->cardinal = 0;
+    return e;
+}
+
+// Index of the first container whose key is >= cle (binary search)
+static size_t position_conteneur(EnsembleCompresse e, uint16_t cle) {
+    size_t debut = 0, fin = e->nb_conteneurs;
+    while (debut < fin) {
+        size_t milieu = (debut + fin) / 2;
+        if (e->conteneurs[milieu].cle < cle) {
+            debut = milieu + 1;
+        } else {
+            fin = milieu;
+        }
+    }
+    return debut;
+}
+
+// Appends a container (the keys must be added in increasing order)
+static void ajouter_conteneur_en_fin(EnsembleCompresse e, struct Conteneur c) {
+    if (e->nb_conteneurs == e->capacite) {
+        e->capacite = e->capacite == 0 ? 4 : e->capacite * 2;
+        e->conteneurs = reallouer(e->conteneurs, e->capacite * sizeof(struct Conteneur));
+    }
+    e->conteneurs[e->nb_conteneurs] = c;
+    e->nb_conteneurs++;
+    e->cardinal += c.cardinal;
+}
+
+void ajouter_compresse(EnsembleCompresse e, type_base x) {
+    if (!tient_sur_32_bits(x)) {
+        fprintf(stderr, "Erreur: " FORMAT_BASE " ne tient pas sur 32 bits.\n", x);
+        exit(EXIT_FAILURE);
+    }
+    uint32_t u = vers_non_signe(x);
+    uint16_t cle = (uint16_t)(u >> 16);
+    size_t i = position_conteneur(e, cle);
+
+    if (i == e->nb_conteneurs || e->conteneurs[i].cle != cle) {
+        // Nouveau conteneur (un tableau d'une valeur), inséré à sa place
+        struct Conteneur c = {cle, CONTENEUR_TABLEAU, 0, 0, 1, allouer(sizeof(uint16_t))};
+        ajouter_conteneur_en_fin(e, c);
+        memmove(e->conteneurs + i + 1, e->conteneurs + i, (e->nb_conteneurs - 1 - i) * sizeof(struct Conteneur));
+        e->conteneurs[i] = c;
+    }
+
+    if (conteneur_ajouter(&(e->conteneurs[i]), (uint16_t)u)) {
+        e->cardinal++;
+    }
+}
+
+bool appartient_compresse(EnsembleCompresse e, type_base x) {
+    uint32_t u = vers_non_signe(x);
+    uint16_t cle = (uint16_t)(u >> 16);
+    size_t i = position_conteneur(e, cle);
+    return tient_sur_32_bits(x) && i < e->nb_conteneurs && e->conteneurs[i].cle == cle
+           && conteneur_contient(&(e->conteneurs[i]), (uint16_t)u);
+}
+
+void supprimer_compresse(EnsembleCompresse e, type_base x) {
+    uint32_t u = vers_non_signe(x);
+    uint16_t cle = (uint16_t)(u >> 16);
+    size_t i = position_conteneur(e, cle);
+
+    if (!tient_sur_32_bits(x) || i == e->nb_conteneurs || e->conteneurs[i].cle != cle
+        || !conteneur_retirer(&(e->conteneurs[i]), (uint16_t)u)) {
+        fprintf(stderr, "Erreur: " FORMAT_BASE " n'est pas présent dans l'ensemble.\n", x);
+        exit(EXIT_FAILURE);
+    }
+    e->cardinal--;
+
+    // Retirer le conteneur s'il est vide
+    if (e->conteneurs[i].cardinal == 0) {
+        free(e->conteneurs[i].donnees);
+        memmove(e->conteneurs + i, e->conteneurs + i + 1, (e->nb_conteneurs - i - 1) * sizeof(struct Conteneur));
+        e->nb_conteneurs--;
+    }
+}
+
+size_t cardinal_compresse(EnsembleCompresse e) {
+    return e->cardinal;
+}
+
+void optimiser_compresse(EnsembleCompresse e) {
+    for (size_t i = 0; i < e->nb_conteneurs; i++) {
+        struct Conteneur* c = &(e->conteneurs[i]);
+        uint64_t* bits = vers_bits(c);
+        if (nb_plages_bits(bits) * sizeof(struct Plage) < taille_sans_plages(c->cardinal)) {
+            remplacer_par_plages(c, bits);
+        } else {
+            remplacer_par_bits(c, bits);
+        }
+    }
+}
+
+
+/* Union et intersection */
+
+// Appends a run to a run container, merging it with the last run if they touch
+static void ajouter_plage_en_fin(struct Conteneur* c, uint32_t debut, uint32_t fin) {
+    struct Plage* p = c->donnees;
+    if (c->nb > 0) {
+        uint32_t fin_derniere = (uint32_t)p[c->nb - 1].debut + p[c->nb - 1].longueur;
+        if (debut <= fin_derniere + 1) {
+            if (fin > fin_derniere) {
+                c->cardinal += fin - fin_derniere;
+                p[c->nb - 1].longueur = (uint16_t)(fin - p[c->nb - 1].debut);
+            }
+            return;
+        }
+    }
+    inserer_plage(c, c->nb, (uint16_t)debut, (uint16_t)(fin - debut));
+    c->cardinal += fin - debut + 1;
+}
+
+static struct Conteneur plages_vides(uint16_t cle, uint32_t capacite) {
+    struct Conteneur c = {cle, CONTENEUR_PLAGES, 0, 0, capacite > 0 ? capacite : 1, NULL};
+    c.donnees = allouer(c.capacite * sizeof(struct Plage));
+    return c;
+}
+
+static struct Conteneur union_conteneurs(const struct Conteneur* c1, const struct Conteneur* c2) {
+
+    // Deux tableaux triés qui tiennent dans un tableau : fusion
+    if (c1->type == CONTENEUR_TABLEAU && c2->type == CONTENEUR_TABLEAU
+        && c1->cardinal + c2->cardinal <= CARDINAL_MAX_TABLEAU) {
+        const uint16_t *t1 = c1->donnees, *t2 = c2->donnees;
+        struct Conteneur c = {c1->cle, CONTENEUR_TABLEAU, 0, 0, c1->nb + c2->nb, NULL};
+        uint16_t* t = c.donnees = allouer(c.capacite * sizeof(uint16_t));
+        uint32_t i = 0, j = 0;
+        while (i < c1->nb || j < c2->nb) {
+            if (j == c2->nb || (i < c1->nb && t1[i] < t2[j])) {
+                t[c.nb++] = t1[i++];
+            } else if (i == c1->nb || t2[j] < t1[i]) {
+                t[c.nb++] = t2[j++];
+            } else {
+                t[c.nb++] = t1[i++];
+                j++;
+            }
+        }
+        c.cardinal = c.nb;
+        return c;
+    }
+
+    // Deux listes de plages : fusion par début croissant
+    if (c1->type == CONTENEUR_PLAGES && c2->type == CONTENEUR_PLAGES) {
+        const struct Plage *p1 = c1->donnees, *p2 = c2->donnees;
+        struct Conteneur c = plages_vides(c1->cle, c1->nb + c2->nb);
+        uint32_t i = 0, j = 0;
+        while (i < c1->nb || j < c2->nb) {
+            const struct Plage* p = (j == c2->nb || (i < c1->nb && p1[i].debut <= p2[j].debut)) ? &p1[i++] : &p2[j++];
+            ajouter_plage_en_fin(&c, p->debut, (uint32_t)p->debut + p->longueur);
+        }
+        verifier_plages(&c);
+        return c;
+    }
+
+    // Sinon : "ou" de deux bitmaps
+    struct Conteneur c = {c1->cle, CONTENEUR_BITMAP, 0, 0, 0, NULL};
+    uint64_t* bits = vers_bits(c1);
+    ajouter_bits(c2, bits);
+    remplacer_par_bits(&c, bits);
+    return c;
+}
+
+static struct Conteneur intersection_conteneurs(const struct Conteneur* c1, const struct Conteneur* c2) {
+
+    // Un tableau : on garde ses valeurs présentes dans l'autre conteneur
+    if (c1->type == CONTENEUR_TABLEAU || c2->type == CONTENEUR_TABLEAU) {
+        if (c2->type == CONTENEUR_TABLEAU && (c1->type != CONTENEUR_TABLEAU || c2->nb < c1->nb)) {
+            const struct Conteneur* echange = c1;
+            c1 = c2;
+            c2 = echange;
+        }
+        const uint16_t* t1 = c1->donnees;
+        struct Conteneur c = {c1->cle, CONTENEUR_TABLEAU, 0, 0, c1->nb > 0 ? c1->nb : 1, NULL};
+        uint16_t* t = c.donnees = allouer(c.capacite * sizeof(uint16_t));
+        for (uint32_t i = 0; i < c1->nb; i++) {
+            if (conteneur_contient(c2, t1[i])) {
+                t[c.nb++] = t1[i];
+            }
+        }
+        c.cardinal = c.nb;
+        return c;
+    }
+
+    // Deux listes de plages : intersection des intervalles
+    if (c1->type == CONTENEUR_PLAGES && c2->type == CONTENEUR_PLAGES) {
+        const struct Plage *p1 = c1->donnees, *p2 = c2->donnees;
+        struct Conteneur c = plages_vides(c1->cle, c1->nb + c2->nb);
+        uint32_t i = 0, j = 0;
+        while (i < c1->nb && j < c2->nb) {
+            uint32_t fin1 = (uint32_t)p1[i].debut + p1[i].longueur;
+            uint32_t fin2 = (uint32_t)p2[j].debut + p2[j].longueur;
+            uint32_t debut = p1[i].debut > p2[j].debut ? p1[i].debut : p2[j].debut;
+            uint32_t fin = fin1 < fin2 ? fin1 : fin2;
+            if (debut <= fin) {
+                ajouter_plage_en_fin(&c, debut, fin);
+            }
+            if (fin1 < fin2) {
+                i++;
+            } else {
+                j++;
+            }
+        }
+        verifier_plages(&c);
+        return c;
+    }
+
+    // Sinon : "et" de deux bitmaps
+    struct Conteneur c = {c1->cle, CONTENEUR_BITMAP, 0, 0, 0, NULL};
+    uint64_t* bits = vers_bits(c1);
+    uint64_t* bits2 = c2->type == CONTENEUR_BITMAP ? c2->donnees : vers_bits(c2);
+    for (int i = 0; i < NB_MOTS_BITMAP; i++) {
+        bits[i] &= bits2[i];
+    }
+    if (bits2 != c2->donnees) {
+        free(bits2);
+    }
+    remplacer_par_bits(&c, bits);
+    return c;
+}
+
+EnsembleCompresse union_compresse(EnsembleCompresse a, EnsembleCompresse b) {
+    EnsembleCompresse r = ensemble_compresse_vide();
+    size_t i = 0, j = 0;
+    while (i < a->nb_conteneurs || j < b->nb_conteneurs) {
+        if (j == b->nb_conteneurs || (i < a->nb_conteneurs && a->conteneurs[i].cle < b->conteneurs[j].cle)) {
+            ajouter_conteneur_en_fin(r, conteneur_copie(&(a->conteneurs[i])));
+            i++;
+        } else if (i == a->nb_conteneurs || b->conteneurs[j].cle < a->conteneurs[i].cle) {
+            ajouter_conteneur_en_fin(r, conteneur_copie(&(b->conteneurs[j])));
+            j++;
+        } else {
+            ajouter_conteneur_en_fin(r, union_conteneurs(&(a->conteneurs[i]), &(b->conteneurs[j])));
+            i++;
+            j++;
+        }
+    }
+    return r;
+}
+
+EnsembleCompresse intersection_compresse(EnsembleCompresse a, EnsembleCompresse b) {
+    EnsembleCompresse r = ensemble_compresse_vide();
+    size_t i = 0, j = 0;
+    while (i < a->nb_conteneurs && j < b->nb_conteneurs) {
+        if (a->conteneurs[i].cle < b->conteneurs[j].cle) {
+            i++;
+        } else if (b->conteneurs[j].cle < a->conteneurs[i].cle) {
+            j++;
+        } else {
+            struct Conteneur c = intersection_conteneurs(&(a->conteneurs[i]), &(b->conteneurs[j]));
+            if (c.cardinal > 0) {
+                ajouter_conteneur_en_fin(r, c);
+            } else {
+                free(c.donnees);
+            }
+            i++;
+            j++;
+        }
+    }
+    return r;
+}
+
+size_t memoire_compresse(EnsembleCompresse e) {
+    size_t taille = sizeof(struct TableConteneurs) + e->nb_conteneurs * sizeof(struct Conteneur);
+    for (size_t i = 0; i < e->nb_conteneurs; i++) {
+        const struct Conteneur* c = &(e->conteneurs[i]);
+        switch (c->type) {
+        case CONTENEUR_TABLEAU:
+            taille += c->nb * sizeof(uint16_t);
+            break;
+        case CONTENEUR_BITMAP:
+            taille += NB_MOTS_BITMAP * sizeof(uint64_t);
+            break;
+        default:
+            taille += c->nb * sizeof(struct Plage);
+        }
+    }
+    return taille;
+}
+
+void liberer_ensemble_compresse(EnsembleCompresse e) {
+    for (size_t i = 0; i < e->nb_conteneurs; i++) {
+        free(e->conteneurs[i].donnees);
+    }
+    free(e->conteneurs);
+    free(e);
+}
+
+
+/* Conversions */
+
+// Writes the elements of a container in increasing order; returns their number
+static size_t extraire_valeurs(const struct Conteneur* c, type_base* sortie) {
+    uint32_t haut = (uint32_t)c->cle << 16;
+    size_t n = 0;
+    switch (c->type) {
+    case CONTENEUR_TABLEAU: {
+        const uint16_t* t = c->donnees;
+        for (uint32_t i = 0; i < c->nb; i++) {
+            sortie[n++] = vers_type_base(haut | t[i]);
+        }
+        break;
+    }
+    case CONTENEUR_BITMAP: {
+        const uint64_t* bits = c->donnees;
+        for (int i = 0; i < NB_MOTS_BITMAP; i++) {
+            for (uint64_t mot = bits[i]; mot != 0; mot &= mot - 1) {
+                sortie[n++] = vers_type_base(haut | (uint32_t)(i * 64 + __builtin_ctzll(mot)));
+            }
+        }
+        break;
+    }
+    default: {
+        const struct Plage* p = c->donnees;
+        for (uint32_t i = 0; i < c->nb; i++) {
+            for (uint32_t v = p[i].debut; v <= (uint32_t)p[i].debut + p[i].longueur; v++) {
+                sortie[n++] = vers_type_base(haut | v);
+            }
+        }
+    }
+    }
+    return n;
+}
+
+// Writes all the elements of the set in increasing order (e->cardinal values)
+static type_base* toutes_les_valeurs(EnsembleCompresse e) {
+    type_base* valeurs = allouer((e->cardinal > 0 ? e->cardinal : 1) * sizeof(type_base));
+    size_t n = 0;
+    for (size_t i = 0; i < e->nb_conteneurs; i++) {
+        n += extraire_valeurs(&(e->conteneurs[i]), valeurs + n);
+    }
+    return valeurs;
+}
+
+Liste ensemble_compresse_vers_liste(EnsembleCompresse e) {
+    type_base* valeurs = toutes_les_valeurs(e);
+    Liste l = liste_vide();
+    for (size_t i = 0; i < e->cardinal; i++) {
+        ajouter_en_fin(l, valeurs[i]);
+    }
+    free(valeurs);
+    return l;
+}
+
+Ensemble ensemble_compresse_vers_ensemble(EnsembleCompresse e) {
+    type_base* valeurs = toutes_les_valeurs(e);
+    Ensemble r = ensemble_vide();
+    ajouter_lot(r, valeurs, e->cardinal);
+    free(valeurs);
+    return r;
+}
+
+static int comparer_non_signes(const void* a, const void* b) {
+    uint32_t x = *(const uint32_t*)a, y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+// Builds a set from n sorted values (duplicates allowed), one container at a time
+static EnsembleCompresse depuis_valeurs_triees(const uint32_t* valeurs, size_t n) {
+    EnsembleCompresse e = ensemble_compresse_vide();
+    size_t debut = 0;
+    while (debut < n) {
+        uint16_t cle = (uint16_t)(valeurs[debut] >> 16);
+        size_t fin = debut;
+        while (fin < n && (uint16_t)(valeurs[fin] >> 16) == cle) {
+            fin++;
+        }
+
+        struct Conteneur c = {cle, CONTENEUR_TABLEAU, 0, 0, 0, NULL};
+        if (fin - debut <= CARDINAL_MAX_TABLEAU) {
+            uint16_t* t = allouer((fin - debut) * sizeof(uint16_t));
+            for (size_t i = debut; i < fin; i++) {
+                if (c.nb == 0 || t[c.nb - 1] != (uint16_t)valeurs[i]) {
+                    t[c.nb++] = (uint16_t)valeurs[i];
+                }
+            }
+            c.cardinal = c.nb;
+            c.capacite = (uint32_t)(fin - debut);
+            c.donnees = t;
+        } else {
+            uint64_t* bits = allouer(NB_MOTS_BITMAP * sizeof(uint64_t));
+            memset(bits, 0, NB_MOTS_BITMAP * sizeof(uint64_t));
+            for (size_t i = debut; i < fin; i++) {
+                bits[(uint16_t)valeurs[i] >> 6] |= 1ULL << (valeurs[i] & 63);
+            }
+            remplacer_par_bits(&c, bits);
+        }
+        ajouter_conteneur_en_fin(e, c);
+        debut = fin;
+    }
+    return e;
+}
+
+EnsembleCompresse liste_vers_ensemble_compresse(Liste l) {
+    size_t n = longueur(l);
+    uint32_t* valeurs = allouer((n > 0 ? n : 1) * sizeof(uint32_t));
+    for (size_t i = 0; i < n; i++) {
+        type_base x = element(l, (int)i);
+        if (!tient_sur_32_bits(x)) {
+            fprintf(stderr, "Erreur: " FORMAT_BASE " ne tient pas sur 32 bits.\n", x);
+            exit(EXIT_FAILURE);
+        }
+        valeurs[i] = vers_non_signe(x);
+    }
+    qsort(valeurs, n, sizeof(uint32_t), comparer_non_signes);
+    EnsembleCompresse e = depuis_valeurs_triees(valeurs, n);
+    free(valeurs);
+    return e;
+}
+
+EnsembleCompresse ensemble_vers_ensemble_compresse(Ensemble e) {
+    Liste l = ensemble_vers_liste(e);
+    EnsembleCompresse r = liste_vers_ensemble_compresse(l);
+    liberer_liste(l);
+    return r;
+}
@@ -0,0 +1,231 @@
+/**
+ * @file ensemble_compresse.h
+ * @author
+ * */
+
+#ifndef __ENSEMBLE__COMPRESSE__H__
+#define __ENSEMBLE__COMPRESSE__H__
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "ensemble.h"
+#include "liste.h"
+
+
+/* Description de la structure */
+
+/**
+ * @brief Le nombre maximal de valeurs d'un conteneur "tableau" : au-delà,
+ * un tableau de valeurs sur 16 bits prendrait plus de place qu'un bitmap
+ * de 65536 bits (8 Kio).
+ */
+#define CARDINAL_MAX_TABLEAU 4096
+
+/**
+ * @brief Le nombre de mots de 64 bits d'un conteneur "bitmap".
+ */
+#define NB_MOTS_BITMAP 1024
+
+/**
+ * @brief Les trois représentations possibles d'un conteneur.
+ */
+enum TypeConteneur{
+	CONTENEUR_TABLEAU, /**< Un tableau trié des valeurs (au plus CARDINAL_MAX_TABLEAU). */
+	CONTENEUR_BITMAP, /**< Un tableau de 65536 bits (le bit v est à 1 si v est présente). */
+	CONTENEUR_PLAGES /**< Un tableau trié de plages de valeurs consécutives. */
+};
+
+/**
+ * @brief Une plage de valeurs consécutives : de **debut** à **debut** + **longueur**
+ * (incluses ; une plage d'une seule valeur a donc une longueur de 0).
+ */
+struct Plage{
+	uint16_t debut; /**< La première valeur de la plage. */
+	uint16_t longueur; /**< Le nombre de valeurs de la plage, moins un. */
+};
+
+/**
+ * @brief Un conteneur : les éléments dont les 16 bits de poids fort valent **cle**.
+ * Seuls leurs 16 bits de poids faible sont stockés.
+ */
+struct Conteneur{
+	uint16_t cle; /**< Les 16 bits de poids fort communs aux éléments du conteneur. */
+	enum TypeConteneur type; /**< La représentation utilisée. */
+	uint32_t cardinal; /**< Le nombre d'éléments (entre 1 et 65536). */
+	uint32_t nb; /**< Le nombre de valeurs (tableau) ou de plages (plages) ; inutilisé pour un bitmap. */
+	uint32_t capacite; /**< Le nombre de valeurs ou de plages qu'on peut stocker sans réallouer. */
+	void* donnees; /**< Un `uint16_t*` (tableau), un `uint64_t*` de NB_MOTS_BITMAP mots
+	* (bitmap) ou un `struct Plage*` (plages). */
+};
+
+/**
+ * @brief Structure codant un ensemble d'entiers compressé "à la Roaring". \n
+ * Un élément x est vu comme un entier non signé sur 32 bits, dont le bit de signe
+ * est inversé (pour que l'ordre des entiers non signés soit celui des `type_base`).
+ * Avec des clés de 64 bits (`-DCLES_64_BITS`), seules celles qui tiennent sur
+ * 32 bits peuvent être ajoutées.
+ * Ses 16 bits de poids fort choisissent un conteneur, et ses 16 bits de poids faible
+ * sont stockés dans ce conteneur sous l'une de trois formes :
+ * @li un **tableau** trié (2 octets par élément) s'il a au plus CARDINAL_MAX_TABLEAU éléments,
+ * @li un **bitmap** de 8 Kio (1 bit par valeur possible) sinon,
+ * @li des **plages** (4 octets par plage) quand c'est plus petit : c'est
+ * `optimiser_compresse` qui les crée (ainsi que l'union et l'intersection de
+ * deux conteneurs de plages).
+ *
+ * Les conteneurs (non vides) sont rangés par clé croissante ; on y cherche par dichotomie.
+ * Pour des identifiants denses, un élément coûte ainsi 2 octets, ou 1 bit, ou
+ * presque rien (une plage), au lieu des 16 octets d'un noeud et des 8 octets
+ * d'alvéole de `Ensemble`. Il n'y a pas de doublon.
+ */
+struct TableConteneurs{
+
+	struct Conteneur* conteneurs; /**< Les conteneurs, par clé croissante. */
+
+	size_t nb_conteneurs; /**< Le nombre de conteneurs. */
+
+	size_t capacite; /**< La taille du tableau **conteneurs**. */
+
+	size_t cardinal; /**< Le nombre d'éléments de l'ensemble. */
+};
+
+/**
+ * @brief Le type "EnsembleCompresse" offre les mêmes opérations que "Ensemble"
+ * (sans doublon) sur un bitmap compressé.
+ */
+typedef struct TableConteneurs* EnsembleCompresse;
+
+
+/* Prototype des fonctions */
+
+/**
+ * @brief Renvoie un ensemble compressé vide. \n
+ * **Complexité :** O(1)
+ * @returns un ensemble vide.
+ */
+EnsembleCompresse ensemble_compresse_vide();
+
+/**
+ * @brief Ajoute un élément (rien ne change s'il est déjà présent). \n
+ * Un tableau qui dépasse CARDINAL_MAX_TABLEAU éléments devient un bitmap ;
+ * des plages devenues trop nombreuses deviennent un tableau ou un bitmap. \n
+ * **Complexité :** O(log(nombre de conteneurs) + CARDINAL_MAX_TABLEAU)
+ * (le décalage d'un tableau) ; O(log(nombre de conteneurs)) pour un bitmap \n
+ * Déclenche une erreur si x ne tient pas sur 32 bits.
+ * @param e un ensemble compressé,
+ * @param x une valeur qu'on veut ajouter dans e.
+ */
+void ajouter_compresse(EnsembleCompresse e, type_base x);
+
+/**
+ * @brief Détermine si un élément appartient à un ensemble compressé. \n
+ * **Complexité :** O(log(nombre de conteneurs) + log(CARDINAL_MAX_TABLEAU))
+ * @param e un ensemble compressé,
+ * @param x une valeur qu'on recherche dans e.
+ * @returns **true** si x appartient dans e, **false** sinon.
+ */
+bool appartient_compresse(EnsembleCompresse e, type_base x);
+
+/**
+ * @brief Supprime un élément. \n
+ * Un bitmap qui descend à CARDINAL_MAX_TABLEAU éléments redevient un tableau ;
+ * un conteneur vide est retiré. \n
+ * Déclenche une erreur si jamais la valeur n'est pas dans e. \n
+ * **Complexité :** la même que `ajouter_compresse`
+ * @param e un ensemble compressé,
+ * @param x une valeur qu'on veut supprimer de e.
+ */
+void supprimer_compresse(EnsembleCompresse e, type_base x);
+
+/**
+ * @brief Renvoie le nombre d'éléments d'un ensemble compressé. \n
+ * **Complexité :** O(1)
+ * @param e un ensemble compressé.
+ * @returns le nombre d'éléments de e.
+ */
+size_t cardinal_compresse(EnsembleCompresse e);
+
+/**
+ * @brief Remplace chaque conteneur par des plages si c'est plus petit
+ * (et des plages par un tableau ou un bitmap sinon). \n
+ * **Complexité :** O(nombre de conteneurs * NB_MOTS_BITMAP)
+ * @param e un ensemble compressé.
+ */
+void optimiser_compresse(EnsembleCompresse e);
+
+/**
+ * @brief Renvoie l'union de deux ensembles compressés. \n
+ * Les conteneurs sont fusionnés clé par clé : deux tableaux par fusion de listes
+ * triées, deux listes de plages par fusion de plages, sinon par "ou" de bitmaps
+ * (1024 mots). Les conteneurs présents dans un seul ensemble sont recopiés.
+ * **Complexité :** O(nombre de conteneurs * NB_MOTS_BITMAP)
+ * @param a un ensemble compressé,
+ * @param b un ensemble compressé.
+ * @returns un nouvel ensemble compressé contenant les éléments de a ou de b.
+ */
+EnsembleCompresse union_compresse(EnsembleCompresse a, EnsembleCompresse b);
+
+/**
+ * @brief Renvoie l'intersection de deux ensembles compressés. \n
+ * Seules les clés communes sont traitées : un tableau est filtré par des
+ * recherches dans l'autre conteneur, deux listes de plages sont intersectées
+ * directement, sinon on fait un "et" de bitmaps.
+ * **Complexité :** O(nombre de conteneurs * NB_MOTS_BITMAP)
+ * @param a un ensemble compressé,
+ * @param b un ensemble compressé.
+ * @returns un nouvel ensemble compressé contenant les éléments de a et de b.
+ */
+EnsembleCompresse intersection_compresse(EnsembleCompresse a, EnsembleCompresse b);
+
+/**
+ * @brief Renvoie le nombre d'octets utilisés par un ensemble compressé
+ * (conteneurs et structure, sans compter le surplus des tableaux préalloués). \n
+ * **Complexité :** O(nombre de conteneurs)
+ * @param e un ensemble compressé.
+ * @returns la taille en mémoire de e, en octets.
+ */
+size_t memoire_compresse(EnsembleCompresse e);
+
+/**
+ * @brief Libère la mémoire associée à un ensemble compressé. \n
+ * **Complexité :** O(nombre de conteneurs)
+ * @param e un ensemble compressé.
+ */
+void liberer_ensemble_compresse(EnsembleCompresse e);
+
+/**
+ * @brief Convertit un ensemble compressé en une liste (triée). \n
+ * **Complexité :** O(cardinal + nombre de conteneurs * NB_MOTS_BITMAP)
+ * @param e un ensemble compressé.
+ * @returns une liste contenant les éléments de e, par ordre croissant.
+ */
+Liste ensemble_compresse_vers_liste(EnsembleCompresse e);
+
+/**
+ * @brief Convertit une liste en un ensemble compressé (les doublons disparaissent). \n
+ * Les valeurs sont triées, puis chaque conteneur est construit d'un coup.
+ * Déclenche une erreur si un élément ne tient pas sur 32 bits.
+ * **Complexité :** O(n log n), où n est la taille de la liste
+ * @param l une liste.
+ * @returns un ensemble compressé contenant les éléments de l.
+ */
+EnsembleCompresse liste_vers_ensemble_compresse(Liste l);
+
+/**
+ * @brief Convertit un ensemble (à adressage par listes chaînées) en un ensemble compressé. \n
+ * Déclenche une erreur si un élément ne tient pas sur 32 bits.
+ * **Complexité :** O(n log n), où n est la taille de l'ensemble
+ * @param e un ensemble.
+ * @returns un ensemble compressé contenant les éléments de e.
+ */
+EnsembleCompresse ensemble_vers_ensemble_compresse(Ensemble e);
+
+/**
+ * @brief Convertit un ensemble compressé en un ensemble (à adressage par listes chaînées). \n
+ * **Complexité :** O(cardinal + nombre de conteneurs * NB_MOTS_BITMAP)
+ * @param e un ensemble compressé.
+ * @returns un ensemble contenant les éléments de e.
+ */
+Ensemble ensemble_compresse_vers_ensemble(EnsembleCompresse e);
+
+#endif
@@ -0,0 +1,410 @@
+#include "ensemble_concurrent.h"
+#include "ensemble.h"
+#include "hachage.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <sched.h>
+#include <time.h>
+
+// Announced epoch of a thread which is not reading
+#define EPOQUE_INACTIVE UINT64_MAX
+
+static void* allouer(size_t taille) {
+    void* p = malloc(taille);
+    if (p == NULL) {
+        fprintf(stderr, "Erreur: Échec de l'allocation de mémoire.\n");
+        exit(EXIT_FAILURE);
+    }
+    return p;
+}
+
+
+/* Thread numbers (shared by every concurrent ensemble) */
+
+static atomic_bool numeros_pris[NB_THREADS_MAX];
+static _Thread_local int numero_thread = -1;
+static pthread_key_t cle_numero;
+static pthread_once_t cle_numero_creee = PTHREAD_ONCE_INIT;
+
+// Called when a thread exits: its number can be given to another thread
+static void rendre_numero(void* numero_plus_un) {
+    atomic_store(&numeros_pris[(intptr_t)numero_plus_un - 1], false);
+}
+
+static void creer_cle_numero() {
+    pthread_key_create(&cle_numero, rendre_numero);
+}
+
+// Number of the calling thread, between 0 and NB_THREADS_MAX - 1
+static int mon_numero() {
+    if (numero_thread < 0) {
+        pthread_once(&cle_numero_creee, creer_cle_numero);
+        for (int i = 0; i < NB_THREADS_MAX && numero_thread < 0; i++) {
+            bool libre = false;
+            if (atomic_compare_exchange_strong(&numeros_pris[i], &libre, true)) {
+                numero_thread = i;
+            }
+        }
+        if (numero_thread < 0) {
+            fprintf(stderr, "Erreur: Plus de %d threads utilisent les ensembles concurrents.\n",
+                    NB_THREADS_MAX);
+            exit(EXIT_FAILURE);
+        }
+        pthread_setspecific(cle_numero, (void*)(intptr_t)(numero_thread + 1));
+    }
+    return numero_thread;
+}
+
+
+/* Epoch-based reclamation */
+
+static void entrer_lecture(EnsembleConcurrent e) {
+    atomic_store(&e->epoques[mon_numero()].epoque, atomic_load(&e->epoque));
+}
+
+static void sortir_lecture(EnsembleConcurrent e) {
+    atomic_store_explicit(&e->epoques[mon_numero()].epoque, EPOQUE_INACTIVE, memory_order_release);
+}
+
+static void liberer_table(struct TableConcurrente* t) {
+    for (size_t i = 0; i < t->nb_alveoles; i++) {
+        struct NoeudConcurrent* n = atomic_load_explicit(&t->alveoles[i], memory_order_relaxed);
+        while (n != NULL) {
+            struct NoeudConcurrent* suivant = atomic_load_explicit(&n->suivant, memory_order_relaxed);
+            free(n);
+            n = suivant;
+        }
+    }
+    free(t->alveoles);
+    free(t);
+}
+
+static void liberer_rebuts(struct Rebut* r) {
+    while (r != NULL) {
+        struct Rebut* suivant = r->suivant;
+        if (r->est_table) {
+            liberer_table(r->adresse);
+        } else {
+            free(r->adresse);
+        }
+        free(r);
+        r = suivant;
+    }
+}
+
+static void liberer_noeuds_retires(struct NoeudConcurrent* n) {
+    while (n != NULL) {
+        struct NoeudConcurrent* suivant = n->retire_suivant;
+        free(n);
+        n = suivant;
+    }
+}
+
+// Moves to the next epoch if every reading thread has seen the current one;
+// what was retired two epochs ago can then no longer be reached (verrou_rebuts held)
+static void essayer_avancer_epoque(EnsembleConcurrent e) {
+    uint64_t g = atomic_load(&e->epoque);
+    for (int t = 0; t < NB_THREADS_MAX; t++) {
+        uint64_t vue = atomic_load(&e->epoques[t].epoque);
+        if (vue != EPOQUE_INACTIVE && vue != g) {
+            return;
+        }
+    }
+    atomic_store(&e->epoque, g + 1);
+    liberer_rebuts(e->rebuts[(g + 1) % 3]);
+    e->rebuts[(g + 1) % 3] = NULL;
+    liberer_noeuds_retires(e->noeuds_retires[(g + 1) % 3]);
+    e->noeuds_retires[(g + 1) % 3] = NULL;
+    e->nb_nouveaux_rebuts = 0;
+}
+
+// Frees a removed node once no reader can reach it
+static void retirer_noeud(EnsembleConcurrent e, struct NoeudConcurrent* n) {
+    pthread_mutex_lock(&e->verrou_rebuts);
+    uint64_t g = atomic_load(&e->epoque);
+    n->retire_suivant = e->noeuds_retires[g % 3];
+    e->noeuds_retires[g % 3] = n;
+    e->nb_nouveaux_rebuts++;
+    if (e->nb_nouveaux_rebuts >= NB_THREADS_MAX) {
+        essayer_avancer_epoque(e);
+    }
+    pthread_mutex_unlock(&e->verrou_rebuts);
+}
+
+// Frees a table or a migration once no reader can reach it
+static void retirer(EnsembleConcurrent e, void* adresse, bool est_table) {
+    struct Rebut* r = allouer(sizeof(struct Rebut));
+    r->adresse = adresse;
+    r->est_table = est_table;
+
+    pthread_mutex_lock(&e->verrou_rebuts);
+    uint64_t g = atomic_load(&e->epoque);
+    r->suivant = e->rebuts[g % 3];
+    e->rebuts[g % 3] = r;
+    e->nb_nouveaux_rebuts++;
+    if (est_table) {
+        essayer_avancer_epoque(e);
+    }
+    pthread_mutex_unlock(&e->verrou_rebuts);
+}
+
+
+/* Table */
+
+static inline uint64_t hacher_concurrent(EnsembleConcurrent e, type_base x) {
+    return hachage_murmur3(objet_vers_nombre(x), e->graine);
+}
+
+static inline size_t alveole_concurrente(struct TableConcurrente* t, uint64_t h) {
+    return (size_t)(h >> (64 - __builtin_ctzll(t->nb_alveoles)));
+}
+
+static struct TableConcurrente* table_concurrente_vide(size_t nb_alveoles) {
+    struct TableConcurrente* t = allouer(sizeof(struct TableConcurrente));
+    t->nb_alveoles = nb_alveoles;
+    t->alveoles = calloc(nb_alveoles, sizeof(struct NoeudConcurrent*));
+    if (t->alveoles == NULL) {
+        fprintf(stderr, "Erreur: Échec de l'allocation de mémoire.\n");
+        exit(EXIT_FAILURE);
+    }
+    return t;
+}
+
+// Copies the parts of the migration that nobody has taken yet.
+// Old bucket i only goes to new buckets 2i and 2i+1: parts are independent.
+static void migrer_parts(EnsembleConcurrent e, struct Migration* m) {
+    size_t part;
+    while ((part = atomic_fetch_add(&m->prochaine_part, 1)) < m->nb_parts) {
+        size_t debut = part * NB_ALVEOLES_PAR_PART;
+        size_t fin = debut + NB_ALVEOLES_PAR_PART;
+        if (fin > m->ancienne->nb_alveoles) {
+            fin = m->ancienne->nb_alveoles;
+        }
+
+        for (size_t i = debut; i < fin; i++) {
+            struct NoeudConcurrent* n = atomic_load_explicit(&m->ancienne->alveoles[i], memory_order_acquire);
+            // The old nodes are copied, not relinked: readers may still be walking them
+            while (n != NULL) {
+                size_t j = alveole_concurrente(m->nouvelle, hacher_concurrent(e, n->valeur));
+                struct NoeudConcurrent* copie = allouer(sizeof(struct NoeudConcurrent));
+                copie->valeur = n->valeur;
+                atomic_store_explicit(&copie->suivant,
+                    atomic_load_explicit(&m->nouvelle->alveoles[j], memory_order_relaxed), memory_order_relaxed);
+                atomic_store_explicit(&m->nouvelle->alveoles[j], copie, memory_order_relaxed);
+                n = atomic_load_explicit(&n->suivant, memory_order_acquire);
+            }
+        }
+
+        atomic_fetch_add_explicit(&m->nb_parts_finies, 1, memory_order_release);
+    }
+}
+
+// Helps the migration in progress, if any
+static void aider_migration(EnsembleConcurrent e) {
+    if (atomic_load_explicit(&e->migration, memory_order_relaxed) == NULL) {
+        return;
+    }
+    // The migration may end (and be freed) while we help: protect it like a read
+    entrer_lecture(e);
+    struct Migration* m = atomic_load_explicit(&e->migration, memory_order_acquire);
+    if (m != NULL) {
+        migrer_parts(e, m);
+    }
+    sortir_lecture(e);
+}
+
+// Locks a stripe, helping any migration while the lock is not available
+static void verrouiller(EnsembleConcurrent e, struct Verrou* v) {
+    while (pthread_mutex_trylock(&v->mutex) != 0) {
+        aider_migration(e);
+        sched_yield();
+    }
+}
+
+// Number of additions (or deletions) a stripe keeps before reporting them to
+// taille_approchee: the total is then known to within a quarter of the buckets
+static long lot_publication(struct TableConcurrente* t) {
+    long lot = (long)(t->nb_alveoles / (4 * NB_VERROUS));
+    return lot < 1 ? 1 : lot;
+}
+
+// Reports the pending count of a stripe (whose lock is held) to the total, and
+// returns the new total
+static long publier_taille(EnsembleConcurrent e, struct Verrou* v) {
+    long total = atomic_fetch_add_explicit(&e->taille_approchee, v->non_publies, memory_order_relaxed)
+                 + v->non_publies;
+    v->non_publies = 0;
+    return total;
+}
+
+// Doubles the number of buckets of the table t (unless another thread already did it)
+static void agrandir(EnsembleConcurrent e, struct TableConcurrente* t) {
+    for (int i = 0; i < NB_VERROUS; i++) {
+        pthread_mutex_lock(&e->verrous[i].mutex);
+    }
+
+    struct Migration* m = NULL;
+    if (atomic_load_explicit(&e->table, memory_order_relaxed) == t) {
+        m = allouer(sizeof(struct Migration));
+        m->ancienne = t;
+        m->nouvelle = table_concurrente_vide(2 * t->nb_alveoles);
+        m->nb_parts = (t->nb_alveoles + NB_ALVEOLES_PAR_PART - 1) / NB_ALVEOLES_PAR_PART;
+        atomic_init(&m->prochaine_part, 0);
+        atomic_init(&m->nb_parts_finies, 0);
+        atomic_store_explicit(&e->migration, m, memory_order_release);
+
+        // Migrer avec l'aide des autres écrivains, puis attendre qu'ils aient fini
+        migrer_parts(e, m);
+        while (atomic_load_explicit(&m->nb_parts_finies, memory_order_acquire) < m->nb_parts) {
+            sched_yield();
+        }
+
+        atomic_store_explicit(&e->table, m->nouvelle, memory_order_release);
+        atomic_store_explicit(&e->migration, NULL, memory_order_release);
+    }
+
+    for (int i = NB_VERROUS - 1; i >= 0; i--) {
+        pthread_mutex_unlock(&e->verrous[i].mutex);
+    }
+
+    if (m != NULL) {
+        retirer(e, t, true);
+        retirer(e, m, false);
+    }
+}
+
+EnsembleConcurrent ensemble_concurrent_vide() {
+    srand(time(NULL)); // Seed the random number generator
+
+    EnsembleConcurrent e = aligned_alloc(64, sizeof(struct TableHachageConcurrente));
+    if (e == NULL) {
+        fprintf(stderr, "Erreur: Échec de l'allocation de mémoire.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    atomic_init(&e->table, table_concurrente_vide(2 * NB_VERROUS));
+    for (int i = 0; i < NB_VERROUS; i++) {
+        pthread_mutex_init(&e->verrous[i].mutex, NULL);
+        e->verrous[i].taille = 0;
+        e->verrous[i].non_publies = 0;
+    }
+    atomic_init(&e->taille_approchee, 0);
+    e->graine = ((uint64_t)rand() << 32) ^ (uint64_t)rand();
+    atomic_init(&e->migration, NULL);
+
+    atomic_init(&e->epoque, 0);
+    for (int t = 0; t < NB_THREADS_MAX; t++) {
+        atomic_init(&e->epoques[t].epoque, EPOQUE_INACTIVE);
+    }
+    pthread_mutex_init(&e->verrou_rebuts, NULL);
+    for (int k = 0; k < 3; k++) {
+        e->rebuts[k] = NULL;
+        e->noeuds_retires[k] = NULL;
+    }
+    e->nb_nouveaux_rebuts = 0;
+
+    return e;
+}
+
+void ajouter_concurrent(EnsembleConcurrent e, type_base x) {
+    uint64_t h = hacher_concurrent(e, x);
+    struct Verrou* v = &(e->verrous[h >> (64 - LOG_NB_VERROUS)]);
+
+    struct NoeudConcurrent* n = allouer(sizeof(struct NoeudConcurrent));
+    n->valeur = x;
+
+    verrouiller(e, v);
+
+    // La table ne peut pas changer tant qu'on tient un verrou
+    struct TableConcurrente* t = atomic_load_explicit(&e->table, memory_order_acquire);
+    size_t i = alveole_concurrente(t, h);
+    atomic_store_explicit(&n->suivant,
+        atomic_load_explicit(&t->alveoles[i], memory_order_relaxed), memory_order_relaxed);
+    // Publier le noeud (entièrement rempli) pour les lecteurs
+    atomic_store_explicit(&t->alveoles[i], n, memory_order_release);
+
+    v->taille++;
+    v->non_publies++;
+    // On ne regarde le total (de tous les verrous) qu'en y reportant un lot
+    bool trop_plein = v->non_publies >= lot_publication(t)
+                      && publier_taille(e, v) * 2 > (long)t->nb_alveoles;
+
+    pthread_mutex_unlock(&v->mutex);
+
+    if (trop_plein) {
+        agrandir(e, t);
+    }
+}
+
+bool appartient_concurrent(EnsembleConcurrent e, type_base x) {
+    uint64_t h = hacher_concurrent(e, x);
+    bool trouve = false;
+
+    entrer_lecture(e);
+
+    struct TableConcurrente* t = atomic_load_explicit(&e->table, memory_order_acquire);
+    struct NoeudConcurrent* n = atomic_load_explicit(&t->alveoles[alveole_concurrente(t, h)], memory_order_acquire);
+    while (n != NULL && !trouve) {
+        trouve = (n->valeur == x);
+        n = atomic_load_explicit(&n->suivant, memory_order_acquire);
+    }
+
+    sortir_lecture(e);
+    return trouve;
+}
+
+bool supprimer_concurrent(EnsembleConcurrent e, type_base x) {
+    uint64_t h = hacher_concurrent(e, x);
+    struct Verrou* v = &(e->verrous[h >> (64 - LOG_NB_VERROUS)]);
+
+    verrouiller(e, v);
+
+    struct TableConcurrente* t = atomic_load_explicit(&e->table, memory_order_acquire);
+    _Atomic(struct NoeudConcurrent*)* lien = &(t->alveoles[alveole_concurrente(t, h)]);
+    struct NoeudConcurrent* n = atomic_load_explicit(lien, memory_order_relaxed);
+
+    while (n != NULL && n->valeur != x) {
+        lien = &(n->suivant);
+        n = atomic_load_explicit(lien, memory_order_relaxed);
+    }
+
+    if (n != NULL) {
+        // Les lecteurs qui sont sur n peuvent encore suivre son lien
+        atomic_store_explicit(lien, atomic_load_explicit(&n->suivant, memory_order_relaxed), memory_order_release);
+        v->taille--;
+        v->non_publies--;
+        if (-v->non_publies >= lot_publication(t)) {
+            publier_taille(e, v);
+        }
+    }
+
+    pthread_mutex_unlock(&v->mutex);
+
+    if (n != NULL) {
+        retirer_noeud(e, n);
+    }
+    return n != NULL;
+}
+
+size_t taille_concurrent(EnsembleConcurrent e) {
+    size_t taille = 0;
+    for (int i = 0; i < NB_VERROUS; i++) {
+        pthread_mutex_lock(&e->verrous[i].mutex);
+        taille += e->verrous[i].taille;
+        pthread_mutex_unlock(&e->verrous[i].mutex);
+    }
+    return taille;
+}
+
+void liberer_ensemble_concurrent(EnsembleConcurrent e) {
+    for (int k = 0; k < 3; k++) {
+        liberer_rebuts(e->rebuts[k]);
+        liberer_noeuds_retires(e->noeuds_retires[k]);
+    }
+    liberer_table(atomic_load(&e->table));
+    for (int i = 0; i < NB_VERROUS; i++) {
+        pthread_mutex_destroy(&e->verrous[i].mutex);
+    }
+    pthread_mutex_destroy(&e->verrou_rebuts);
+    free(e);
+}
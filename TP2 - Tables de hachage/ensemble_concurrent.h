@@ -0,0 +1,222 @@
+/**
+ * @file ensemble_concurrent.h
+ * @author
+ * */
+
+#ifndef __ENSEMBLE__CONCURRENT__H__
+#define __ENSEMBLE__CONCURRENT__H__
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "liste.h"
+
+
+/* Description de la structure */
+
+/**
+ * @brief Le logarithme en base 2 du nombre de verrous.
+ */
+#define LOG_NB_VERROUS 6
+
+/**
+ * @brief Le nombre de verrous (chaque verrou protège une plage contiguë
+ * d'alvéoles : celles dont le code de hachage a les mêmes LOG_NB_VERROUS
+ * bits de poids fort).
+ */
+#define NB_VERROUS (1 << LOG_NB_VERROUS)
+
+/**
+ * @brief Le nombre maximal de threads différents qui peuvent utiliser
+ * les ensembles concurrents.
+ */
+#define NB_THREADS_MAX 64
+
+/**
+ * @brief Le nombre d'anciennes alvéoles que migre un thread à chaque fois
+ * qu'il se réserve une part d'un agrandissement.
+ */
+#define NB_ALVEOLES_PAR_PART 1024
+
+/**
+ * @brief Un noeud de liste chaînée dont le lien peut être lu par un thread
+ * pendant qu'un autre le modifie.
+ */
+struct NoeudConcurrent{
+	type_base valeur; /**< L'étiquette du noeud */
+	_Atomic(struct NoeudConcurrent*) suivant; /**< L'adresse du noeud suivant (ou NULL). */
+	struct NoeudConcurrent* retire_suivant; /**< Une fois le noeud supprimé, le noeud
+	* suivant dans la liste des noeuds retirés (pour ne pas allouer de `struct Rebut`). */
+};
+
+/**
+ * @brief Une table d'alvéoles. Elle n'est jamais modifiée en taille :
+ * un agrandissement crée une nouvelle table.
+ */
+struct TableConcurrente{
+	size_t nb_alveoles; /**< Le nombre d'alvéoles (une puissance de deux). */
+	_Atomic(struct NoeudConcurrent*)* alveoles; /**< Le tableau des têtes de listes chaînées. */
+};
+
+/**
+ * @brief Un verrou et le nombre d'éléments qu'il protège.
+ * La structure est alignée sur une ligne de cache pour que deux threads
+ * qui utilisent deux verrous différents ne se gênent pas.
+ */
+struct Verrou{
+	_Alignas(64) pthread_mutex_t mutex; /**< Le verrou lui-même. */
+	size_t taille; /**< Le nombre d'éléments dont le code de hachage tombe sur ce verrou. */
+	long non_publies; /**< Les ajouts moins les suppressions de ce verrou pas encore
+	* reportés dans **taille_approchee** de l'ensemble. */
+};
+
+/**
+ * @brief L'époque annoncée par un thread (alignée sur une ligne de cache).
+ */
+struct EpoqueThread{
+	_Alignas(64) _Atomic uint64_t epoque; /**< L'époque globale au début de la
+	* lecture en cours, ou EPOQUE_INACTIVE si le thread ne lit pas. */
+};
+
+/**
+ * @brief L'état d'un agrandissement en cours.
+ */
+struct Migration{
+	struct TableConcurrente* ancienne; /**< La table qu'on agrandit. */
+	struct TableConcurrente* nouvelle; /**< La table deux fois plus grande qu'on remplit. */
+	size_t nb_parts; /**< Le nombre de parts de NB_ALVEOLES_PAR_PART anciennes alvéoles. */
+	atomic_size_t prochaine_part; /**< Le numéro de la prochaine part à migrer. */
+	atomic_size_t nb_parts_finies; /**< Le nombre de parts déjà migrées. */
+};
+
+/**
+ * @brief Une table ou une migration qui n'est plus accessible, mais que des
+ * lecteurs sont peut-être encore en train de parcourir.
+ */
+struct Rebut{
+	void* adresse; /**< Une table ou une migration. */
+	bool est_table; /**< Vrai si **adresse** est une `struct TableConcurrente`
+	* (on libère alors aussi ses noeuds). */
+	struct Rebut* suivant; /**< Le rebut suivant. */
+};
+
+/**
+ * @brief Structure codant une table de hachage (avec doublons) utilisable
+ * par plusieurs threads en même temps. \n
+ * @li Les **lectures** (`appartient_concurrent`) ne prennent aucun verrou :
+ * elles lisent la table courante et parcourent les listes avec des lectures atomiques.
+ * @li Les **écritures** prennent l'un des NB_VERROUS verrous, choisi par
+ * les LOG_NB_VERROUS bits de poids fort du code de hachage. Comme l'alvéole
+ * est aussi donnée par les bits de poids fort (et qu'il y a au moins NB_VERROUS
+ * alvéoles), chaque verrou protège une plage contiguë d'alvéoles, et un élément
+ * garde le même verrou après un agrandissement.
+ * @li Un **agrandissement** est coopératif : le thread qui le déclenche prend
+ * tous les verrous et crée la nouvelle table ; les threads écrivains qui arrivent
+ * pendant ce temps se réservent des parts de NB_ALVEOLES_PAR_PART anciennes alvéoles
+ * et les recopient. L'ancienne alvéole i va dans les nouvelles alvéoles 2i et 2i+1,
+ * donc les parts sont indépendantes. La table ne rétrécit jamais.
+ * @li Les noeuds supprimés et les anciennes tables ne sont libérés que quand
+ * aucun lecteur ne peut plus les parcourir (récupération par époques).
+ */
+struct TableHachageConcurrente{
+
+	_Atomic(struct TableConcurrente*) table; /**< La table courante. */
+
+	struct Verrou verrous[NB_VERROUS]; /**< Les verrous des écrivains. */
+
+	uint64_t graine; /**< La graine aléatoire de la fonction de hachage. */
+
+	_Atomic(struct Migration*) migration; /**< L'agrandissement en cours
+	* (le pointeur nul s'il n'y en a pas). */
+
+	_Alignas(64) _Atomic long taille_approchee; /**< Le nombre total d'éléments, à
+	* un quart du nombre d'alvéoles près : chaque verrou y reporte ses ajouts et
+	* suppressions par lots (voir `ajouter_concurrent`). Il décide des agrandissements. */
+
+	_Atomic uint64_t epoque; /**< L'époque globale. */
+
+	struct EpoqueThread epoques[NB_THREADS_MAX]; /**< L'époque annoncée par chaque thread. */
+
+	pthread_mutex_t verrou_rebuts; /**< Le verrou qui protège **rebuts** et **noeuds_retires**. */
+
+	struct Rebut* rebuts[3]; /**< `rebuts[k]` contient les tables et migrations retirées
+	* pendant une époque congrue à k modulo 3. */
+
+	struct NoeudConcurrent* noeuds_retires[3]; /**< `noeuds_retires[k]` contient les
+	* noeuds supprimés pendant une époque congrue à k modulo 3. */
+
+	size_t nb_nouveaux_rebuts; /**< Le nombre de noeuds retirés depuis la dernière
+	* tentative de changement d'époque (on ne tente qu'une fois tous les NB_THREADS_MAX rebuts). */
+};
+
+/**
+ * @brief Le type "EnsembleConcurrent" offre les mêmes opérations que "Ensemble",
+ * utilisables depuis plusieurs threads à la fois.
+ */
+typedef struct TableHachageConcurrente* EnsembleConcurrent;
+
+
+/* Prototype des fonctions */
+
+/**
+ * @brief Renvoie un ensemble concurrent vide (2 * NB_VERROUS alvéoles initialement). \n
+ * **Complexité :** O(NB_VERROUS + NB_THREADS_MAX)
+ * @returns un ensemble vide
+ */
+EnsembleConcurrent ensemble_concurrent_vide();
+
+/**
+ * @brief Ajoute un élément (on s'autorise les doublons). \n
+ * Si le nombre total d'éléments dépasse la moitié du nombre d'alvéoles, on
+ * double le nombre d'alvéoles. Ce nombre total est **taille_approchee** : un
+ * verrou n'y reporte ses ajouts que par lots de `nb_alveoles / (4 * NB_VERROUS)`,
+ * pour que les écrivains ne se disputent pas un même compteur. Des doublons
+ * ou des clés qui tombent toutes sur le même verrou n'agrandissent donc la
+ * table que si l'ensemble entier est trop chargé. \n
+ * **Complexité :** O(1) (en amorti)
+ * @param e un ensemble concurrent,
+ * @param x une valeur qu'on veut ajouter dans e.
+ */
+void ajouter_concurrent(EnsembleConcurrent e, type_base x);
+
+/**
+ * @brief Détermine si un élément appartient à l'ensemble, sans prendre de verrou. \n
+ * Le résultat reflète un état de l'ensemble pendant l'appel. \n
+ * **Complexité :** O(1) (en moyenne)
+ * @param e un ensemble concurrent,
+ * @param x une valeur qu'on recherche dans e.
+ * @returns **true** si x appartient dans e, **false** sinon.
+ */
+bool appartient_concurrent(EnsembleConcurrent e, type_base x);
+
+/**
+ * @brief Supprime une occurrence d'un élément s'il est présent. \n
+ * (Contrairement à `supprimer`, on ne déclenche pas d'erreur : un autre thread
+ * a pu supprimer l'élément entre-temps.) \n
+ * **Complexité :** O(1) (en moyenne)
+ * @param e un ensemble concurrent,
+ * @param x une valeur dont on veut supprimer une occurrence dans e.
+ * @returns **true** si une occurrence a été supprimée, **false** sinon.
+ */
+bool supprimer_concurrent(EnsembleConcurrent e, type_base x);
+
+/**
+ * @brief Renvoie le nombre d'éléments de l'ensemble
+ * (exact si aucun thread ne le modifie en même temps). \n
+ * **Complexité :** O(NB_VERROUS)
+ * @param e un ensemble concurrent.
+ * @returns le nombre d'éléments de e.
+ */
+size_t taille_concurrent(EnsembleConcurrent e);
+
+/**
+ * @brief Libère la mémoire associée à un ensemble concurrent. \n
+ * Aucun autre thread ne doit l'utiliser pendant (ni après) l'appel. \n
+ * **Complexité :** O(taille de l'ensemble)
+ * @param e un ensemble concurrent.
+ */
+void liberer_ensemble_concurrent(EnsembleConcurrent e);
+
+#endif
@@ -0,0 +1,281 @@
+#include "ensemble_coucou.h"
+#include "ensemble.h"
+#include "hachage.h"
+#include "liste.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+// Mask of the cases of a bucket that are all occupied
+#define TOUTES_OCCUPEES ((1u << NB_CASES_ALVEOLE) - 1)
+
+// The two buckets of x come from a single murmur3 code: the high bits give the
+// first one, and the same code rotated by 32 bits gives the second one
+static inline void alveoles_de(EnsembleCoucou e, type_base x, size_t* a1, size_t* a2) {
+    uint64_t h = hachage_murmur3(objet_vers_nombre(x), e->graine);
+    int decalage = 64 - __builtin_ctzll(e->nb_alveoles);
+    *a1 = (size_t)(h >> decalage);
+    *a2 = (size_t)(((h << 32) | (h >> 32)) >> decalage);
+}
+
+// Bit i of the result is set if the case i of the bucket contains x
+// (a branch-free loop: the compiler turns it into a single vector comparison)
+static inline uint32_t masque_egaux(const struct AlveoleCoucou* a, type_base x) {
+    uint32_t masque = 0;
+    for (int i = 0; i < NB_CASES_ALVEOLE; i++) {
+        masque |= (uint32_t)(a->cles[i] == x) << i;
+    }
+    return masque & a->occupees;
+}
+
+// Allocates an array of empty buckets, aligned on a cache line
+static struct AlveoleCoucou* alveoles_vides(size_t nb_alveoles) {
+    size_t taille = nb_alveoles * sizeof(struct AlveoleCoucou);
+    struct AlveoleCoucou* alveoles = aligned_alloc(64, taille < 64 ? 64 : taille);
+    if (alveoles == NULL) {
+        fprintf(stderr, "Erreur: Échec de l'allocation de mémoire.\n");
+        exit(EXIT_FAILURE);
+    }
+    memset(alveoles, 0, taille);
+    return alveoles;
+}
+
+EnsembleCoucou ensemble_coucou_vide() {
+    srand(time(NULL)); // Seed the random number generator
+
+    EnsembleCoucou e = malloc(sizeof(struct TableCoucou));
+    if (e == NULL) {
+        fprintf(stderr, "Erreur: Échec de l'allocation de mémoire.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    e->nb_alveoles = 2;
+    e->alveoles = alveoles_vides(e->nb_alveoles);
+    e->taille = 0;
+    e->graine = ((uint64_t)rand() << 32) ^ (uint64_t)rand();
+    e->nb_reserve = 0;
+
+    return e;
+}
+
+// Puts x in a free case of one of its two buckets if there is one
+static bool placer_directement(EnsembleCoucou e, type_base x, size_t a1, size_t a2) {
+    size_t choix[2] = {a1, a2};
+    for (int k = 0; k < 2; k++) {
+        struct AlveoleCoucou* a = &(e->alveoles[choix[k]]);
+        if (a->occupees != TOUTES_OCCUPEES) {
+            int i = __builtin_ctz(~a->occupees);
+            a->cles[i] = x;
+            a->occupees |= 1u << i;
+            return true;
+        }
+    }
+    return false;
+}
+
+// A bucket reached by the breadth-first search: the element of case
+// `case_parent` of the bucket of node `parent` can move into it
+struct EtapeCoucou {
+    size_t alveole;
+    int parent; // -1 for the two buckets of the element to add
+    int case_parent;
+};
+
+// Looks for the shortest chain of moves that frees a case in a bucket of x,
+// then applies it and puts x in the freed case. Returns false if there is no
+// such chain among the first NB_MAX_ALVEOLES_PARCOURUES buckets.
+static bool placer_par_deplacements(EnsembleCoucou e, type_base x, size_t a1, size_t a2) {
+    struct EtapeCoucou file[NB_MAX_ALVEOLES_PARCOURUES];
+    int nb = 0;
+    file[nb++] = (struct EtapeCoucou){a1, -1, 0};
+    if (a2 != a1) {
+        file[nb++] = (struct EtapeCoucou){a2, -1, 0};
+    }
+
+    for (int tete = 0; tete < nb; tete++) {
+        struct AlveoleCoucou* a = &(e->alveoles[file[tete].alveole]);
+
+        if (a->occupees != TOUTES_OCCUPEES) {
+            // Case libre trouvée : on remonte le chemin en déplaçant chaque
+            // élément vers l'alvéole suivante, en partant de la fin
+            int libre = __builtin_ctz(~a->occupees);
+            int noeud = tete;
+            a->occupees |= 1u << libre;
+            while (file[noeud].parent != -1) {
+                struct EtapeCoucou etape = file[noeud];
+                struct AlveoleCoucou* origine = &(e->alveoles[file[etape.parent].alveole]);
+                e->alveoles[etape.alveole].cles[libre] = origine->cles[etape.case_parent];
+                libre = etape.case_parent;
+                noeud = etape.parent;
+            }
+            e->alveoles[file[noeud].alveole].cles[libre] = x;
+            return true;
+        }
+
+        // Alvéole pleine : chacun de ses éléments pourrait partir dans son autre alvéole
+        for (int i = 0; i < NB_CASES_ALVEOLE && nb < NB_MAX_ALVEOLES_PARCOURUES; i++) {
+            size_t b1, b2;
+            alveoles_de(e, a->cles[i], &b1, &b2);
+            size_t autre = (b1 == file[tete].alveole) ? b2 : b1;
+
+            // Une alvéole déjà dans la file ne doit pas apparaître deux fois dans un chemin
+            bool deja_vue = false;
+            for (int j = 0; j < nb && !deja_vue; j++) {
+                deja_vue = (file[j].alveole == autre);
+            }
+            if (!deja_vue) {
+                file[nb++] = (struct EtapeCoucou){autre, tete, i};
+            }
+        }
+    }
+    return false;
+}
+
+// Places an element known to be absent; returns false if the stash is full
+static bool placer(EnsembleCoucou e, type_base x) {
+    size_t a1, a2;
+    alveoles_de(e, x, &a1, &a2);
+
+    if (placer_directement(e, x, a1, a2) || placer_par_deplacements(e, x, a1, a2)) {
+        return true;
+    }
+    if (e->nb_reserve < TAILLE_RESERVE_COUCOU) {
+        e->reserve[e->nb_reserve] = x;
+        e->nb_reserve++;
+        return true;
+    }
+    return false;
+}
+
+// Rebuilds the table with a given number of buckets (at least 2), doubling it
+// again as long as some element cannot be placed
+static void reconstruire(EnsembleCoucou e, size_t nb_alveoles) {
+    struct AlveoleCoucou* anciennes = e->alveoles;
+    size_t ancien_nb = e->nb_alveoles;
+    type_base reserve[TAILLE_RESERVE_COUCOU];
+    size_t nb_reserve = e->nb_reserve;
+    memcpy(reserve, e->reserve, nb_reserve * sizeof(type_base));
+
+    bool reussi = false;
+    while (!reussi) {
+        e->nb_alveoles = nb_alveoles;
+        e->alveoles = alveoles_vides(nb_alveoles);
+        e->nb_reserve = 0;
+        reussi = true;
+
+        for (size_t i = 0; i < ancien_nb && reussi; i++) {
+            for (uint32_t m = anciennes[i].occupees; m != 0 && reussi; m &= m - 1) {
+                reussi = placer(e, anciennes[i].cles[__builtin_ctz(m)]);
+            }
+        }
+        for (size_t i = 0; i < nb_reserve && reussi; i++) {
+            reussi = placer(e, reserve[i]);
+        }
+
+        if (!reussi) {
+            free(e->alveoles);
+            nb_alveoles *= 2;
+        }
+    }
+    free(anciennes);
+}
+
+bool appartient_coucou(EnsembleCoucou e, type_base x) {
+    size_t a1, a2;
+    alveoles_de(e, x, &a1, &a2);
+
+    // Les deux alvéoles sont lues sans branchement entre elles :
+    // leurs deux défauts de cache se recouvrent
+    if ((masque_egaux(&(e->alveoles[a1]), x) | masque_egaux(&(e->alveoles[a2]), x)) != 0) {
+        return true;
+    }
+    for (size_t i = 0; i < e->nb_reserve; i++) {
+        if (e->reserve[i] == x) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ajouter_coucou(EnsembleCoucou e, type_base x) {
+    if (appartient_coucou(e, x)) {
+        return;
+    }
+
+    while (!placer(e, x)) {
+        // La réserve est pleine : on double le nombre d'alvéoles
+        reconstruire(e, e->nb_alveoles * 2);
+    }
+    e->taille++;
+}
+
+void supprimer_coucou(EnsembleCoucou e, type_base x) {
+    size_t a1, a2;
+    alveoles_de(e, x, &a1, &a2);
+    bool trouve = false;
+
+    size_t choix[2] = {a1, a2};
+    for (int k = 0; k < 2 && !trouve; k++) {
+        uint32_t masque = masque_egaux(&(e->alveoles[choix[k]]), x);
+        if (masque != 0) {
+            e->alveoles[choix[k]].occupees &= ~masque;
+            trouve = true;
+
+            // Une case s'est libérée : un élément de la réserve peut peut-être y aller
+            for (size_t i = 0; i < e->nb_reserve; i++) {
+                size_t b1, b2;
+                alveoles_de(e, e->reserve[i], &b1, &b2);
+                if (placer_directement(e, e->reserve[i], b1, b2)) {
+                    e->nb_reserve--;
+                    e->reserve[i] = e->reserve[e->nb_reserve];
+                    break;
+                }
+            }
+        }
+    }
+    for (size_t i = 0; i < e->nb_reserve && !trouve; i++) {
+        if (e->reserve[i] == x) {
+            e->nb_reserve--;
+            e->reserve[i] = e->reserve[e->nb_reserve];
+            trouve = true;
+        }
+    }
+
+    if (!trouve) {
+        fprintf(stderr, "Erreur: " FORMAT_BASE " n'est pas présent dans l'ensemble.\n", x);
+        exit(EXIT_FAILURE);
+    }
+    e->taille--;
+
+    // Réduire de moitié si les éléments occupent moins du huitième des cases
+    if (e->nb_alveoles > 2 && e->taille < e->nb_alveoles * NB_CASES_ALVEOLE / 8) {
+        reconstruire(e, e->nb_alveoles / 2);
+    }
+}
+
+void liberer_ensemble_coucou(EnsembleCoucou e) {
+    free(e->alveoles);
+    free(e);
+}
+
+Liste ensemble_coucou_vers_liste(EnsembleCoucou e) {
+    Liste l = liste_vide();
+    for (size_t i = 0; i < e->nb_alveoles; i++) {
+        for (uint32_t m = e->alveoles[i].occupees; m != 0; m &= m - 1) {
+            ajouter_en_fin(l, e->alveoles[i].cles[__builtin_ctz(m)]);
+        }
+    }
+    for (size_t i = 0; i < e->nb_reserve; i++) {
+        ajouter_en_fin(l, e->reserve[i]);
+    }
+    return l;
+}
+
+EnsembleCoucou liste_vers_ensemble_coucou(Liste l) {
+    EnsembleCoucou e = ensemble_coucou_vide();
+    for (size_t i = 0; i < longueur(l); i++) {
+        ajouter_coucou(e, element(l, i));
+    }
+    return e;
+}
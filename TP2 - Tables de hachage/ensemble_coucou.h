@@ -0,0 +1,147 @@
+/**
+ * @file ensemble_coucou.h
+ * @author
+ * */
+
+#ifndef __ENSEMBLE__COUCOU__H__
+#define __ENSEMBLE__COUCOU__H__
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "liste.h"
+
+
+/* Description de la structure */
+
+/**
+ * @brief Le nombre de cases d'une alvéole.
+ */
+#define NB_CASES_ALVEOLE 4
+
+/**
+ * @brief Le nombre maximal d'éléments de la réserve ("stash") : les éléments
+ * qu'on n'a pas pu placer dans leurs deux alvéoles.
+ */
+#define TAILLE_RESERVE_COUCOU 4
+
+/**
+ * @brief Le nombre maximal d'alvéoles examinées par la recherche en largeur
+ * d'un ajout (environ 4 niveaux de déplacements).
+ */
+#define NB_MAX_ALVEOLES_PARCOURUES 128
+
+/**
+ * @brief Une alvéole : NB_CASES_ALVEOLE cases, et un masque des cases occupées. \n
+ * Elle est alignée sur 32 octets (et le tableau des alvéoles sur 64) : une
+ * alvéole n'est jamais à cheval sur deux lignes de cache.
+ */
+struct AlveoleCoucou{
+	_Alignas(32) type_base cles[NB_CASES_ALVEOLE]; /**< Les éléments. */
+	uint32_t occupees; /**< Le bit i est à 1 si la case i contient un élément. */
+};
+
+/**
+ * @brief Structure codant une table de hachage "coucou" par alvéoles. \n
+ * Chaque élément a deux alvéoles possibles, données par deux parties
+ * indépendantes de son code de hachage (`hachage_murmur3`) : il est
+ * forcément dans l'une des deux (ou dans la petite réserve). Une recherche
+ * lit donc au plus deux alvéoles, soit deux lignes de cache, quelle que soit
+ * la répartition des clés : le pire cas est O(1). \n
+ * Pour ajouter un élément dont les deux alvéoles sont pleines, on cherche
+ * en largeur (sur au plus NB_MAX_ALVEOLES_PARCOURUES alvéoles) le plus court
+ * chemin de déplacements vers une case libre : chaque élément du chemin
+ * passe dans son autre alvéole. Si aucun chemin n'existe, l'élément va dans
+ * la réserve ; quand la réserve est pleine, on double le nombre d'alvéoles. \n
+ * Avec 2 alvéoles possibles de 4 cases, la table se remplit ainsi à plus de
+ * 90 % avant de devoir grandir. \n
+ * Contrairement à `Ensemble`, il n'y a pas de doublon (un élément a au plus
+ * 8 cases possibles). Le nombre d'alvéoles est une puissance de deux
+ * (au moins 2), et il est divisé par deux quand les éléments occupent moins
+ * du huitième des cases.
+ */
+struct TableCoucou{
+
+	struct AlveoleCoucou* alveoles; /**< Le tableau des alvéoles. */
+
+	size_t nb_alveoles; /**< La taille du tableau **alveoles** (une puissance de deux). */
+
+	size_t taille; /**< Le nombre d'éléments (réserve comprise). */
+
+	uint64_t graine; /**< La graine aléatoire passée à `hachage_murmur3`. */
+
+	type_base reserve[TAILLE_RESERVE_COUCOU]; /**< La réserve. */
+
+	size_t nb_reserve; /**< Le nombre d'éléments dans la réserve. */
+};
+
+/**
+ * @brief Le type "EnsembleCoucou" offre les mêmes opérations que "Ensemble"
+ * (sans doublon), avec des recherches en temps constant dans le pire cas.
+ */
+typedef struct TableCoucou* EnsembleCoucou;
+
+
+/* Prototype des fonctions */
+
+/**
+ * @brief Renvoie un ensemble coucou vide (2 alvéoles). \n
+ * **Complexité :** O(1)
+ * @returns un ensemble vide.
+ */
+EnsembleCoucou ensemble_coucou_vide();
+
+/**
+ * @brief Ajoute un élément (rien ne change s'il est déjà présent). \n
+ * **Complexité :** O(1) (en moyenne et en amorti) ; au plus
+ * NB_MAX_ALVEOLES_PARCOURUES alvéoles parcourues avant de passer à la réserve.
+ * @param e un ensemble coucou,
+ * @param x une valeur qu'on veut ajouter dans e.
+ */
+void ajouter_coucou(EnsembleCoucou e, type_base x);
+
+/**
+ * @brief Détermine si un élément appartient à un ensemble coucou. \n
+ * Lit au plus deux alvéoles (et la réserve si elle n'est pas vide). \n
+ * **Complexité :** O(1) (dans le pire cas)
+ * @param e un ensemble coucou,
+ * @param x une valeur qu'on recherche dans e.
+ * @returns **true** si x appartient dans e, **false** sinon.
+ */
+bool appartient_coucou(EnsembleCoucou e, type_base x);
+
+/**
+ * @brief Supprime un élément. \n
+ * Si jamais les éléments occupent moins du huitième des cases, on divise par
+ * deux le nombre d'alvéoles (sauf s'il devient inférieur à 2). \n
+ * Déclenche une erreur si jamais la valeur n'est pas dans e. \n
+ * **Complexité :** O(1) (en amorti)
+ * @param e un ensemble coucou,
+ * @param x une valeur qu'on veut supprimer de e.
+ */
+void supprimer_coucou(EnsembleCoucou e, type_base x);
+
+/**
+ * @brief Libère la mémoire associée à un ensemble coucou. \n
+ * **Complexité :** O(1)
+ * @param e un ensemble coucou.
+ */
+void liberer_ensemble_coucou(EnsembleCoucou e);
+
+/**
+ * @brief Convertit un ensemble coucou en une liste. \n
+ * **Complexité :** O(nombre d'alvéoles)
+ * @param e un ensemble coucou.
+ * @returns une liste contenant les éléments de e (l'ordre n'a pas d'importance).
+ */
+Liste ensemble_coucou_vers_liste(EnsembleCoucou e);
+
+/**
+ * @brief Convertit une liste en un ensemble coucou (les doublons disparaissent). \n
+ * **Complexité :** O(taille de la liste) (en moyenne)
+ * @param l une liste.
+ * @returns un ensemble coucou contenant les éléments de l.
+ */
+EnsembleCoucou liste_vers_ensemble_coucou(Liste l);
+
+#endif
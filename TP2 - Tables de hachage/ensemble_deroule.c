@@ -0,0 +1,229 @@
+#include "ensemble_deroule.h"
+#include "ensemble.h"
+#include "hachage.h"
+#include "liste.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+_Static_assert(sizeof(struct BlocDeroule) == 64, "un bloc doit occuper une ligne de cache");
+
+// Bucket of x: the high bits of its hash code
+static inline size_t alveole_deroule(EnsembleDeroule e, type_base x) {
+    uint64_t h = hachage_fibonacci(objet_vers_nombre(x), e->graine);
+    return (size_t)(h >> (64 - __builtin_ctzll(e->nb_alveoles)));
+}
+
+// Bit i of the result is set if the key i of the block is x
+static inline uint32_t masque_egaux_bloc(const struct BlocDeroule* b, type_base x) {
+    uint32_t masque = 0;
+#ifdef __SSE2__
+    if (sizeof(type_base) == 4) {
+        // Les 12 clés sont lues en 3 fois 16 octets et comparées d'un coup
+        __m128i cible = _mm_set1_epi32((int)x);
+        for (int k = 0; k < 3; k++) {
+            __m128i cles = _mm_load_si128((const __m128i*)b->cles + k);
+            masque |= (uint32_t)_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(cles, cible))) << (4 * k);
+        }
+        return masque & ((1u << b->nb) - 1);
+    }
+#endif
+    for (size_t i = 0; i < NB_CLES_BLOC; i++) {
+        masque |= (uint32_t)(b->cles[i] == x) << i;
+    }
+    return masque & ((1u << b->nb) - 1);
+}
+
+// Takes a block from the free list, or from the last packet (allocating a
+// new packet if needed)
+static struct BlocDeroule* allouer_bloc(EnsembleDeroule e) {
+    e->nb_blocs++;
+    if (e->libres != NULL) {
+        struct BlocDeroule* b = e->libres;
+        e->libres = b->suivant;
+        return b;
+    }
+
+    if (e->nb_paquets == 0 || e->nb_distribues == NB_BLOCS_PAR_PAQUET) {
+        if (e->nb_paquets == e->capacite_paquets) {
+            e->capacite_paquets = e->capacite_paquets == 0 ? 16 : 2 * e->capacite_paquets;
+            e->paquets = realloc(e->paquets, e->capacite_paquets * sizeof(struct BlocDeroule*));
+        }
+        struct BlocDeroule* paquet = aligned_alloc(64, NB_BLOCS_PAR_PAQUET * sizeof(struct BlocDeroule));
+        if (e->paquets == NULL || paquet == NULL) {
+            fprintf(stderr, "Erreur: Échec de l'allocation de mémoire.\n");
+            exit(EXIT_FAILURE);
+        }
+        e->paquets[e->nb_paquets] = paquet;
+        e->nb_paquets++;
+        e->nb_distribues = 0;
+    }
+
+    e->nb_distribues++;
+    return &(e->paquets[e->nb_paquets - 1][e->nb_distribues - 1]);
+}
+
+// Gives a block back to the free list
+static void liberer_bloc(EnsembleDeroule e, struct BlocDeroule* b) {
+    b->suivant = e->libres;
+    e->libres = b;
+    e->nb_blocs--;
+}
+
+// Allocates an array of empty buckets
+static struct BlocDeroule** table_vide(size_t nb_alveoles) {
+    struct BlocDeroule** table = calloc(nb_alveoles, sizeof(struct BlocDeroule*));
+    if (table == NULL) {
+        fprintf(stderr, "Erreur: Échec de l'allocation de mémoire.\n");
+        exit(EXIT_FAILURE);
+    }
+    return table;
+}
+
+EnsembleDeroule ensemble_deroule_vide() {
+    srand(time(NULL)); // Seed the random number generator
+
+    EnsembleDeroule e = malloc(sizeof(struct TableDeroulee));
+    if (e == NULL) {
+        fprintf(stderr, "Erreur: Échec de l'allocation de mémoire.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    e->nb_alveoles = 8;
+    e->table = table_vide(e->nb_alveoles);
+    e->taille = 0;
+    e->graine = ((uint64_t)rand() << 32) ^ (uint64_t)rand();
+
+    e->paquets = NULL;
+    e->nb_paquets = 0;
+    e->capacite_paquets = 0;
+    e->nb_distribues = 0;
+    e->libres = NULL;
+    e->nb_blocs = 0;
+
+    return e;
+}
+
+// Adds x to the first block of its bucket (a new one if it is full)
+static void inserer_deroule(EnsembleDeroule e, type_base x) {
+    size_t index = alveole_deroule(e, x);
+    struct BlocDeroule* tete = e->table[index];
+
+    if (tete == NULL || tete->nb == NB_CLES_BLOC) {
+        struct BlocDeroule* b = allouer_bloc(e);
+        b->nb = 0;
+        b->suivant = tete;
+        e->table[index] = b;
+        tete = b;
+    }
+    tete->cles[tete->nb] = x;
+    tete->nb++;
+}
+
+// Moves every key into a new table of a given number of buckets. Each block
+// is freed as soon as its keys are copied, so the new lists reuse it.
+static void redimensionner_deroule(EnsembleDeroule e, size_t new_nb_alveoles) {
+    struct BlocDeroule** ancienne_table = e->table;
+    size_t ancien_nb_alveoles = e->nb_alveoles;
+
+    e->table = table_vide(new_nb_alveoles);
+    e->nb_alveoles = new_nb_alveoles;
+
+    for (size_t i = 0; i < ancien_nb_alveoles; i++) {
+        struct BlocDeroule* b = ancienne_table[i];
+        while (b != NULL) {
+            struct BlocDeroule copie = *b;
+            liberer_bloc(e, b);
+            for (uint32_t k = 0; k < copie.nb; k++) {
+                inserer_deroule(e, copie.cles[k]);
+            }
+            b = copie.suivant;
+        }
+    }
+    free(ancienne_table);
+}
+
+void ajouter_deroule(EnsembleDeroule e, type_base x) {
+    if (e->taille >= CHARGE_MAX_DEROULE * e->nb_alveoles) {
+        redimensionner_deroule(e, e->nb_alveoles * 2);
+    }
+    inserer_deroule(e, x);
+    e->taille++;
+}
+
+bool appartient_deroule(EnsembleDeroule e, type_base x) {
+    for (struct BlocDeroule* b = e->table[alveole_deroule(e, x)]; b != NULL; b = b->suivant) {
+        if (masque_egaux_bloc(b, x) != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void supprimer_deroule(EnsembleDeroule e, type_base x) {
+    size_t index = alveole_deroule(e, x);
+    struct BlocDeroule* tete = e->table[index];
+
+    struct BlocDeroule* b = tete;
+    uint32_t masque = 0;
+    while (b != NULL && (masque = masque_egaux_bloc(b, x)) == 0) {
+        b = b->suivant;
+    }
+    if (b == NULL) {
+        fprintf(stderr, "Erreur: " FORMAT_BASE " n'est pas présent dans l'ensemble.\n", x);
+        exit(EXIT_FAILURE);
+    }
+
+    // Le trou est bouché par la dernière clé du premier bloc : seul celui-ci
+    // reste incomplet
+    tete->nb--;
+    b->cles[__builtin_ctz(masque)] = tete->cles[tete->nb];
+    if (tete->nb == 0) {
+        e->table[index] = tete->suivant;
+        liberer_bloc(e, tete);
+    }
+    e->taille--;
+
+    // Réduire de moitié s'il reste moins d'un élément par alvéole
+    if (e->nb_alveoles > 8 && e->taille < e->nb_alveoles) {
+        redimensionner_deroule(e, e->nb_alveoles / 2);
+    }
+}
+
+size_t memoire_deroule(EnsembleDeroule e) {
+    return e->nb_alveoles * sizeof(struct BlocDeroule*) + e->nb_blocs * sizeof(struct BlocDeroule);
+}
+
+void liberer_ensemble_deroule(EnsembleDeroule e) {
+    for (size_t i = 0; i < e->nb_paquets; i++) {
+        free(e->paquets[i]);
+    }
+    free(e->paquets);
+    free(e->table);
+    free(e);
+}
+
+Liste ensemble_deroule_vers_liste(EnsembleDeroule e) {
+    Liste l = liste_vide();
+    for (size_t i = 0; i < e->nb_alveoles; i++) {
+        for (struct BlocDeroule* b = e->table[i]; b != NULL; b = b->suivant) {
+            for (uint32_t k = 0; k < b->nb; k++) {
+                ajouter_en_fin(l, b->cles[k]);
+            }
+        }
+    }
+    return l;
+}
+
+EnsembleDeroule liste_vers_ensemble_deroule(Liste l) {
+    EnsembleDeroule e = ensemble_deroule_vide();
+    for (size_t i = 0; i < longueur(l); i++) {
+        ajouter_deroule(e, element(l, i));
+    }
+    return e;
+}
@@ -0,0 +1,164 @@
+/**
+ * @file ensemble_deroule.h
+ * @author
+ * */
+
+#ifndef __ENSEMBLE__DEROULE__H__
+#define __ENSEMBLE__DEROULE__H__
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "liste.h"
+
+
+/* Description de la structure */
+
+/**
+ * @brief Le nombre de clés d'un bloc : les clés occupent les 48 premiers
+ * octets d'une ligne de cache (12 entiers de 32 bits, ou 6 de 64 bits).
+ */
+#define NB_CLES_BLOC (48 / sizeof(type_base))
+
+/**
+ * @brief Le nombre de blocs alloués d'un coup (un paquet fait ainsi 4 Kio).
+ */
+#define NB_BLOCS_PAR_PAQUET 64
+
+/**
+ * @brief Le nombre moyen de clés par alvéole à partir duquel on double le
+ * nombre d'alvéoles (on le divise par deux en dessous d'une clé par alvéole). \n
+ * Une alvéole contient alors entre 4 et 8 clés en moyenne : presque toujours
+ * un seul bloc, bien rempli.
+ */
+#define CHARGE_MAX_DEROULE 8
+
+/**
+ * @brief Un maillon d'une liste chaînée "déroulée" : il occupe exactement une
+ * ligne de cache (64 octets, et il est aligné sur 64 octets). \n
+ * Dans une liste, seul le premier bloc peut être incomplet : les autres
+ * contiennent toujours NB_CLES_BLOC clés.
+ */
+struct BlocDeroule{
+	_Alignas(64) type_base cles[NB_CLES_BLOC]; /**< Les clés (les **nb** premières cases). */
+	uint32_t nb; /**< Le nombre de clés du bloc (entre 1 et NB_CLES_BLOC). */
+	struct BlocDeroule* suivant; /**< Le bloc suivant de la liste, ou NULL. */
+};
+
+/**
+ * @brief Structure codant une table de hachage par listes chaînées déroulées. \n
+ * Au lieu d'un noeud (une clé et un pointeur, soit 16 octets pour 4 utiles)
+ * par élément, chaque alvéole est une liste de blocs de NB_CLES_BLOC clés :
+ * une recherche lit une ligne de cache et compare toutes ses clés d'un coup
+ * (avec SSE2 et des clés de 32 bits : 3 comparaisons de 4 clés, sans branchement), au lieu de suivre
+ * un pointeur par clé. \n
+ * Comme un bloc est plus gros qu'un noeud, les alvéoles sont bien plus remplies
+ * que dans `Ensemble` (entre 4 et 8 clés en moyenne, voir CHARGE_MAX_DEROULE). \n
+ * Les blocs viennent de paquets de NB_BLOCS_PAR_PAQUET blocs ; les blocs libérés
+ * sont réutilisés en priorité. \n
+ * Comme dans `Ensemble`, les doublons sont autorisés. Le nombre d'alvéoles est
+ * une puissance de deux (au moins 8) ; la fonction de hachage est `hachage_fibonacci`.
+ */
+struct TableDeroulee{
+
+	struct BlocDeroule** table; /**< Le tableau des alvéoles (le premier bloc de chaque liste). */
+
+	size_t nb_alveoles; /**< La taille du tableau **table** (une puissance de deux). */
+
+	size_t taille; /**< Le nombre d'éléments. */
+
+	uint64_t graine; /**< La graine aléatoire passée à `hachage_fibonacci`. */
+
+	struct BlocDeroule** paquets; /**< Les paquets de blocs alloués. */
+
+	size_t nb_paquets; /**< Le nombre de paquets alloués. */
+
+	size_t capacite_paquets; /**< La taille du tableau **paquets**. */
+
+	size_t nb_distribues; /**< Le nombre de blocs du dernier paquet déjà distribués. */
+
+	struct BlocDeroule* libres; /**< Les blocs libérés, chaînés par leur champ **suivant**. */
+
+	size_t nb_blocs; /**< Le nombre de blocs utilisés par les listes. */
+};
+
+/**
+ * @brief Le type "EnsembleDeroule" offre les mêmes opérations que "Ensemble",
+ * avec des listes chaînées de blocs d'une ligne de cache.
+ */
+typedef struct TableDeroulee* EnsembleDeroule;
+
+
+/* Prototype des fonctions */
+
+/**
+ * @brief Renvoie un ensemble déroulé vide (8 alvéoles). \n
+ * **Complexité :** O(1)
+ * @returns un ensemble vide.
+ */
+EnsembleDeroule ensemble_deroule_vide();
+
+/**
+ * @brief Ajoute un élément (dans le premier bloc de son alvéole, ou dans un
+ * nouveau bloc placé en tête si celui-ci est plein). \n
+ * **Complexité :** O(1) (en amorti)
+ * @param e un ensemble déroulé,
+ * @param x une valeur qu'on veut ajouter dans e.
+ */
+void ajouter_deroule(EnsembleDeroule e, type_base x);
+
+/**
+ * @brief Détermine si un élément appartient à un ensemble déroulé. \n
+ * **Complexité :** O(1) (en moyenne)
+ * @param e un ensemble déroulé,
+ * @param x une valeur qu'on recherche dans e.
+ * @returns **true** si x appartient dans e, **false** sinon.
+ */
+bool appartient_deroule(EnsembleDeroule e, type_base x);
+
+/**
+ * @brief Supprime une occurrence d'un élément : elle est remplacée par la
+ * dernière clé du premier bloc de l'alvéole (qui est libéré s'il devient vide). \n
+ * Si jamais il reste moins d'un élément par alvéole, on divise par deux le
+ * nombre d'alvéoles (sauf s'il devient inférieur à 8). \n
+ * Déclenche une erreur si jamais la valeur n'est pas dans e. \n
+ * **Complexité :** O(1) (en moyenne et en amorti)
+ * @param e un ensemble déroulé,
+ * @param x une valeur qu'on veut supprimer de e.
+ */
+void supprimer_deroule(EnsembleDeroule e, type_base x);
+
+/**
+ * @brief Renvoie la mémoire utilisée par un ensemble déroulé : les alvéoles et
+ * les blocs utilisés (sans les blocs libres ni la structure elle-même). \n
+ * **Complexité :** O(1)
+ * @param e un ensemble déroulé.
+ * @returns un nombre d'octets.
+ */
+size_t memoire_deroule(EnsembleDeroule e);
+
+/**
+ * @brief Libère la mémoire associée à un ensemble déroulé (ses paquets de
+ * blocs, sa table et la structure elle-même). \n
+ * **Complexité :** O(nombre de paquets)
+ * @param e un ensemble déroulé.
+ */
+void liberer_ensemble_deroule(EnsembleDeroule e);
+
+/**
+ * @brief Convertit un ensemble déroulé en une liste. \n
+ * **Complexité :** O(taille de l'ensemble + nombre d'alvéoles)
+ * @param e un ensemble déroulé.
+ * @returns une liste contenant les éléments de e (l'ordre n'a pas d'importance).
+ */
+Liste ensemble_deroule_vers_liste(EnsembleDeroule e);
+
+/**
+ * @brief Convertit une liste en un ensemble déroulé. \n
+ * **Complexité :** O(taille de la liste) (en moyenne)
+ * @param l une liste.
+ * @returns un ensemble déroulé contenant les mêmes éléments que l.
+ */
+EnsembleDeroule liste_vers_ensemble_deroule(Liste l);
+
+#endif
@@ -0,0 +1,261 @@
+#include "ensemble_groupe.h"
+#include "ensemble.h"
+#include "hachage.h"
+#include "liste.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <sys/mman.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// The murmur3 finaliser is used: every bit of the code depends on every bit
+// of the key, so the 7 low bits (control byte) and the high bits (group
+// number) are independent.
+static inline uint64_t hacher_eg(EnsembleGroupe e, type_base x) {
+    return hachage_murmur3(objet_vers_nombre(x), e->graine);
+}
+
+// Bit i of the result is set if the control byte i of the group equals h2
+static inline unsigned masque_egaux(const int8_t* groupe, int8_t h2) {
+#ifdef __SSE2__
+    __m128i octets = _mm_loadu_si128((const __m128i*)groupe);
+    return (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(octets, _mm_set1_epi8(h2)));
+#else
+    unsigned masque = 0;
+    for (int i = 0; i < TAILLE_GROUPE; i++) {
+        if (groupe[i] == h2) {
+            masque |= 1u << i;
+        }
+    }
+    return masque;
+#endif
+}
+
+// Bit i of the result is set if the case i of the group is empty or deleted
+// (both control bytes are negative, unlike the hash fragments)
+static inline unsigned masque_libres(const int8_t* groupe) {
+#ifdef __SSE2__
+    return (unsigned)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)groupe));
+#else
+    unsigned masque = 0;
+    for (int i = 0; i < TAILLE_GROUPE; i++) {
+        if (groupe[i] < 0) {
+            masque |= 1u << i;
+        }
+    }
+    return masque;
+#endif
+}
+
+// Allocates empty arrays of a given number of cases (a power of two, at least TAILLE_GROUPE)
+static void allouer_cases(EnsembleGroupe e, size_t nb_cases) {
+    e->nb_cases = nb_cases;
+    e->controle = malloc(nb_cases * sizeof(int8_t));
+    e->cles = malloc(nb_cases * sizeof(type_base));
+
+    if (e->controle == NULL || e->cles == NULL) {
+        fprintf(stderr, "Erreur: Échec de l'allocation de mémoire.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    memset(e->controle, CASE_VIDE, nb_cases);
+    e->nb_supprimees = 0;
+}
+
+// Returns the index of the first empty or deleted case on the probe sequence of h
+static size_t trouver_case_libre(EnsembleGroupe e, uint64_t h) {
+    size_t masque_groupes = e->nb_cases / TAILLE_GROUPE - 1;
+    size_t g = (h >> 7) & masque_groupes;
+
+    for (size_t pas = 1; ; pas++) {
+        unsigned libres = masque_libres(e->controle + g * TAILLE_GROUPE);
+        if (libres != 0) {
+            return g * TAILLE_GROUPE + __builtin_ctz(libres);
+        }
+        g = (g + pas) & masque_groupes;
+    }
+}
+
+// Returns the index of a case containing x, or nb_cases if x is not in the table
+static size_t trouver_case(EnsembleGroupe e, type_base x) {
+    uint64_t h = hacher_eg(e, x);
+    int8_t h2 = (int8_t)(h & 0x7F);
+    size_t masque_groupes = e->nb_cases / TAILLE_GROUPE - 1;
+    size_t g = (h >> 7) & masque_groupes;
+
+    for (size_t pas = 1; ; pas++) {
+        const int8_t* groupe = e->controle + g * TAILLE_GROUPE;
+        unsigned candidats = masque_egaux(groupe, h2);
+
+        while (candidats != 0) {
+            size_t i = g * TAILLE_GROUPE + __builtin_ctz(candidats);
+            if (e->cles[i] == x) {
+                return i;
+            }
+            candidats &= candidats - 1;
+        }
+
+        // A group with an empty case ends every probe sequence passing through it
+        if (masque_egaux(groupe, CASE_VIDE) != 0) {
+            return e->nb_cases;
+        }
+        g = (g + pas) & masque_groupes;
+    }
+}
+
+// Copies the cases of a table loaded from a file into allocated arrays,
+// so that they can be modified
+static void copier_projection(EnsembleGroupe e) {
+    int8_t* controle = malloc(e->nb_cases * sizeof(int8_t));
+    type_base* cles = malloc(e->nb_cases * sizeof(type_base));
+
+    if (controle == NULL || cles == NULL) {
+        fprintf(stderr, "Erreur: Échec de l'allocation de mémoire.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    memcpy(controle, e->controle, e->nb_cases * sizeof(int8_t));
+    memcpy(cles, e->cles, e->nb_cases * sizeof(type_base));
+    munmap(e->projection, e->taille_projection);
+
+    e->controle = controle;
+    e->cles = cles;
+    e->projection = NULL;
+    e->taille_projection = 0;
+}
+
+// Rebuilds the table with a given number of cases (also removes the deleted cases)
+static void reconstruire(EnsembleGroupe e, size_t nb_cases) {
+    int8_t* ancien_controle = e->controle;
+    type_base* anciennes_cles = e->cles;
+    size_t ancien_nb_cases = e->nb_cases;
+
+    void* projection = e->projection;
+
+    allouer_cases(e, nb_cases);
+
+    for (size_t i = 0; i < ancien_nb_cases; i++) {
+        if (ancien_controle[i] >= 0) {
+            uint64_t h = hacher_eg(e, anciennes_cles[i]);
+            size_t j = trouver_case_libre(e, h);
+            e->controle[j] = (int8_t)(h & 0x7F);
+            e->cles[j] = anciennes_cles[i];
+        }
+    }
+
+    if (projection != NULL) {
+        munmap(projection, e->taille_projection);
+        e->projection = NULL;
+        e->taille_projection = 0;
+    } else {
+        free(ancien_controle);
+        free(anciennes_cles);
+    }
+}
+
+EnsembleGroupe ensemble_groupe_vide() {
+    srand(time(NULL)); // Seed the random number generator
+
+    EnsembleGroupe e = malloc(sizeof(struct TableGroupes));
+    if (e == NULL) {
+        fprintf(stderr, "Erreur: Échec de l'allocation de mémoire.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    allouer_cases(e, TAILLE_GROUPE);
+    e->taille = 0;
+    e->graine = ((uint64_t)rand() << 32) ^ (uint64_t)rand();
+    e->projection = NULL;
+    e->taille_projection = 0;
+
+    return e;
+}
+
+void ajouter_eg(EnsembleGroupe e, type_base x) {
+
+    // Les cases occupées ou supprimées ne doivent pas dépasser les 7/8 des cases
+    if ((e->taille + e->nb_supprimees + 1) * 8 > e->nb_cases * 7) {
+        // Si ce sont surtout des cases supprimées, on nettoie sans agrandir
+        size_t nb_cases = e->nb_cases;
+        if ((e->taille + 1) * 16 > nb_cases * 7) {
+            nb_cases *= 2;
+        }
+        reconstruire(e, nb_cases);
+    } else if (e->projection != NULL) {
+        copier_projection(e);
+    }
+
+    uint64_t h = hacher_eg(e, x);
+    size_t i = trouver_case_libre(e, h);
+
+    if (e->controle[i] == CASE_SUPPRIMEE) {
+        e->nb_supprimees--;
+    }
+    e->controle[i] = (int8_t)(h & 0x7F);
+    e->cles[i] = x;
+    e->taille++;
+}
+
+bool appartient_eg(EnsembleGroupe e, type_base x) {
+    return trouver_case(e, x) != e->nb_cases;
+}
+
+void supprimer_eg(EnsembleGroupe e, type_base x) {
+    size_t i = trouver_case(e, x);
+
+    if (i == e->nb_cases) {
+        fprintf(stderr, "Erreur: " FORMAT_BASE " n'est pas présent dans l'ensemble.\n", x);
+        exit(EXIT_FAILURE);
+    }
+    if (e->projection != NULL) {
+        copier_projection(e);
+    }
+
+    // Si le groupe contient déjà une case vide, aucune recherche n'a pu
+    // continuer au-delà de ce groupe : la case peut redevenir vide.
+    const int8_t* groupe = e->controle + (i / TAILLE_GROUPE) * TAILLE_GROUPE;
+    if (masque_egaux(groupe, CASE_VIDE) != 0) {
+        e->controle[i] = CASE_VIDE;
+    } else {
+        e->controle[i] = CASE_SUPPRIMEE;
+        e->nb_supprimees++;
+    }
+    e->taille--;
+
+    // Réduire de moitié si le nombre d'éléments devient inférieur au huitième des cases
+    if (e->nb_cases > TAILLE_GROUPE && e->taille < e->nb_cases / 8) {
+        reconstruire(e, e->nb_cases / 2);
+    }
+}
+
+void liberer_ensemble_groupe(EnsembleGroupe e) {
+    if (e->projection != NULL) {
+        munmap(e->projection, e->taille_projection);
+    } else {
+        free(e->controle);
+        free(e->cles);
+    }
+    free(e);
+}
+
+Liste ensemble_groupe_vers_liste(EnsembleGroupe e) {
+    Liste nouvelle_liste = liste_vide();
+    for (size_t i = 0; i < e->nb_cases; i++) {
+        if (e->controle[i] >= 0) {
+            ajouter_en_fin(nouvelle_liste, e->cles[i]);
+        }
+    }
+    return nouvelle_liste;
+}
+
+EnsembleGroupe liste_vers_ensemble_groupe(Liste l) {
+    EnsembleGroupe e = ensemble_groupe_vide();
+    for (size_t i = 0; i < longueur(l); i++) {
+        ajouter_eg(e, element(l, i));
+    }
+    return e;
+}
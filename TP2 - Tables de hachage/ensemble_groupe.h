@@ -0,0 +1,152 @@
+/**
+ * @file ensemble_groupe.h
+ * @author
+ * */
+
+#ifndef __ENSEMBLE__GROUPE__H__
+#define __ENSEMBLE__GROUPE__H__
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "liste.h"
+
+
+/* Description de la structure */
+
+/**
+ * @brief Le nombre de cases examinées en une seule comparaison
+ * (la largeur d'un registre SSE2, en octets).
+ */
+#define TAILLE_GROUPE 16
+
+/**
+ * @brief Octet de contrôle d'une case qui n'a jamais été occupée.
+ */
+#define CASE_VIDE ((int8_t) -128)
+
+/**
+ * @brief Octet de contrôle d'une case dont l'élément a été supprimé
+ * (une "pierre tombale" : la recherche doit continuer après elle).
+ */
+#define CASE_SUPPRIMEE ((int8_t) -2)
+
+/**
+ * @brief Structure codant une table de hachage à adressage ouvert
+ * "à la SwissTable" \n
+ * Les éléments sont rangés directement dans un tableau de cases,
+ * découpé en groupes de TAILLE_GROUPE cases consécutives.
+ * À chaque case est associé un octet de contrôle qui vaut :
+ * @li CASE_VIDE si la case n'a jamais été utilisée,
+ * @li CASE_SUPPRIMEE si son élément a été supprimé,
+ * @li les 7 bits de poids faible du code de hachage de l'élément sinon
+ * (un nombre entre 0 et 127).
+ *
+ * Les bits restants du code de hachage donnent le groupe de départ ;
+ * on sonde ensuite les groupes de manière triangulaire (+1, +2, +3...).
+ * Une seule comparaison SSE2 des 16 octets de contrôle d'un groupe
+ * élimine presque tous les candidats avant de regarder les éléments. \n
+ * Comme pour `Ensemble`, on autorisera à avoir des doublons.
+ * Le nombre de cases est une puissance de deux (au moins TAILLE_GROUPE),
+ * et les cases occupées ou supprimées représentent au plus les 7/8 des cases. \n
+ * Une table chargée depuis un fichier (`charger_ensemble_groupe`, voir
+ * `instantane.h`) lit ses cases directement dans le fichier projeté en mémoire,
+ * en lecture seule : le premier ajout ou la première suppression les recopie
+ * d'abord dans des tableaux alloués.
+ */
+struct TableGroupes{
+
+	int8_t* controle; /**< Le tableau des octets de contrôle (un par case). */
+
+	type_base* cles; /**< Le tableau des éléments (une case par élément). */
+
+	size_t nb_cases; /**< La taille des tableaux **controle** et **cles**. */
+
+	size_t taille; /**< Le nombre d'éléments dans la table. */
+
+	size_t nb_supprimees; /**< Le nombre de cases marquées CASE_SUPPRIMEE. */
+
+	uint64_t graine; /**< Une graine aléatoire mélangée à chaque clé avant hachage. */
+
+	void* projection; /**< L'adresse du fichier projeté en mémoire dans lequel pointent
+	* **controle** et **cles**, ou NULL s'ils ont été alloués. */
+
+	size_t taille_projection; /**< La taille (en octets) de la projection. */
+};
+
+/**
+ * @brief Le type "EnsembleGroupe" offre les mêmes opérations que "Ensemble",
+ * mais avec une table à sondage par groupes.
+ */
+typedef struct TableGroupes* EnsembleGroupe;
+
+
+/* Prototype des fonctions */
+
+/**
+ * @brief Renvoie un ensemble sans élément à l'intérieur. \n
+ * Le nombre de cases initial est fixé à 16 (un groupe).
+ * **Complexité :** O(1)
+ * @returns un ensemble vide
+ */
+EnsembleGroupe ensemble_groupe_vide();
+
+/**
+ * @brief Ajoute un élément dans la table. \n
+ * On s'autorisera à avoir des doublons. \n
+ * Si jamais les cases occupées ou supprimées dépassent les 7/8 des cases,
+ * on reconstruit la table (en doublant le nombre de cases si besoin).
+ * **Complexité :** O(1) (en amorti)
+ * @param e un ensemble,
+ * @param x une valeur qu'on veut ajouter dans e.
+ */
+void ajouter_eg(EnsembleGroupe e, type_base x);
+
+/**
+ * @brief Détermine si un élément appartient à un ensemble \n
+ * **Complexité :** O(1) (en moyenne)
+ * @param e un ensemble,
+ * @param x une valeur qu'on recherche dans e.
+ * @returns **true** si x appartient dans e, **false** sinon.
+ */
+bool appartient_eg(EnsembleGroupe e, type_base x);
+
+/**
+ * @brief Supprime une occurrence d'un élément dans la table. \n
+ * Si jamais le nombre d'éléments devient inférieur au huitième du nombre de cases,
+ * on réduit de moitié le nombre de cases (sauf s'il devient inférieur à 16). \n
+ * Déclenche une erreur si jamais la valeur n'est pas dans e. \n
+ * **Complexité :** O(1) (en moyenne et en amorti)
+ * @param e un ensemble,
+ * @param x une valeur dont on veut supprimer une occurrence dans e.
+ */
+void supprimer_eg(EnsembleGroupe e, type_base x);
+
+/**
+ * @brief Libère la mémoire associée à un ensemble (ou supprime la projection
+ * de son fichier). \n
+ * **Complexité :** O(1)
+ * @param e un ensemble.
+ */
+void liberer_ensemble_groupe(EnsembleGroupe e);
+
+/**
+ * @brief Convertit un ensemble en une liste. \n
+ * L'ensemble n'est pas modifié. \n
+ * **Complexité :** O(nombre de cases)
+ * @param e un ensemble.
+ * @returns une liste contenant les mêmes éléments que **e** (l'ordre n'a
+ * pas d'importance).
+ */
+Liste ensemble_groupe_vers_liste(EnsembleGroupe e);
+
+/**
+ * @brief Convertit une liste en un ensemble. \n
+ * La liste n'est pas modifiée. \n
+ * **Complexité :** O(taille de la liste)
+ * @param l une liste.
+ * @returns un ensemble contenant les mêmes élements que **l**.
+ */
+EnsembleGroupe liste_vers_ensemble_groupe(Liste l);
+
+#endif
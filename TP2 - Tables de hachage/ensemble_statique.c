@@ -0,0 +1,244 @@
+#include "ensemble_statique.h"
+#include "ensemble.h"
+#include "hachage.h"
+#include "liste.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+__extension__ typedef unsigned __int128 uint128;
+
+// x * n / 2^64: maps a uniform 64-bit value to [0, n[ without a division
+static inline size_t reduire(uint64_t x, size_t n) {
+    return (size_t)(((uint128)x * n) >> 64);
+}
+
+// Bucket of a hash code: if its low 32 bits are below 60 % of 2^32, one of
+// the first nb_seaux_denses buckets, otherwise one of the others (the high
+// bits choose which)
+static inline size_t seau_de(EnsembleStatique s, uint64_t code) {
+    uint64_t haut = code >> 32 << 32;
+    if ((uint32_t)code < 2576980377u) {
+        return reduire(haut, s->nb_seaux_denses);
+    }
+    return s->nb_seaux_denses + reduire(haut, s->nb_seaux - s->nb_seaux_denses);
+}
+
+// Case of a hash code with the pilot of its bucket, among nb_cases: the code
+// is mixed again with the pilot, so each pilot gives independent cases
+static inline size_t case_de(EnsembleStatique s, uint64_t code, uint16_t pilote) {
+    return reduire(hachage_murmur3(code, (uint64_t)pilote * 0x9E3779B97F4A7C15ULL), s->nb_cases);
+}
+
+// A key during the build, with its hash code
+struct CleHachee {
+    uint64_t code;
+    type_base cle;
+};
+
+static int comparer_codes(const void* a, const void* b) {
+    uint64_t x = ((const struct CleHachee*)a)->code, y = ((const struct CleHachee*)b)->code;
+    return (x > y) - (x < y);
+}
+
+static void* allouer(size_t taille) {
+    void* p = malloc(taille == 0 ? 1 : taille);
+    if (p == NULL) {
+        fprintf(stderr, "Erreur: Échec de l'allocation de mémoire.\n");
+        exit(EXIT_FAILURE);
+    }
+    return p;
+}
+
+// Tries to build s from n keys with the seed s->graine. Returns false if two
+// distinct keys share a code, or if a bucket has no suitable pilot.
+static bool construire(EnsembleStatique s, const type_base* cles, size_t n) {
+    // Les clés, triées par seau (tri par dénombrement), puis par code dans chaque seau
+    size_t* debuts = calloc(s->nb_seaux + 1, sizeof(size_t));
+    struct CleHachee* hachees = allouer(n * sizeof(struct CleHachee));
+    if (debuts == NULL) {
+        fprintf(stderr, "Erreur: Échec de l'allocation de mémoire.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (size_t i = 0; i < n; i++) {
+        debuts[seau_de(s, hachage_murmur3(objet_vers_nombre(cles[i]), s->graine)) + 1]++;
+    }
+    for (size_t b = 0; b < s->nb_seaux; b++) {
+        debuts[b + 1] += debuts[b];
+    }
+    size_t* positions = allouer(s->nb_seaux * sizeof(size_t));
+    memcpy(positions, debuts, s->nb_seaux * sizeof(size_t));
+    for (size_t i = 0; i < n; i++) {
+        uint64_t code = hachage_murmur3(objet_vers_nombre(cles[i]), s->graine);
+        size_t b = seau_de(s, code);
+        hachees[positions[b]].code = code;
+        hachees[positions[b]].cle = cles[i];
+        positions[b]++;
+    }
+
+    // Doublons : même code et même clé ; deux clés distinctes de même code
+    // n'auraient jamais de cases distinctes
+    bool ok = true;
+    size_t taille_max = 0;
+    size_t nb = 0;
+    for (size_t b = 0; b < s->nb_seaux && ok; b++) {
+        size_t debut = nb;
+        qsort(hachees + debuts[b], debuts[b + 1] - debuts[b], sizeof(struct CleHachee), comparer_codes);
+        for (size_t i = debuts[b]; i < debuts[b + 1]; i++) {
+            if (i > debuts[b] && hachees[i].code == hachees[i - 1].code) {
+                ok = (hachees[i].cle == hachees[i - 1].cle);
+                continue;
+            }
+            hachees[nb] = hachees[i];
+            nb++;
+        }
+        debuts[b] = debut; // Les seaux sont recopiés à gauche, sans les doublons
+        taille_max = nb - debut > taille_max ? nb - debut : taille_max;
+    }
+    debuts[s->nb_seaux] = nb;
+    s->nb_cles = nb;
+    s->nb_cases = (size_t)((double)nb / TAUX_REMPLISSAGE) + 1;
+
+    // Les seaux, du plus gros au plus petit (tri par dénombrement sur la taille)
+    size_t* nb_par_taille = calloc(taille_max + 2, sizeof(size_t));
+    size_t* ordre = allouer(s->nb_seaux * sizeof(size_t));
+    if (nb_par_taille == NULL) {
+        fprintf(stderr, "Erreur: Échec de l'allocation de mémoire.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (size_t b = 0; b < s->nb_seaux && ok; b++) {
+        nb_par_taille[taille_max - (debuts[b + 1] - debuts[b]) + 1]++;
+    }
+    for (size_t t = 0; t <= taille_max; t++) {
+        nb_par_taille[t + 1] += nb_par_taille[t];
+    }
+    for (size_t b = 0; b < s->nb_seaux && ok; b++) {
+        ordre[nb_par_taille[taille_max - (debuts[b + 1] - debuts[b])]++] = b;
+    }
+
+    // Pour chaque seau, le premier pilote qui envoie ses clés dans des cases libres
+    uint64_t* prises = calloc(s->nb_cases / 64 + 1, sizeof(uint64_t));
+    size_t* cases = allouer((taille_max + 1) * sizeof(size_t));
+    if (prises == NULL) {
+        fprintf(stderr, "Erreur: Échec de l'allocation de mémoire.\n");
+        exit(EXIT_FAILURE);
+    }
+    memset(s->pilotes, 0, s->nb_seaux * sizeof(uint16_t));
+    for (size_t k = 0; k < s->nb_seaux && ok; k++) {
+        size_t b = ordre[k];
+        size_t taille = debuts[b + 1] - debuts[b];
+        if (taille == 0) {
+            break; // Les seaux suivants sont vides aussi
+        }
+
+        bool place = false;
+        for (uint32_t pilote = 0; pilote <= PILOTE_MAX && !place; pilote++) {
+            // On prend les cases au fur et à mesure, et on les rend en cas d'échec
+            size_t j = 0;
+            for (; j < taille; j++) {
+                size_t c = case_de(s, hachees[debuts[b] + j].code, (uint16_t)pilote);
+                if ((prises[c / 64] >> (c % 64)) & 1) {
+                    break;
+                }
+                prises[c / 64] |= (uint64_t)1 << (c % 64);
+                cases[j] = c;
+            }
+            place = (j == taille);
+            while (!place && j > 0) {
+                j--;
+                prises[cases[j] / 64] &= ~((uint64_t)1 << (cases[j] % 64));
+            }
+            if (place) {
+                s->pilotes[b] = (uint16_t)pilote;
+                for (j = 0; j < taille; j++) {
+                    s->cles[cases[j]] = hachees[debuts[b] + j].cle;
+                }
+            }
+        }
+        ok = place;
+    }
+
+    // Les clés des cases d'indice au moins n vont dans les cases libres d'indice
+    // inférieur à n (il y en a exactement autant), dans l'ordre
+    size_t libre = 0;
+    for (size_t c = nb; c < s->nb_cases && ok; c++) {
+        s->renvois[c - nb] = 0;
+        if ((prises[c / 64] >> (c % 64)) & 1) {
+            while ((prises[libre / 64] >> (libre % 64)) & 1) {
+                libre++;
+            }
+            s->cles[libre] = s->cles[c];
+            s->renvois[c - nb] = libre;
+            libre++;
+        }
+    }
+
+    free(cases);
+    free(prises);
+    free(ordre);
+    free(nb_par_taille);
+    free(positions);
+    free(hachees);
+    free(debuts);
+    return ok;
+}
+
+EnsembleStatique ensemble_statique_depuis_liste(Liste l) {
+    srand(time(NULL)); // Seed the random number generator
+
+    EnsembleStatique s = allouer(sizeof(struct TableStatique));
+    size_t n = longueur(l);
+
+    // Environ CONSTANTE_SEAUX * n / log2(n) seaux, dont 30 % reçoivent 60 % des clés
+    size_t log_n = 1;
+    while (((size_t)1 << log_n) < n) {
+        log_n++;
+    }
+    s->nb_seaux = CONSTANTE_SEAUX * n / log_n + 2;
+    s->nb_seaux_denses = (s->nb_seaux * 3 + 9) / 10; // Entre 1 et nb_seaux - 1
+    size_t nb_cases_max = (size_t)((double)n / TAUX_REMPLISSAGE) + 1;
+    s->cles = allouer(nb_cases_max * sizeof(type_base));
+    s->renvois = allouer((nb_cases_max - n + 1) * sizeof(size_t));
+    s->pilotes = allouer(s->nb_seaux * sizeof(uint16_t));
+
+    do {
+        s->graine = ((uint64_t)rand() << 32) ^ (uint64_t)rand();
+    } while (!construire(s, l->tableau, n));
+
+    // Sans les doublons, il peut y avoir moins de clés que d'éléments dans la liste
+    s->cles = realloc(s->cles, (s->nb_cles + 1) * sizeof(type_base));
+    if (s->cles == NULL) {
+        fprintf(stderr, "Erreur: Échec de l'allocation de mémoire.\n");
+        exit(EXIT_FAILURE);
+    }
+    return s;
+}
+
+int64_t indice_statique(EnsembleStatique s, type_base x) {
+    if (s->nb_cles == 0) {
+        return -1;
+    }
+    uint64_t code = hachage_murmur3(objet_vers_nombre(x), s->graine);
+    size_t c = case_de(s, code, s->pilotes[seau_de(s, code)]);
+    if (c >= s->nb_cles) {
+        c = s->renvois[c - s->nb_cles];
+    }
+    return s->cles[c] == x ? (int64_t)c : -1;
+}
+
+bool appartient_statique(EnsembleStatique s, type_base x) {
+    return indice_statique(s, x) != -1;
+}
+
+size_t memoire_statique(EnsembleStatique s) {
+    return s->nb_cles * sizeof(type_base) + s->nb_seaux * sizeof(uint16_t)
+           + (s->nb_cases - s->nb_cles) * sizeof(size_t);
+}
+
+void liberer_ensemble_statique(EnsembleStatique s) {
+    free(s->cles);
+    free(s->renvois);
+    free(s->pilotes);
+    free(s);
+}
@@ -0,0 +1,131 @@
+/**
+ * @file ensemble_statique.h
+ * @author
+ * */
+
+#ifndef __ENSEMBLE__STATIQUE__H__
+#define __ENSEMBLE__STATIQUE__H__
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "liste.h"
+
+
+/* Description de la structure */
+
+/**
+ * @brief Le nombre de seaux est `CONSTANTE_SEAUX * n / log2(n)` pour n clés :
+ * plus il y en a, plus la construction est rapide, mais plus les pilotes
+ * prennent de place (16 bits par seau).
+ */
+#define CONSTANTE_SEAUX 5
+
+/**
+ * @brief La proportion de cases utilisées pendant la construction : les n clés
+ * sont placées dans `n / TAUX_REMPLISSAGE` cases, pour que les derniers seaux
+ * trouvent encore des cases libres (voir **renvois**).
+ */
+#define TAUX_REMPLISSAGE 0.99
+
+/**
+ * @brief Le plus grand pilote essayé pour un seau (les pilotes tiennent sur 16 bits).
+ * Si aucun ne convient, la construction recommence avec une autre graine.
+ */
+#define PILOTE_MAX 65535
+
+/**
+ * @brief Structure codant un ensemble "statique" : construit une fois pour toutes
+ * à partir d'une liste, il ne permet plus que des recherches. \n
+ * Il repose sur une fonction de hachage parfaite minimale (à la PTHash,
+ * Pibiri et Trani 2021) : chacune des n clés a sa propre case dans un tableau
+ * de n cases, sans collision ni case vide. \n
+ * Une clé est hachée une fois (`hachage_murmur3`) ; le code choisit un seau
+ * (60 % des clés vont dans 30 % des seaux, pour que les gros seaux soient placés
+ * en premier quand la table est encore vide), et chaque seau a un "pilote" :
+ * la case d'une clé est `code * nb_cases / 2^64` après avoir mélangé `code` avec son pilote.
+ * À la construction, les seaux sont traités du plus gros au plus petit, et on
+ * cherche pour chacun le premier pilote qui envoie toutes ses clés dans des
+ * cases libres. \n
+ * Il y a un peu plus de cases que de clés (voir TAUX_REMPLISSAGE) ; à la fin,
+ * les clés tombées dans une case d'indice au moins n sont déplacées dans les
+ * cases libres d'indice inférieur à n, et **renvois** garde leur nouvelle case
+ * (comme dans PTHash) : le tableau des clés n'a aucun trou. \n
+ * Une recherche fait donc un hachage, une lecture de pilote, un mélange et une
+ * seule comparaison de clé, sans jamais sonder une deuxième case (environ 1 %
+ * des clés passent en plus par **renvois**).
+ */
+struct TableStatique{
+
+	type_base* cles; /**< Les clés, chacune dans sa case (**nb_cles** cases). */
+
+	uint16_t* pilotes; /**< Le pilote de chaque seau. */
+
+	size_t* renvois; /**< La case de la clé tombée dans la case n + i (ou 0 si elle est restée vide). */
+
+	size_t nb_cles; /**< Le nombre de clés (sans doublon). */
+
+	size_t nb_cases; /**< Le nombre de cases visées par les pilotes (au moins **nb_cles**). */
+
+	size_t nb_seaux; /**< Le nombre de seaux. */
+
+	size_t nb_seaux_denses; /**< Le nombre de seaux qui reçoivent 60 % des clés. */
+
+	uint64_t graine; /**< La graine passée à `hachage_murmur3`. */
+};
+
+/**
+ * @brief Le type "EnsembleStatique" est un ensemble sans doublon, en lecture seule.
+ */
+typedef struct TableStatique* EnsembleStatique;
+
+
+/* Prototype des fonctions */
+
+/**
+ * @brief Construit un ensemble statique contenant les éléments d'une liste
+ * (les doublons sont ignorés). \n
+ * **Complexité :** O(n log n) en moyenne pour n éléments (les derniers seaux,
+ * placés quand il ne reste que quelques cases libres, demandent plus d'essais).
+ * @param l une liste (qui n'est pas modifiée).
+ * @returns un ensemble statique contenant les éléments de l.
+ */
+EnsembleStatique ensemble_statique_depuis_liste(Liste l);
+
+/**
+ * @brief Détermine si un élément appartient à un ensemble statique. \n
+ * **Complexité :** O(1) (dans le pire cas)
+ * @param s un ensemble statique,
+ * @param x une valeur qu'on recherche dans s.
+ * @returns **true** si x appartient à s, **false** sinon.
+ */
+bool appartient_statique(EnsembleStatique s, type_base x);
+
+/**
+ * @brief Renvoie la case d'un élément : les éléments de s sont numérotés de
+ * 0 à n - 1 sans trou, ce qui permet de ranger des données associées dans
+ * un simple tableau. \n
+ * **Complexité :** O(1) (dans le pire cas)
+ * @param s un ensemble statique,
+ * @param x une valeur.
+ * @returns la case de x (entre 0 et n - 1) si x appartient à s, -1 sinon.
+ */
+int64_t indice_statique(EnsembleStatique s, type_base x);
+
+/**
+ * @brief Renvoie la mémoire utilisée par un ensemble statique (les clés, les
+ * pilotes et les renvois). \n
+ * **Complexité :** O(1)
+ * @param s un ensemble statique.
+ * @returns un nombre d'octets.
+ */
+size_t memoire_statique(EnsembleStatique s);
+
+/**
+ * @brief Libère la mémoire associée à un ensemble statique. \n
+ * **Complexité :** O(1)
+ * @param s un ensemble statique.
+ */
+void liberer_ensemble_statique(EnsembleStatique s);
+
+#endif
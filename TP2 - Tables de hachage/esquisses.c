@@ -0,0 +1,171 @@
+#include "esquisses.h"
+#include "hachage.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+// Allocates n bytes aligned on a cache line, set to zero
+static void* allouer_zeros(size_t n) {
+    size_t taille = (n + 63) / 64 * 64;
+    void* p = aligned_alloc(64, taille);
+    if (p == NULL) {
+        fprintf(stderr, "Erreur: Échec de l'allocation de mémoire.\n");
+        exit(EXIT_FAILURE);
+    }
+    memset(p, 0, taille);
+    return p;
+}
+
+HyperLogLog hyperloglog_vide(int precision, uint64_t graine) {
+    HyperLogLog h = malloc(sizeof(struct HyperLogLogRegistres));
+    if (h == NULL) {
+        fprintf(stderr, "Erreur: Échec de l'allocation de mémoire.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    h->precision = precision < 4 ? 4 : precision > 18 ? 18 : precision;
+    h->nb_registres = (size_t)1 << h->precision;
+    h->registres = allouer_zeros(h->nb_registres);
+    h->graine = graine;
+    return h;
+}
+
+// Rank of a hash code: 1 + the number of leading zeros of the bits left
+// after the register number. The sentinel bit caps it at 65 - precision.
+static inline uint8_t rang(uint64_t code, int precision) {
+    return (uint8_t)(__builtin_clzll((code << precision) | ((uint64_t)1 << (precision - 1))) + 1);
+}
+
+void hyperloglog_ajouter(HyperLogLog h, uint64_t cle) {
+    uint64_t code = hachage_murmur3(cle, h->graine);
+    size_t i = (size_t)(code >> (64 - h->precision));
+    uint8_t r = rang(code, h->precision);
+    if (r > h->registres[i]) {
+        h->registres[i] = r;
+    }
+}
+
+void hyperloglog_ajouter_lot(HyperLogLog h, const uint64_t* cles, size_t n) {
+    uint32_t indices[TAILLE_LOT_HLL];
+    uint8_t rangs[TAILLE_LOT_HLL];
+    int decalage = 64 - h->precision;
+
+    for (size_t debut = 0; debut < n; debut += TAILLE_LOT_HLL) {
+        size_t nb = n - debut < TAILLE_LOT_HLL ? n - debut : TAILLE_LOT_HLL;
+
+        // Les codes sont indépendants : cette boucle n'a ni branchement ni dépendance
+        for (size_t k = 0; k < nb; k++) {
+            uint64_t code = hachage_murmur3(cles[debut + k], h->graine);
+            indices[k] = (uint32_t)(code >> decalage);
+            rangs[k] = rang(code, h->precision);
+        }
+        for (size_t k = 0; k < nb; k++) {
+            uint8_t* registre = &(h->registres[indices[k]]);
+            *registre = rangs[k] > *registre ? rangs[k] : *registre;
+        }
+    }
+}
+
+double hyperloglog_estimer(HyperLogLog h) {
+    // Histogramme des registres : la somme des 2^-r n'a plus que 65 termes
+    size_t nb_par_valeur[65] = {0};
+    for (size_t i = 0; i < h->nb_registres; i++) {
+        nb_par_valeur[h->registres[i]]++;
+    }
+    double somme = 0;
+    for (int r = 64; r >= 0; r--) {
+        somme += ldexp((double)nb_par_valeur[r], -r);
+    }
+
+    double m = (double)h->nb_registres;
+    double alpha = h->nb_registres == 16 ? 0.673 : h->nb_registres == 32 ? 0.697
+                 : h->nb_registres == 64 ? 0.709 : 0.7213 / (1.0 + 1.079 / m);
+    double estimation = alpha * m * m / somme;
+
+    // Petits nombres : le comptage linéaire des registres vides est plus précis
+    if (estimation <= 2.5 * m && nb_par_valeur[0] > 0) {
+        estimation = m * log(m / (double)nb_par_valeur[0]);
+    }
+    return estimation;
+}
+
+void hyperloglog_fusionner(HyperLogLog h, HyperLogLog autre) {
+    if (h->precision != autre->precision || h->graine != autre->graine) {
+        fprintf(stderr, "Erreur: Fusion de deux HyperLogLog incompatibles.\n");
+        exit(EXIT_FAILURE);
+    }
+    // Maximum octet par octet (vectorisé par le compilateur)
+    for (size_t i = 0; i < h->nb_registres; i++) {
+        h->registres[i] = autre->registres[i] > h->registres[i] ? autre->registres[i] : h->registres[i];
+    }
+}
+
+void liberer_hyperloglog(HyperLogLog h) {
+    free(h->registres);
+    free(h);
+}
+
+CountMin count_min_vide(size_t largeur, int profondeur, uint64_t graine) {
+    CountMin c = malloc(sizeof(struct CountMinCompteurs));
+    if (c == NULL) {
+        fprintf(stderr, "Erreur: Échec de l'allocation de mémoire.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    c->largeur = 1;
+    while (c->largeur < largeur) {
+        c->largeur *= 2;
+    }
+    c->profondeur = profondeur < 1 ? 1 : profondeur;
+    c->compteurs = allouer_zeros(c->largeur * (size_t)c->profondeur * sizeof(uint32_t));
+    c->total = 0;
+    c->graine = graine;
+    return c;
+}
+
+// Column of a key in row i: h1 + i * h2, h2 being odd so that the columns of
+// two rows differ whenever the h2 of two keys do
+static inline size_t colonne(CountMin c, uint64_t code, int i) {
+    uint32_t h1 = (uint32_t)code;
+    uint32_t h2 = (uint32_t)(code >> 32) | 1;
+    return (size_t)(h1 + (uint32_t)i * h2) & (c->largeur - 1);
+}
+
+void count_min_ajouter(CountMin c, uint64_t cle, uint32_t nombre) {
+    uint64_t code = hachage_murmur3(cle, c->graine);
+    for (int i = 0; i < c->profondeur; i++) {
+        uint32_t* compteur = &(c->compteurs[(size_t)i * c->largeur + colonne(c, code, i)]);
+        *compteur = *compteur > UINT32_MAX - nombre ? UINT32_MAX : *compteur + nombre;
+    }
+    c->total += nombre;
+}
+
+uint32_t count_min_estimer(CountMin c, uint64_t cle) {
+    uint64_t code = hachage_murmur3(cle, c->graine);
+    uint32_t minimum = UINT32_MAX;
+    for (int i = 0; i < c->profondeur; i++) {
+        uint32_t compteur = c->compteurs[(size_t)i * c->largeur + colonne(c, code, i)];
+        minimum = compteur < minimum ? compteur : minimum;
+    }
+    return minimum;
+}
+
+void count_min_fusionner(CountMin c, CountMin autre) {
+    if (c->largeur != autre->largeur || c->profondeur != autre->profondeur || c->graine != autre->graine) {
+        fprintf(stderr, "Erreur: Fusion de deux esquisses Count-Min incompatibles.\n");
+        exit(EXIT_FAILURE);
+    }
+    // Somme saturée compteur par compteur (vectorisée par le compilateur)
+    size_t n = c->largeur * (size_t)c->profondeur;
+    for (size_t i = 0; i < n; i++) {
+        uint32_t a = c->compteurs[i], b = autre->compteurs[i];
+        c->compteurs[i] = a > UINT32_MAX - b ? UINT32_MAX : a + b;
+    }
+    c->total += autre->total;
+}
+
+void liberer_count_min(CountMin c) {
+    free(c->compteurs);
+    free(c);
+}
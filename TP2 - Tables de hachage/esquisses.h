@@ -0,0 +1,185 @@
+/**
+ * @file esquisses.h
+ * @author
+ * */
+
+#ifndef __ESQUISSES__H__
+#define __ESQUISSES__H__
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+
+/* Description des structures */
+
+/**
+ * @brief Le nombre de clés hachées d'un coup par `hyperloglog_ajouter_lot`.
+ */
+#define TAILLE_LOT_HLL 64
+
+/**
+ * @brief Structure codant un compteur approché de clés distinctes
+ * (HyperLogLog, Flajolet et al. 2007). \n
+ * Les **precision** bits de poids fort du code de hachage (`hachage_murmur3`)
+ * choisissent un registre ; le registre garde le plus grand "rang" vu, c'est-à-dire
+ * la position du premier bit à 1 dans les bits restants (un rang r a une
+ * chance sur 2^r). La moyenne harmonique des 2^r donne une estimation du nombre
+ * de clés distinctes, avec une erreur relative type de `1.04 / sqrt(nb_registres)`
+ * (1,6 % pour 4096 registres), quel que soit ce nombre. \n
+ * Un registre fait un octet : la mémoire est fixe (`nb_registres` octets).
+ * Deux compteurs de même précision et de même graine se fusionnent en prenant
+ * le maximum registre par registre (le résultat est celui qu'on aurait eu en
+ * ajoutant les clés des deux).
+ */
+struct HyperLogLogRegistres{
+
+	uint8_t* registres; /**< Les registres (aligné sur une ligne de cache). */
+
+	int precision; /**< Le nombre de bits qui choisissent le registre (entre 4 et 18). */
+
+	size_t nb_registres; /**< 2^precision. */
+
+	uint64_t graine; /**< La graine passée à la fonction de hachage. */
+};
+
+/**
+ * @brief Le type "HyperLogLog" est un pointeur vers un compteur de clés distinctes.
+ */
+typedef struct HyperLogLogRegistres* HyperLogLog;
+
+/**
+ * @brief Structure codant une esquisse Count-Min (Cormode et Muthukrishnan 2005),
+ * qui estime le nombre d'occurrences de chaque clé d'un flot. \n
+ * Il y a **profondeur** lignes de **largeur** compteurs ; une clé incrémente un
+ * compteur par ligne et son estimation est le minimum de ces compteurs. Elle
+ * n'est jamais sous-estimée, et dépasse le vrai nombre d'au plus
+ * `e / largeur * total` avec une probabilité au moins `1 - exp(-profondeur)`. \n
+ * Les colonnes d'une clé sont tirées d'un seul code de hachage (`hachage_murmur3`) :
+ * celle de la ligne i est `h1 + i * h2` (double hachage, Kirsch et Mitzenmacher),
+ * où h1 et h2 sont les deux moitiés du code. \n
+ * Deux esquisses de mêmes dimensions et de même graine se fusionnent en
+ * additionnant leurs compteurs.
+ */
+struct CountMinCompteurs{
+
+	uint32_t* compteurs; /**< Les compteurs, ligne par ligne (aligné sur une ligne de cache). */
+
+	size_t largeur; /**< Le nombre de compteurs d'une ligne (une puissance de deux). */
+
+	int profondeur; /**< Le nombre de lignes. */
+
+	uint64_t total; /**< La somme des nombres ajoutés. */
+
+	uint64_t graine; /**< La graine passée à la fonction de hachage. */
+};
+
+/**
+ * @brief Le type "CountMin" est un pointeur vers une esquisse Count-Min.
+ */
+typedef struct CountMinCompteurs* CountMin;
+
+
+/* Prototype des fonctions */
+
+/**
+ * @brief Renvoie un compteur HyperLogLog vide. \n
+ * **Complexité :** O(2^precision)
+ * @param precision le nombre de bits qui choisissent le registre (ramené entre 4 et 18),
+ * @param graine une graine aléatoire.
+ * @returns un compteur vide.
+ */
+HyperLogLog hyperloglog_vide(int precision, uint64_t graine);
+
+/**
+ * @brief Ajoute une clé au compteur. \n
+ * **Complexité :** O(1)
+ * @param h un compteur,
+ * @param cle une clé (déjà transformée par `objet_vers_nombre`).
+ */
+void hyperloglog_ajouter(HyperLogLog h, uint64_t cle);
+
+/**
+ * @brief Ajoute des clés au compteur. Les codes, registres et rangs de
+ * TAILLE_LOT_HLL clés sont calculés dans une boucle sans branchement ni
+ * dépendance (que le compilateur peut vectoriser), puis les registres sont
+ * mis à jour. \n
+ * **Complexité :** O(n)
+ * @param h un compteur,
+ * @param cles un tableau de clés,
+ * @param n le nombre de clés.
+ */
+void hyperloglog_ajouter_lot(HyperLogLog h, const uint64_t* cles, size_t n);
+
+/**
+ * @brief Estime le nombre de clés distinctes ajoutées au compteur (avec la
+ * correction par "comptage linéaire" des registres vides pour les petits nombres). \n
+ * **Complexité :** O(2^precision)
+ * @param h un compteur.
+ * @returns une estimation du nombre de clés distinctes.
+ */
+double hyperloglog_estimer(HyperLogLog h);
+
+/**
+ * @brief Ajoute à **h** les clés de **autre** (maximum registre par registre). \n
+ * Déclenche une erreur si les deux compteurs n'ont pas la même précision et
+ * la même graine. \n
+ * **Complexité :** O(2^precision)
+ * @param h le compteur modifié,
+ * @param autre un compteur (qui n'est pas modifié).
+ */
+void hyperloglog_fusionner(HyperLogLog h, HyperLogLog autre);
+
+/**
+ * @brief Libère la mémoire associée à un compteur. \n
+ * **Complexité :** O(1)
+ * @param h un compteur.
+ */
+void liberer_hyperloglog(HyperLogLog h);
+
+/**
+ * @brief Renvoie une esquisse Count-Min vide. \n
+ * **Complexité :** O(largeur * profondeur)
+ * @param largeur le nombre de compteurs par ligne (arrondi à la puissance de deux supérieure),
+ * @param profondeur le nombre de lignes (au moins 1),
+ * @param graine une graine aléatoire.
+ * @returns une esquisse vide.
+ */
+CountMin count_min_vide(size_t largeur, int profondeur, uint64_t graine);
+
+/**
+ * @brief Ajoute des occurrences d'une clé (les compteurs saturent à 2^32 - 1). \n
+ * **Complexité :** O(profondeur)
+ * @param c une esquisse,
+ * @param cle une clé (déjà transformée par `objet_vers_nombre`),
+ * @param nombre le nombre d'occurrences à ajouter.
+ */
+void count_min_ajouter(CountMin c, uint64_t cle, uint32_t nombre);
+
+/**
+ * @brief Estime le nombre d'occurrences d'une clé (jamais en dessous du vrai nombre). \n
+ * **Complexité :** O(profondeur)
+ * @param c une esquisse,
+ * @param cle une clé.
+ * @returns le plus petit des compteurs de la clé.
+ */
+uint32_t count_min_estimer(CountMin c, uint64_t cle);
+
+/**
+ * @brief Ajoute à **c** les occurrences de **autre** (somme compteur par compteur). \n
+ * Déclenche une erreur si les deux esquisses n'ont pas les mêmes dimensions et
+ * la même graine. \n
+ * **Complexité :** O(largeur * profondeur)
+ * @param c l'esquisse modifiée,
+ * @param autre une esquisse (qui n'est pas modifiée).
+ */
+void count_min_fusionner(CountMin c, CountMin autre);
+
+/**
+ * @brief Libère la mémoire associée à une esquisse. \n
+ * **Complexité :** O(1)
+ * @param c une esquisse.
+ */
+void liberer_count_min(CountMin c);
+
+#endif
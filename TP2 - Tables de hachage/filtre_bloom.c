@@ -0,0 +1,80 @@
+#include "filtre_bloom.h"
+#include "hachage.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+FiltreBloom filtre_bloom_vide(size_t capacite, int bits_par_cle, uint64_t graine) {
+    FiltreBloom f = malloc(sizeof(struct FiltreBloomBlocs));
+    if (f == NULL) {
+        fprintf(stderr, "Erreur: Échec de l'allocation de mémoire.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // Number of blocks of 512 bits needed for capacite * bits_par_cle bits
+    f->nb_blocs = (capacite * (size_t)bits_par_cle + 511) / 512;
+    if (f->nb_blocs == 0) {
+        f->nb_blocs = 1;
+    }
+
+    f->blocs = aligned_alloc(64, f->nb_blocs * NB_MOTS_PAR_BLOC * sizeof(uint64_t));
+    if (f->blocs == NULL) {
+        fprintf(stderr, "Erreur: Échec de l'allocation de mémoire.\n");
+        exit(EXIT_FAILURE);
+    }
+    memset(f->blocs, 0, f->nb_blocs * NB_MOTS_PAR_BLOC * sizeof(uint64_t));
+
+    f->bits_par_cle = bits_par_cle;
+    f->capacite = capacite;
+    f->nb_cles = 0;
+    f->graine = graine;
+
+    return f;
+}
+
+// Address of the block of a key: the 32 high bits of its hash code, seen as a
+// fraction of 2^32, are scaled to the number of blocks (no division)
+static inline uint64_t* bloc_de(FiltreBloom f, uint64_t h) {
+    size_t b = (size_t)(((h >> 32) * (uint64_t)f->nb_blocs) >> 32);
+    return f->blocs + b * NB_MOTS_PAR_BLOC;
+}
+
+// Odd constants ("salts") used to draw the bit of a key in each word of its block
+static const uint64_t SELS[NB_MOTS_PAR_BLOC] = {
+    0x47b6137b44974d91ULL, 0x8824ad5ba2b7289dULL, 0x705495c72df1424bULL, 0x9efc49475c6bfb31ULL,
+    0x2df1424b9efc4947ULL, 0x5c6bfb3147b6137bULL, 0x44974d918824ad5bULL, 0xa2b7289d705495c7ULL
+};
+
+// Bit of a key in the word j of its block: `(low half of h * SELS[j]) >> 58`.
+// The low half of h is independent of the high half that chose the block.
+static inline uint64_t masque_mot(uint64_t h, int j) {
+    return 1ULL << (((h & 0xFFFFFFFF) * SELS[j]) >> 58);
+}
+
+void filtre_bloom_ajouter(FiltreBloom f, uint64_t cle) {
+    uint64_t h = hachage_murmur3(cle, f->graine);
+    uint64_t* bloc = bloc_de(f, h);
+
+    for (int j = 0; j < NB_MOTS_PAR_BLOC; j++) {
+        bloc[j] |= masque_mot(h, j);
+    }
+    f->nb_cles++;
+}
+
+bool filtre_bloom_contient(FiltreBloom f, uint64_t cle) {
+    uint64_t h = hachage_murmur3(cle, f->graine);
+    const uint64_t* bloc = bloc_de(f, h);
+
+    // Pas de branchement : on accumule les bits manquants des 8 mots
+    // (le compilateur peut vectoriser la boucle)
+    uint64_t manquants = 0;
+    for (int j = 0; j < NB_MOTS_PAR_BLOC; j++) {
+        manquants |= masque_mot(h, j) & ~bloc[j];
+    }
+    return manquants == 0;
+}
+
+void liberer_filtre_bloom(FiltreBloom f) {
+    free(f->blocs);
+    free(f);
+}
@@ -0,0 +1,95 @@
+/**
+ * @file filtre_bloom.h
+ * @author
+ * */
+
+#ifndef __FILTRE__BLOOM__H__
+#define __FILTRE__BLOOM__H__
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+
+/* Description de la structure */
+
+/**
+ * @brief Le nombre de mots de 64 bits d'un bloc du filtre
+ * (un bloc fait 512 bits, soit une ligne de cache).
+ */
+#define NB_MOTS_PAR_BLOC 8
+
+/**
+ * @brief Structure codant un filtre de Bloom "par blocs". \n
+ * Un filtre de Bloom représente un ensemble de clés de manière approchée :
+ * il peut répondre "peut-être présente" pour une clé absente (un faux positif),
+ * mais jamais "absente" pour une clé présente. \n
+ * Le tableau de bits est découpé en blocs d'une ligne de cache. Les bits de
+ * poids fort du code de hachage (`hachage_murmur3`) choisissent le bloc de la clé
+ * (par une multiplication plutôt qu'un modulo, donc le nombre de blocs est quelconque),
+ * et ses autres bits choisissent un bit dans chacun des NB_MOTS_PAR_BLOC mots
+ * de ce bloc : un test ne lit donc qu'une seule ligne de cache, sans branchement
+ * (au prix d'un taux de faux positifs un peu plus élevé qu'avec un filtre
+ * classique du même nombre de bits). \n
+ * On ne peut pas retirer une clé : pour cela, il faut reconstruire le filtre.
+ */
+struct FiltreBloomBlocs{
+
+	uint64_t* blocs; /**< Le tableau des bits (aligné sur une ligne de cache). */
+
+	size_t nb_blocs; /**< Le nombre de blocs (moins de 2^32). */
+
+	int bits_par_cle; /**< Le nombre de bits par clé demandé à la création. */
+
+	size_t capacite; /**< Le nombre de clés prévu à la création. */
+
+	size_t nb_cles; /**< Le nombre de clés ajoutées depuis la création. */
+
+	uint64_t graine; /**< La graine passée à la fonction de hachage. */
+};
+
+/**
+ * @brief Le type "FiltreBloom" est un pointeur vers un filtre de Bloom par blocs.
+ */
+typedef struct FiltreBloomBlocs* FiltreBloom;
+
+
+/* Prototype des fonctions */
+
+/**
+ * @brief Renvoie un filtre vide prévu pour un certain nombre de clés. \n
+ * Il a `capacite * bits_par_cle` bits (arrondi au bloc supérieur). \n
+ * **Complexité :** O(capacite * bits_par_cle / 512)
+ * @param capacite le nombre de clés prévu,
+ * @param bits_par_cle le nombre de bits par clé (au moins 1),
+ * @param graine une graine aléatoire.
+ * @returns un filtre vide.
+ */
+FiltreBloom filtre_bloom_vide(size_t capacite, int bits_par_cle, uint64_t graine);
+
+/**
+ * @brief Ajoute une clé au filtre. \n
+ * **Complexité :** O(1)
+ * @param f un filtre,
+ * @param cle une clé (déjà transformée par `objet_vers_nombre`).
+ */
+void filtre_bloom_ajouter(FiltreBloom f, uint64_t cle);
+
+/**
+ * @brief Teste si une clé a pu être ajoutée au filtre (en lisant une seule ligne de cache). \n
+ * **Complexité :** O(1)
+ * @param f un filtre,
+ * @param cle une clé.
+ * @returns **false** si la clé n'a jamais été ajoutée, **true** si elle
+ * l'a peut-être été.
+ */
+bool filtre_bloom_contient(FiltreBloom f, uint64_t cle);
+
+/**
+ * @brief Libère la mémoire associée à un filtre. \n
+ * **Complexité :** O(1)
+ * @param f un filtre.
+ */
+void liberer_filtre_bloom(FiltreBloom f);
+
+#endif
@@ -0,0 +1,136 @@
+/**
+ * @file hachage.h
+ * @author
+ * */
+
+#ifndef __HACHAGE__H__
+#define __HACHAGE__H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+
+
+/**
+ * @brief Alias pour une fonction de hachage : elle prend en paramètre
+ * un entier (la clé, déjà transformée par `objet_vers_nombre`) et une
+ * graine aléatoire, et renvoie un code de hachage sur 64 bits. \n
+ * Ce sont les bits de **poids fort** du code qui sont de bonne qualité :
+ * pour une table de 2^b alvéoles, le numéro d'alvéole est donné par les
+ * b bits de poids fort (`code >> (64 - b)`), ce qui évite toute division.
+ */
+typedef uint64_t (*fonction_hachage)(uint64_t, uint64_t);
+
+
+/* Fonctions de hachage disponibles.
+ * Elles sont "static inline" (comme `objet_vers_nombre`) pour que les
+ * structures qui en utilisent une directement puissent l'inliner ;
+ * on peut quand même en prendre l'adresse. */
+
+/**
+ * @brief L'ancienne fonction de hachage de `Ensemble`,
+ * `k -> |_ A * (k & 4294967295) * nb_alveoles _| modulo nb_alveoles`,
+ * où A est un réel entre 0.25 et 0.75 tiré de la graine. \n
+ * Quand nb_alveoles vaut 2^b, ce nombre est exactement formé des b premiers
+ * bits de la partie fractionnaire de `A * (k & 4294967295)` : c'est donc
+ * ce qu'on renvoie dans les bits de poids fort. \n
+ * Conservée pour comparaison : elle coûte une multiplication flottante et
+ * deux conversions, et ignore les 32 bits de poids fort de la clé.
+ * @param k une clé,
+ * @param graine une graine aléatoire.
+ * @returns le code de hachage de k.
+ */
+static inline uint64_t hachage_multiplicatif_reel(uint64_t k, uint64_t graine){
+	double A = 0.25 + 0.5 * (double)(graine >> 11) / 9007199254740992.0;
+	double produit = A * (double)(k & 4294967295);
+	double partie_fractionnaire = produit - floor(produit);
+	return (uint64_t)(partie_fractionnaire * 9007199254740992.0) << 11;
+}
+
+/**
+ * @brief Hachage de Fibonacci (multiplication-décalage) :
+ * `k -> (k xor graine) * 2^64/φ` modulo 2^64, où φ est le nombre d'or. \n
+ * Une seule multiplication entière ; les clés consécutives sont réparties
+ * de manière très régulière, mais les bits de poids faible du code
+ * ne dépendent que des bits de poids faible de la clé.
+ * @param k une clé,
+ * @param graine une graine aléatoire.
+ * @returns le code de hachage de k.
+ */
+static inline uint64_t hachage_fibonacci(uint64_t k, uint64_t graine){
+	return (k ^ graine) * 0x9E3779B97F4A7C15ULL;
+}
+
+/**
+ * @brief Le "finaliseur" de MurmurHash3 (fmix64) appliqué à `k xor graine`. \n
+ * Deux multiplications et trois décalages : chaque bit du code dépend de
+ * chaque bit de la clé (on peut donc aussi utiliser ses bits de poids faible).
+ * @param k une clé,
+ * @param graine une graine aléatoire.
+ * @returns le code de hachage de k.
+ */
+static inline uint64_t hachage_murmur3(uint64_t k, uint64_t graine){
+	uint64_t h = k ^ graine;
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdULL;
+	h ^= h >> 33;
+	h *= 0xc4ceb9fe1a85ec53ULL;
+	h ^= h >> 33;
+	return h;
+}
+
+/**
+ * @brief Le mélangeur de wyhash : on multiplie deux mots de 64 bits en un
+ * produit de 128 bits, et on renvoie le "ou exclusif" de ses deux moitiés. \n
+ * Une seule multiplication (128 bits) ; la qualité est proche de `hachage_murmur3`.
+ * @param k une clé,
+ * @param graine une graine aléatoire.
+ * @returns le code de hachage de k.
+ */
+static inline uint64_t hachage_wyhash(uint64_t k, uint64_t graine){
+	uint64_t a = k ^ 0xa0761d6478bd642fULL;
+	uint64_t b = graine ^ 0xe7037ed1a0b428dbULL;
+#ifdef __SIZEOF_INT128__
+	__extension__ typedef unsigned __int128 uint128;
+	uint128 produit = (uint128)a * b;
+	return (uint64_t)produit ^ (uint64_t)(produit >> 64);
+#else
+	// Produit 64 x 64 -> 128 bits à la main, par moitiés de 32 bits
+	uint64_t a_h = a >> 32, a_l = (uint32_t)a, b_h = b >> 32, b_l = (uint32_t)b;
+	uint64_t hh = a_h * b_h, hl = a_h * b_l, lh = a_l * b_h, ll = a_l * b_l;
+	uint64_t milieu = (ll >> 32) + (uint32_t)hl + (uint32_t)lh;
+	uint64_t bas = (milieu << 32) | (uint32_t)ll;
+	uint64_t haut = hh + (hl >> 32) + (lh >> 32) + (milieu >> 32);
+	return bas ^ haut;
+#endif
+}
+
+/**
+ * @brief Hachage d'une suite d'octets (par exemple une chaîne de caractères). \n
+ * Les octets sont lus par mots de 8 (le dernier mot est complété par des zéros) ;
+ * chaque mot est mélangé à l'état courant par `hachage_wyhash`, puis la longueur
+ * est mélangée au résultat par `hachage_murmur3` (pour que "a" et "a\0" diffèrent).
+ * Contrairement aux autres fonctions, elle n'est pas du type `fonction_hachage`.
+ * @param octets l'adresse des octets,
+ * @param longueur le nombre d'octets,
+ * @param graine une graine aléatoire.
+ * @returns le code de hachage des octets.
+ */
+static inline uint64_t hachage_octets(const void* octets, size_t longueur, uint64_t graine){
+	const unsigned char* p = (const unsigned char*)octets;
+	uint64_t h = graine;
+	uint64_t mot;
+	while (longueur >= 8) {
+		memcpy(&mot, p, 8);
+		h = hachage_wyhash(mot, h);
+		p += 8;
+		longueur -= 8;
+	}
+	mot = 0;
+	memcpy(&mot, p, longueur);
+	h = hachage_wyhash(mot, h);
+	return hachage_murmur3(h, (uint64_t)(p - (const unsigned char*)octets) + longueur);
+}
+
+#endif
@@ -0,0 +1,123 @@
+#include "instantane.h"
+#include "hachage.h"
+#include "liste.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Checksum of the control bytes followed by the keys
+static uint64_t somme_controle(const int8_t* controle, const type_base* cles, size_t nb_cases) {
+    uint64_t h = hachage_octets(controle, nb_cases * sizeof(int8_t), 0);
+    return hachage_octets(cles, nb_cases * sizeof(type_base), h);
+}
+
+bool sauvegarder_ensemble_groupe(EnsembleGroupe e, const char* chemin) {
+    struct EnteteInstantane entete;
+    memset(&entete, 0, sizeof(entete));
+    memcpy(entete.magie, MAGIE_INSTANTANE, sizeof(MAGIE_INSTANTANE));
+    entete.version = VERSION_INSTANTANE;
+    entete.taille_cle = sizeof(type_base);
+    entete.nb_cases = e->nb_cases;
+    entete.taille = e->taille;
+    entete.nb_supprimees = e->nb_supprimees;
+    entete.graine = e->graine;
+    entete.somme_controle = somme_controle(e->controle, e->cles, e->nb_cases);
+
+    FILE* f = fopen(chemin, "wb");
+    if (f == NULL) {
+        fprintf(stderr, "Erreur: Impossible d'ouvrir %s en écriture.\n", chemin);
+        return false;
+    }
+
+    bool ecrit = fwrite(&entete, sizeof(entete), 1, f) == 1
+                 && fwrite(e->controle, sizeof(int8_t), e->nb_cases, f) == e->nb_cases
+                 && fwrite(e->cles, sizeof(type_base), e->nb_cases, f) == e->nb_cases;
+    ecrit = fclose(f) == 0 && ecrit;
+
+    if (!ecrit) {
+        fprintf(stderr, "Erreur: Échec de l'écriture de %s.\n", chemin);
+    }
+    return ecrit;
+}
+
+bool sauvegarder_ensemble(Ensemble e, const char* chemin) {
+    EnsembleGroupe g = ensemble_groupe_vide();
+    g->graine = e->graine;
+
+    Liste l = ensemble_vers_liste(e);
+    for (size_t i = 0; i < longueur(l); i++) {
+        ajouter_eg(g, element(l, i));
+    }
+    liberer_liste(l);
+
+    bool ecrit = sauvegarder_ensemble_groupe(g, chemin);
+    liberer_ensemble_groupe(g);
+    return ecrit;
+}
+
+// Checks the header against the size of the file
+static bool entete_valide(const struct EnteteInstantane* entete, size_t taille_fichier) {
+    uint64_t n = entete->nb_cases;
+    return memcmp(entete->magie, MAGIE_INSTANTANE, sizeof(MAGIE_INSTANTANE)) == 0
+           && entete->version == VERSION_INSTANTANE
+           && entete->taille_cle == sizeof(type_base)
+           && n >= TAILLE_GROUPE && (n & (n - 1)) == 0
+           && n <= (taille_fichier - sizeof(struct EnteteInstantane)) / (sizeof(int8_t) + sizeof(type_base))
+           && taille_fichier == sizeof(struct EnteteInstantane) + n * (sizeof(int8_t) + sizeof(type_base))
+           && entete->taille + entete->nb_supprimees < n;
+}
+
+EnsembleGroupe charger_ensemble_groupe(const char* chemin, bool verifier) {
+    int fd = open(chemin, O_RDONLY);
+    if (fd == -1) {
+        fprintf(stderr, "Erreur: Impossible d'ouvrir %s.\n", chemin);
+        return NULL;
+    }
+
+    struct stat infos;
+    if (fstat(fd, &infos) == -1 || (size_t)infos.st_size < sizeof(struct EnteteInstantane)) {
+        fprintf(stderr, "Erreur: %s n'est pas un instantané valide.\n", chemin);
+        close(fd);
+        return NULL;
+    }
+
+    size_t taille_fichier = (size_t)infos.st_size;
+    void* projection = mmap(NULL, taille_fichier, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // La projection reste valable après la fermeture
+    if (projection == MAP_FAILED) {
+        fprintf(stderr, "Erreur: Impossible de projeter %s en mémoire.\n", chemin);
+        return NULL;
+    }
+
+    const struct EnteteInstantane* entete = projection;
+    bool valide = entete_valide(entete, taille_fichier);
+    int8_t* controle = (int8_t*)((char*)projection + sizeof(struct EnteteInstantane));
+    type_base* cles = valide ? (type_base*)(controle + entete->nb_cases) : NULL;
+
+    if (!valide || (verifier && somme_controle(controle, cles, entete->nb_cases) != entete->somme_controle)) {
+        fprintf(stderr, "Erreur: %s n'est pas un instantané valide.\n", chemin);
+        munmap(projection, taille_fichier);
+        return NULL;
+    }
+
+    EnsembleGroupe e = malloc(sizeof(struct TableGroupes));
+    if (e == NULL) {
+        fprintf(stderr, "Erreur: Échec de l'allocation de mémoire.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    e->controle = controle;
+    e->cles = cles;
+    e->nb_cases = entete->nb_cases;
+    e->taille = entete->taille;
+    e->nb_supprimees = entete->nb_supprimees;
+    e->graine = entete->graine;
+    e->projection = projection;
+    e->taille_projection = taille_fichier;
+
+    return e;
+}
@@ -0,0 +1,89 @@
+/**
+ * @file instantane.h
+ * @author
+ * */
+
+#ifndef __INSTANTANE__H__
+#define __INSTANTANE__H__
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "ensemble.h"
+#include "ensemble_groupe.h"
+
+
+/* Description du format */
+
+/**
+ * @brief Les 8 premiers octets d'un instantané.
+ */
+#define MAGIE_INSTANTANE "TP2ENSG"
+
+/**
+ * @brief La version du format (une machine d'un autre boutisme la lit
+ * comme un autre nombre et refuse donc le fichier).
+ */
+#define VERSION_INSTANTANE 1
+
+/**
+ * @brief L'en-tête d'un instantané : le fichier contient cet en-tête
+ * (56 octets), puis les **nb_cases** octets de contrôle, puis les **nb_cases**
+ * clés, exactement comme dans les tableaux **controle** et **cles** d'un
+ * `EnsembleGroupe`. Comme **nb_cases** est un multiple de 16, les clés sont
+ * alignées sur 8 octets dans le fichier.
+ */
+struct EnteteInstantane{
+	char magie[8]; /**< MAGIE_INSTANTANE (terminé par un octet nul). */
+	uint32_t version; /**< VERSION_INSTANTANE. */
+	uint32_t taille_cle; /**< sizeof(type_base) à l'écriture. */
+	uint64_t nb_cases; /**< Le nombre de cases de la table. */
+	uint64_t taille; /**< Le nombre d'éléments. */
+	uint64_t nb_supprimees; /**< Le nombre de cases CASE_SUPPRIMEE. */
+	uint64_t graine; /**< La graine de hachage : sans elle, les cases ne veulent rien dire. */
+	uint64_t somme_controle; /**< `hachage_octets` des octets de contrôle puis des clés. */
+};
+
+
+/* Prototype des fonctions */
+
+/**
+ * @brief Écrit un instantané d'un ensemble à sondage par groupes dans un fichier
+ * (l'en-tête, puis ses tableaux tels quels : rien n'est recalculé). \n
+ * **Complexité :** O(nombre de cases)
+ * @param e un ensemble,
+ * @param chemin le chemin du fichier (écrasé s'il existe).
+ * @returns **true** si le fichier a été écrit, **false** sinon (un message
+ * est alors affiché sur la sortie d'erreur).
+ */
+bool sauvegarder_ensemble_groupe(EnsembleGroupe e, const char* chemin);
+
+/**
+ * @brief Écrit un instantané d'un ensemble (à adressage par listes chaînées) :
+ * ses éléments sont d'abord rangés dans une table à sondage par groupes qui
+ * reprend la graine de e. Un multi-ensemble y met un élément par occurrence. \n
+ * **Complexité :** O(taille de e) (en moyenne)
+ * @param e un ensemble,
+ * @param chemin le chemin du fichier (écrasé s'il existe).
+ * @returns **true** si le fichier a été écrit, **false** sinon.
+ */
+bool sauvegarder_ensemble(Ensemble e, const char* chemin);
+
+/**
+ * @brief Charge un instantané en projetant le fichier en mémoire (mmap, en
+ * lecture seule) : la table n'est ni lue ni reconstruite, et `appartient_eg`
+ * lit directement ses cases dans le fichier (les pages sont chargées par le
+ * système au premier accès). \n
+ * Le premier `ajouter_eg` ou `supprimer_eg` recopie les cases en mémoire ;
+ * le fichier n'est jamais modifié. `liberer_ensemble_groupe` supprime la projection. \n
+ * **Complexité :** O(1) sans vérification ; O(nombre de cases) avec.
+ * @param chemin le chemin d'un fichier écrit par `sauvegarder_ensemble_groupe`
+ * ou `sauvegarder_ensemble`,
+ * @param verifier **true** pour recalculer la somme de contrôle (ce qui lit tout
+ * le fichier), **false** pour ne vérifier que l'en-tête et la taille du fichier.
+ * @returns l'ensemble chargé, ou NULL si le fichier ne peut pas être ouvert
+ * ou n'est pas un instantané valide (un message est alors affiché).
+ */
+EnsembleGroupe charger_ensemble_groupe(const char* chemin, bool verifier);
+
+#endif
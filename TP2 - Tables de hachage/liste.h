@@ -7,6 +7,8 @@
 #define __LISTE__H__
 
 #include <stdlib.h>
+#include <stdint.h>
+#include <inttypes.h>
 
 
 /* !!! A CHANGER ICI SI VOUS NE VOULEZ PAS TRAVAILLER AVEC DES ENTIERS !!! */
@@ -16,9 +18,24 @@
 
 /**
  * @brief Le type des éléments DANS le tableau dynamique.
- * Ce qu'il faut changer si on ne veut pas travailler avec des entiers.
+ * Ce qu'il faut changer si on ne veut pas travailler avec des entiers. \n
+ * Ce sont des entiers de 32 bits, ou de 64 bits si on compile avec
+ * `-DCLES_64_BITS` (pour des identifiants qui ne tiennent pas sur 32 bits).
  */
+#ifdef CLES_64_BITS
+typedef int64_t type_base;
+#else
 typedef int type_base;
+#endif
+
+/**
+ * @brief Le format de `printf` d'un élément de type `type_base`.
+ */
+#ifdef CLES_64_BITS
+#define FORMAT_BASE "%" PRId64
+#else
+#define FORMAT_BASE "%d"
+#endif
 
 #endif
 
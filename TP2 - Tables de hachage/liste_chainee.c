@@ -84,7 +84,7 @@ ListeChainee supprimer_lc(ListeChainee l, type_base x) {
     // Si l'élément n'est pas trouvé dans la liste
     if (current == NULL) {
 
-        fprintf(stderr, "Erreur: %d n'est pas présent dans la liste.\n", x);
+        fprintf(stderr, "Erreur: " FORMAT_BASE " n'est pas présent dans la liste.\n", x);
         exit(EXIT_FAILURE);
 
     }
@@ -144,7 +144,7 @@ Liste liste_chainee_vers_liste(ListeChainee l) {
 void afficher_liste_chainee(ListeChainee l) {
     printf("Liste : ");
     while (l != NULL) {
-        printf("%d -> ", l->valeur);
+        printf(FORMAT_BASE " -> ", l->valeur);
         l = l->suivant;
     }
     printf("NULL\n");
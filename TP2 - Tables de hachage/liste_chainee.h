@@ -7,6 +7,8 @@
 #define __LISTE__CHAINEE__H__
 
 #include <stdlib.h>
+#include <stdint.h>
+#include <inttypes.h>
 #include "liste.h"
 
 
@@ -16,9 +18,35 @@
 
 /**
  * @brief Le type des éléments DANS la liste chaînée/table de hachage.
- * Ce qu'il faut changer si on ne veut pas travailler avec des entiers.
+ * Ce qu'il faut changer si on ne veut pas travailler avec des entiers. \n
+ * Ce sont des entiers de 32 bits, ou de 64 bits si on compile avec
+ * `-DCLES_64_BITS` (pour des identifiants qui ne tiennent pas sur 32 bits).
  */
+#ifdef CLES_64_BITS
+typedef int64_t type_base;
+#else
 typedef int type_base;
+#endif
+
+/**
+ * @brief Le format de `printf` d'un élément de type `type_base`.
+ */
+#ifdef CLES_64_BITS
+#define FORMAT_BASE "%" PRId64
+#else
+#define FORMAT_BASE "%d"
+#endif
+
+#endif
+
+#ifndef __TYPE__VALEUR__
+#define __TYPE__VALEUR__
+
+/**
+ * @brief Le type des valeurs associées aux clés dans un dictionnaire
+ * (voir `dictionnaire.h`).
+ */
+typedef int type_valeur;
 
 #endif
 
@@ -31,6 +59,11 @@ typedef int type_base;
  */
 struct Noeud{
 	type_base valeur; /**<  L'étiquette du noeud */
+	type_valeur valeur_associee; /**< La valeur associée à l'étiquette quand 
+	la liste sert de dictionnaire, ou son nombre d'occurrences dans un
+	multi-ensemble (inutilisé sinon). Avec des entiers, ce champ
+	occupe l'espace de remplissage qui suit l'étiquette : le noeud fait toujours 16 octets
+	(24 avec des clés de 64 bits). */
 	struct Noeud* suivant; /**<  L'adresse du noeud suivant. 
 	Si le noeud est le dernier de la liste, alors ce champ est le pointeur nul. */
 };
@@ -1,9 +1,16 @@
 #include "liste.h"
 #include "liste_chainee.h"
 #include "ensemble.h"
+#include "dictionnaire.h"
+#include "benchmark_ensemble.h"
 #include <stdlib.h>
 #include <stdio.h>
 
+// Upsert callback: counts the occurrences of a key
+static void compter_occurrence(type_valeur* v, bool existait, void* contexte) {
+    (void)contexte;
+    *v = existait ? *v + 1 : 1;
+}
 
 int main(){
     /*
@@ -49,7 +56,9 @@ int main(){
     // Test supprimer()
     printf("\nRemoving elements from the ensemble...\n");
     supprimer(e, 20);
-    supprimer(e, 40); // Removing a non-existent element
+    if (appartient(e, 40)) { // Removing a non-existent element would stop the program
+        supprimer(e, 40);
+    }
     printf("Elements removed from the ensemble.\n");
 
     // Test ensemble_vers_liste()
@@ -72,5 +81,43 @@ int main(){
     liberer_liste(l);
     printf("Memory freed.\n");
 
+    // Test dictionnaire
+    printf("\nCounting occurrences with a dictionary...\n");
+    Dictionnaire d = dictionnaire_vide();
+    type_base mots[] = {3, 1, 3, 2, 3, 1};
+    for (size_t i = 0; i < 6; i++) {
+        inserer_ou_maj_avec(d, mots[i], compter_occurrence, NULL);
+    }
+    printf("3 appears %d times, 1 appears %d times\n", *obtenir(d, 3), *obtenir(d, 1));
+    supprimer_cle(d, 3);
+    printf("Is 3 still a key? %s\n", obtenir(d, 3) != NULL ? "Yes" : "No");
+    liberer_dictionnaire(d);
+
+    // Benchmarks
+    benchmark_ensemble_groupe(TAILLE_BENCHMARK);
+    benchmark_fonctions_hachage(TAILLE_BENCHMARK);
+    benchmark_redimensionnement_progressif(TAILLE_BENCHMARK);
+    benchmark_reserve_noeuds(TAILLE_BENCHMARK);
+    benchmark_ensemble_concurrent(TAILLE_BENCHMARK, 8);
+    benchmark_lots(16 * TAILLE_BENCHMARK);
+    benchmark_operations_ensemblistes(TAILLE_BENCHMARK, 4);
+    benchmark_filtre_bloom(4 * TAILLE_BENCHMARK);
+    benchmark_multiensemble(TAILLE_BENCHMARK);
+    benchmark_ensemble_chaines(TAILLE_BENCHMARK);
+    benchmark_ensemble_compresse(TAILLE_BENCHMARK);
+    benchmark_instantane(4 * TAILLE_BENCHMARK);
+    benchmark_capacite(4 * TAILLE_BENCHMARK);
+    benchmark_statistiques(TAILLE_BENCHMARK);
+    benchmark_ensemble_coucou(TAILLE_BENCHMARK);
+    benchmark_construction_parallele(16 * TAILLE_BENCHMARK, 4);
+    benchmark_ensemble_deroule(TAILLE_BENCHMARK);
+    benchmark_arborisation(TAILLE_BENCHMARK / 50);
+    benchmark_dictionnaire_ordonne(TAILLE_BENCHMARK);
+    benchmark_operateurs(16 * TAILLE_BENCHMARK);
+    benchmark_esquisses(4 * TAILLE_BENCHMARK);
+    benchmark_cles_64_bits(TAILLE_BENCHMARK);
+    benchmark_ensemble_statique(TAILLE_BENCHMARK);
+    benchmark_cache(TAILLE_BENCHMARK);
+
     return 0;
 }
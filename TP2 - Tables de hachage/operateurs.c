@@ -0,0 +1,223 @@
+#include "operateurs.h"
+#include "ensemble.h"
+#include "hachage.h"
+#include "liste.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Target number of rows in a part: its table (at most 4 cases per row)
+// stays in the L2 cache
+#define NB_CLES_PAR_PART 8192
+
+// Largest number of parts: beyond that, the partitioning pass writes to too
+// many places at once
+#define NB_MAX_PARTS 1024
+
+// A row of a partitioned column: its key and its position in the column
+struct Rangee {
+    type_base cle;
+    int indice;
+};
+
+static inline uint64_t hacher(type_base x, uint64_t graine) {
+    return hachage_murmur3(objet_vers_nombre(x), graine);
+}
+
+// Part of a hash code: its top bits (the low bits choose the case in the
+// table of the part)
+static inline size_t part_de(uint64_t h, int bits) {
+    return bits == 0 ? 0 : (size_t)(h >> (64 - bits));
+}
+
+// Number of hash bits that choose the part, for a column of n rows
+static int bits_de_part(size_t n) {
+    int bits = 0;
+    while (((size_t)1 << bits) < NB_MAX_PARTS && (n >> bits) > NB_CLES_PAR_PART) {
+        bits++;
+    }
+    return bits;
+}
+
+// Smallest power of two (at least 8) above 2n
+static size_t nb_cases_pour(size_t n) {
+    size_t nb = 8;
+    while (nb < 2 * n) {
+        nb *= 2;
+    }
+    return nb;
+}
+
+static void* allouer(size_t taille) {
+    void* p = malloc(taille);
+    if (p == NULL) {
+        fprintf(stderr, "Erreur: Échec de l'allocation de mémoire.\n");
+        exit(EXIT_FAILURE);
+    }
+    return p;
+}
+
+// Scatters the rows of a column by part: part p is
+// rangees[debuts[p]..debuts[p + 1][. Returns the size of the largest part.
+static size_t partitionner(Liste colonne, uint64_t graine, int bits, struct Rangee* rangees, size_t* debuts) {
+    size_t n = longueur(colonne);
+    size_t nb_parts = (size_t)1 << bits;
+
+    // Première passe : la taille de chaque part
+    memset(debuts, 0, (nb_parts + 1) * sizeof(size_t));
+    for (size_t i = 0; i < n; i++) {
+        debuts[part_de(hacher(colonne->tableau[i], graine), bits) + 1]++;
+    }
+    size_t plus_grande = 0;
+    for (size_t p = 0; p < nb_parts; p++) {
+        plus_grande = debuts[p + 1] > plus_grande ? debuts[p + 1] : plus_grande;
+        debuts[p + 1] += debuts[p];
+    }
+
+    // Deuxième passe : chaque rangée est copiée à la suite de sa part
+    size_t* positions = allouer(nb_parts * sizeof(size_t));
+    memcpy(positions, debuts, nb_parts * sizeof(size_t));
+    for (size_t i = 0; i < n; i++) {
+        type_base cle = colonne->tableau[i];
+        size_t p = part_de(hacher(cle, graine), bits);
+        rangees[positions[p]].cle = cle;
+        rangees[positions[p]].indice = (int)i;
+        positions[p]++;
+    }
+    free(positions);
+    return plus_grande;
+}
+
+struct Groupes grouper_compter(Liste cles) {
+    srand(time(NULL)); // Seed the random number generator
+    uint64_t graine = ((uint64_t)rand() << 32) ^ (uint64_t)rand();
+    size_t n = longueur(cles);
+    int bits = bits_de_part(n);
+    size_t nb_parts = (size_t)1 << bits;
+
+    struct Groupes g = {liste_vide(), liste_vide()};
+    if (n == 0) {
+        return g;
+    }
+
+    struct Rangee* rangees = allouer(n * sizeof(struct Rangee));
+    size_t* debuts = allouer((nb_parts + 1) * sizeof(size_t));
+    size_t plus_grande = partitionner(cles, graine, bits, rangees, debuts);
+
+    // Une seule table, assez grande pour la plus grande part ; un nombre nul marque une case vide
+    size_t nb_cases = nb_cases_pour(plus_grande);
+    type_base* cles_table = allouer(nb_cases * sizeof(type_base));
+    type_valeur* nombres = calloc(nb_cases, sizeof(type_valeur));
+    if (nombres == NULL) {
+        fprintf(stderr, "Erreur: Échec de l'allocation de mémoire.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for (size_t p = 0; p < nb_parts; p++) {
+        size_t masque = nb_cases_pour(debuts[p + 1] - debuts[p]) - 1;
+        for (size_t r = debuts[p]; r < debuts[p + 1]; r++) {
+            type_base cle = rangees[r].cle;
+            size_t i = hacher(cle, graine) & masque;
+            while (nombres[i] != 0 && cles_table[i] != cle) {
+                i = (i + 1) & masque;
+            }
+            cles_table[i] = cle;
+            nombres[i]++;
+        }
+
+        // On recopie les groupes de la part, en vidant la table pour la suivante
+        for (size_t i = 0; i <= masque; i++) {
+            if (nombres[i] != 0) {
+                ajouter_en_fin(g.cles, cles_table[i]);
+                ajouter_en_fin(g.nombres, (type_base)nombres[i]);
+                nombres[i] = 0;
+            }
+        }
+    }
+
+    free(nombres);
+    free(cles_table);
+    free(debuts);
+    free(rangees);
+    return g;
+}
+
+struct Jointure jointure_hachage(Liste gauche, Liste droite) {
+    srand(time(NULL)); // Seed the random number generator
+    uint64_t graine = ((uint64_t)rand() << 32) ^ (uint64_t)rand();
+
+    // La table est construite sur la plus petite colonne
+    bool echange = longueur(droite) < longueur(gauche);
+    Liste construite = echange ? droite : gauche;
+    Liste sondee = echange ? gauche : droite;
+    size_t n_construite = longueur(construite);
+    size_t n_sondee = longueur(sondee);
+
+    struct Jointure j = {liste_vide(), liste_vide()};
+    Liste sortie_construite = echange ? j.indices_droite : j.indices_gauche;
+    Liste sortie_sondee = echange ? j.indices_gauche : j.indices_droite;
+    if (n_construite == 0) {
+        return j;
+    }
+
+    // Les deux colonnes sont réparties avec la même graine et le même nombre de parts
+    int bits = bits_de_part(n_construite);
+    size_t nb_parts = (size_t)1 << bits;
+    struct Rangee* rangees_construites = allouer(n_construite * sizeof(struct Rangee));
+    struct Rangee* rangees_sondees = allouer((n_sondee > 0 ? n_sondee : 1) * sizeof(struct Rangee));
+    size_t* debuts_construits = allouer((nb_parts + 1) * sizeof(size_t));
+    size_t* debuts_sondes = allouer((nb_parts + 1) * sizeof(size_t));
+    size_t plus_grande = partitionner(construite, graine, bits, rangees_construites, debuts_construits);
+    partitionner(sondee, graine, bits, rangees_sondees, debuts_sondes);
+
+    // Chaînage par indices : tetes[case] est la première rangée de la part dans
+    // cette case (ou -1), suivants[k] la rangée d'après
+    size_t nb_cases = nb_cases_pour(plus_grande);
+    int* tetes = allouer(nb_cases * sizeof(int));
+    int* suivants = allouer(plus_grande * sizeof(int));
+    memset(tetes, 0xFF, nb_cases * sizeof(int));
+
+    for (size_t p = 0; p < nb_parts; p++) {
+        const struct Rangee* part = rangees_construites + debuts_construits[p];
+        size_t taille_part = debuts_construits[p + 1] - debuts_construits[p];
+        size_t masque = nb_cases_pour(taille_part) - 1;
+
+        for (size_t k = 0; k < taille_part; k++) {
+            size_t i = hacher(part[k].cle, graine) & masque;
+            suivants[k] = tetes[i];
+            tetes[i] = (int)k;
+        }
+
+        for (size_t r = debuts_sondes[p]; r < debuts_sondes[p + 1]; r++) {
+            type_base cle = rangees_sondees[r].cle;
+            for (int k = tetes[hacher(cle, graine) & masque]; k != -1; k = suivants[k]) {
+                if (part[k].cle == cle) {
+                    ajouter_en_fin(sortie_construite, part[k].indice);
+                    ajouter_en_fin(sortie_sondee, rangees_sondees[r].indice);
+                }
+            }
+        }
+
+        memset(tetes, 0xFF, (masque + 1) * sizeof(int));
+    }
+
+    free(suivants);
+    free(tetes);
+    free(debuts_sondes);
+    free(debuts_construits);
+    free(rangees_sondees);
+    free(rangees_construites);
+    return j;
+}
+
+void liberer_groupes(struct Groupes g) {
+    liberer_liste(g.cles);
+    liberer_liste(g.nombres);
+}
+
+void liberer_jointure(struct Jointure j) {
+    liberer_liste(j.indices_gauche);
+    liberer_liste(j.indices_droite);
+}
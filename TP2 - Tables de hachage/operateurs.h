@@ -0,0 +1,85 @@
+/**
+ * @file operateurs.h
+ * @author
+ * */
+
+#ifndef __OPERATEURS__H__
+#define __OPERATEURS__H__
+
+#include <stdlib.h>
+#include "liste_chainee.h"
+#include "liste.h"
+
+
+/* Description des structures */
+
+/**
+ * @brief Le résultat d'un regroupement : la clé `cles[i]` apparaît
+ * `nombres[i]` fois. Les deux listes ont la même longueur (le nombre de clés
+ * distinctes).
+ */
+struct Groupes{
+	Liste cles; /**< Les clés distinctes (l'ordre n'a pas d'importance). */
+	Liste nombres; /**< Le nombre d'occurrences de chaque clé. */
+};
+
+/**
+ * @brief Le résultat d'une jointure : pour chaque i, on a
+ * `element(gauche, indices_gauche[i]) == element(droite, indices_droite[i])`.
+ * Les deux listes ont la même longueur (le nombre de couples).
+ */
+struct Jointure{
+	Liste indices_gauche; /**< Les positions dans la colonne de gauche. */
+	Liste indices_droite; /**< Les positions correspondantes dans la colonne de droite. */
+};
+
+
+/* Prototype des fonctions */
+
+/**
+ * @brief Compte les occurrences de chaque clé d'une colonne (l'équivalent de
+ * `GROUP BY cle` avec `COUNT(*)`). \n
+ * Les clés sont d'abord réparties (tri par base, une passe pour compter et une
+ * pour copier) selon les bits de poids fort de leur code de hachage, en parts
+ * d'environ 8192 clés. Chaque part est ensuite comptée dans une petite table
+ * à adressage ouvert qui tient dans le cache, réutilisée d'une part à l'autre. \n
+ * La répartition utilise un tableau temporaire de la taille de la colonne. \n
+ * **Complexité :** O(taille de la liste) (en moyenne)
+ * @param cles une liste (qui n'est pas modifiée).
+ * @returns les clés distinctes et leurs nombres d'occurrences
+ * (à libérer avec `liberer_groupes`).
+ */
+struct Groupes grouper_compter(Liste cles);
+
+/**
+ * @brief Renvoie tous les couples de positions (i, j) tels que
+ * `element(gauche, i) == element(droite, j)` (l'équivalent d'une équi-jointure
+ * `gauche JOIN droite ON gauche.cle = droite.cle`). Les doublons sont permis
+ * des deux côtés : chaque clé donne le produit de ses occurrences. \n
+ * Les deux colonnes sont réparties comme dans `grouper_compter`, avec les mêmes
+ * bits de hachage : les couples d'une part ne viennent que de cette part. Pour
+ * chaque part, on construit une table (par chaînage, avec des indices) sur la
+ * plus petite des deux colonnes, puis on y cherche les clés de l'autre. \n
+ * **Complexité :** O(taille des deux listes + nombre de couples) (en moyenne)
+ * @param gauche une liste,
+ * @param droite une liste (elles ne sont pas modifiées).
+ * @returns les couples de positions, dans un ordre quelconque
+ * (à libérer avec `liberer_jointure`).
+ */
+struct Jointure jointure_hachage(Liste gauche, Liste droite);
+
+/**
+ * @brief Libère les listes d'un regroupement. \n
+ * **Complexité :** O(1)
+ * @param g le résultat de `grouper_compter`.
+ */
+void liberer_groupes(struct Groupes g);
+
+/**
+ * @brief Libère les listes d'une jointure. \n
+ * **Complexité :** O(1)
+ * @param j le résultat de `jointure_hachage`.
+ */
+void liberer_jointure(struct Jointure j);
+
+#endif
@@ -0,0 +1,164 @@
+#include "reserve_noeuds.h"
+#include <stdlib.h>
+#include <stdio.h>
+
+Reserve reserve_vide() {
+    Reserve r = malloc(sizeof(struct ReserveNoeuds));
+    if (r == NULL) {
+        fprintf(stderr, "Erreur: Échec de l'allocation de mémoire.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    r->blocs = NULL;
+    r->nb_blocs = 0;
+    r->capacite_blocs = 0;
+    r->nb_distribues = NB_NOEUDS_PAR_BLOC; // No block yet: the next allocation creates one
+    r->libres = NULL;
+    r->nb_allocations = 0;
+    r->nb_liberations = 0;
+
+    return r;
+}
+
+// Allocates a new block, aligned on a cache line
+static void nouveau_bloc(Reserve r) {
+    if (r->nb_blocs == r->capacite_blocs) {
+        r->capacite_blocs = r->capacite_blocs == 0 ? 8 : r->capacite_blocs * 2;
+        struct Noeud** blocs = realloc(r->blocs, r->capacite_blocs * sizeof(struct Noeud*));
+        if (blocs == NULL) {
+            fprintf(stderr, "Erreur: Échec de l'allocation de mémoire.\n");
+            exit(EXIT_FAILURE);
+        }
+        r->blocs = blocs;
+    }
+
+    struct Noeud* bloc = aligned_alloc(TAILLE_LIGNE_CACHE, NB_NOEUDS_PAR_BLOC * sizeof(struct Noeud));
+    if (bloc == NULL) {
+        fprintf(stderr, "Erreur: Échec de l'allocation de mémoire.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    r->blocs[r->nb_blocs] = bloc;
+    r->nb_blocs++;
+    r->nb_distribues = 0;
+}
+
+ListeChainee allouer_noeud(Reserve r) {
+    r->nb_allocations++;
+
+    // Réutiliser en priorité un noeud libre
+    if (r->libres != NULL) {
+        ListeChainee n = r->libres;
+        r->libres = n->suivant;
+        return n;
+    }
+
+    if (r->nb_distribues == NB_NOEUDS_PAR_BLOC) {
+        nouveau_bloc(r);
+    }
+
+    ListeChainee n = &(r->blocs[r->nb_blocs - 1][r->nb_distribues]);
+    r->nb_distribues++;
+    return n;
+}
+
+void liberer_noeud(Reserve r, ListeChainee n) {
+    r->nb_liberations++;
+    n->suivant = r->libres;
+    r->libres = n;
+}
+
+void liberer_reserve(Reserve r) {
+    for (size_t i = 0; i < r->nb_blocs; i++) {
+        free(r->blocs[i]);
+    }
+    free(r->blocs);
+    free(r);
+}
+
+void fusionner_reserves(Reserve destination, Reserve source) {
+    size_t nb_blocs = destination->nb_blocs + source->nb_blocs;
+    if (nb_blocs > destination->capacite_blocs) {
+        struct Noeud** blocs = realloc(destination->blocs, nb_blocs * sizeof(struct Noeud*));
+        if (blocs == NULL) {
+            fprintf(stderr, "Erreur: Échec de l'allocation de mémoire.\n");
+            exit(EXIT_FAILURE);
+        }
+        destination->blocs = blocs;
+        destination->capacite_blocs = nb_blocs;
+    }
+
+    // Les blocs de la source passent devant le dernier bloc de la destination,
+    // qui reste celui d'où l'on distribue les noeuds
+    if (destination->nb_blocs == 0) {
+        destination->nb_distribues = source->nb_distribues;
+        for (size_t i = 0; i < source->nb_blocs; i++) {
+            destination->blocs[i] = source->blocs[i];
+        }
+    } else {
+        struct Noeud* dernier = destination->blocs[destination->nb_blocs - 1];
+        for (size_t i = 0; i < source->nb_blocs; i++) {
+            destination->blocs[destination->nb_blocs - 1 + i] = source->blocs[i];
+        }
+        destination->blocs[nb_blocs - 1] = dernier;
+    }
+    destination->nb_blocs = nb_blocs;
+
+    // Ajouter les noeuds libres de la source à ceux de la destination
+    if (source->libres != NULL) {
+        ListeChainee fin = source->libres;
+        while (fin->suivant != NULL) {
+            fin = fin->suivant;
+        }
+        fin->suivant = destination->libres;
+        destination->libres = source->libres;
+    }
+
+    destination->nb_allocations += source->nb_allocations;
+    destination->nb_liberations += source->nb_liberations;
+
+    free(source->blocs);
+    free(source);
+}
+
+ListeChainee ajouter_debut_reserve(ListeChainee l, type_base x, Reserve r) {
+    if (r == NULL) {
+        return ajouter_debut(l, x);
+    }
+
+    ListeChainee l_debut = allouer_noeud(r);
+    l_debut->valeur = x;
+    l_debut->suivant = l;
+    return l_debut;
+}
+
+ListeChainee supprimer_lc_reserve(ListeChainee l, type_base x, Reserve r) {
+    if (r == NULL) {
+        return supprimer_lc(l, x);
+    }
+
+    ListeChainee prec = NULL;
+    ListeChainee current = l;
+
+    // Recherche de l'occurrence à supprimer
+    while (current != NULL && current->valeur != x) {
+        prec = current;
+        current = current->suivant;
+    }
+
+    // Si l'élément n'est pas trouvé dans la liste
+    if (current == NULL) {
+        fprintf(stderr, "Erreur: " FORMAT_BASE " n'est pas présent dans la liste.\n", x);
+        exit(EXIT_FAILURE);
+    }
+
+    // Si l'élément à supprimer est en tête de liste
+    if (prec == NULL) {
+        l = l->suivant;
+    } else {
+        prec->suivant = current->suivant;
+    }
+
+    liberer_noeud(r, current); // Le noeud retourne dans la réserve
+    return l;
+}
@@ -0,0 +1,130 @@
+/**
+ * @file reserve_noeuds.h
+ * @author
+ * */
+
+#ifndef __RESERVE__NOEUDS__H__
+#define __RESERVE__NOEUDS__H__
+
+#include <stdlib.h>
+#include "liste_chainee.h"
+
+
+/* Description de la structure */
+
+/**
+ * @brief La taille d'une ligne de cache, en octets.
+ */
+#define TAILLE_LIGNE_CACHE 64
+
+/**
+ * @brief Le nombre de noeuds dans un bloc de la réserve
+ * (un bloc fait ainsi 4 Kio, soit 64 lignes de cache).
+ */
+#define NB_NOEUDS_PAR_BLOC 256
+
+/**
+ * @brief Structure codant une réserve ("slab allocator") de noeuds de listes chaînées. \n
+ * Au lieu d'allouer chaque noeud avec un `malloc`, on alloue des blocs
+ * de NB_NOEUDS_PAR_BLOC noeuds, alignés sur une ligne de cache (un noeud
+ * n'est donc jamais à cheval sur deux lignes), et on les distribue un par un.
+ * Les noeuds rendus sont chaînés entre eux (par leur champ `suivant`)
+ * dans une liste de noeuds libres, réutilisés en priorité. \n
+ * Tous les noeuds sont libérés d'un coup en libérant les blocs.
+ */
+struct ReserveNoeuds{
+
+	struct Noeud** blocs; /**< Le tableau des adresses des blocs alloués. */
+
+	size_t nb_blocs; /**< Le nombre de blocs alloués. */
+
+	size_t capacite_blocs; /**< La taille du tableau **blocs**. */
+
+	size_t nb_distribues; /**< Le nombre de noeuds du dernier bloc déjà distribués. */
+
+	ListeChainee libres; /**< La liste des noeuds rendus à la réserve. */
+
+	size_t nb_allocations; /**< Le nombre total de noeuds demandés à la réserve. */
+
+	size_t nb_liberations; /**< Le nombre total de noeuds rendus à la réserve. */
+};
+
+/**
+ * @brief Le type "Reserve" est un pointeur vers une réserve de noeuds.
+ */
+typedef struct ReserveNoeuds* Reserve;
+
+
+/* Prototype des fonctions */
+
+/**
+ * @brief Renvoie une réserve vide (aucun bloc n'est encore alloué). \n
+ * **Complexité :** O(1)
+ * @returns une réserve vide.
+ */
+Reserve reserve_vide();
+
+/**
+ * @brief Renvoie un noeud (non initialisé) de la réserve. \n
+ * On prend d'abord un noeud libre ; sinon le prochain noeud du dernier bloc ;
+ * sinon on alloue un nouveau bloc. \n
+ * **Complexité :** O(1) (en amorti)
+ * @param r une réserve.
+ * @returns l'adresse d'un noeud.
+ */
+ListeChainee allouer_noeud(Reserve r);
+
+/**
+ * @brief Rend un noeud à la réserve (il sera réutilisé). \n
+ * **Complexité :** O(1)
+ * @param r une réserve,
+ * @param n un noeud obtenu par `allouer_noeud(r)`.
+ */
+void liberer_noeud(Reserve r, ListeChainee n);
+
+/**
+ * @brief Libère la réserve ainsi que **tous** les noeuds qu'elle a distribués. \n
+ * **Complexité :** O(nombre de blocs)
+ * @param r une réserve.
+ */
+void liberer_reserve(Reserve r);
+
+/**
+ * @brief Transfère tous les blocs et les noeuds libres d'une réserve dans une autre,
+ * puis libère la première (sans libérer ses noeuds). \n
+ * Sert à remplir une même table depuis plusieurs threads, chacun avec sa réserve. \n
+ * Les noeuds pas encore distribués du dernier bloc de **source** sont perdus
+ * (ils seront libérés avec **destination**).
+ * **Complexité :** O(nombre de blocs + nombre de noeuds libres de source) (en amorti)
+ * @param destination une réserve,
+ * @param source une autre réserve, qui ne doit plus être utilisée ensuite.
+ */
+void fusionner_reserves(Reserve destination, Reserve source);
+
+
+/* Équivalents des fonctions de liste_chainee.h qui allouent ou libèrent des noeuds.
+ * Si la réserve est le pointeur nul, ils utilisent malloc et free. */
+
+/**
+ * @brief Comme `ajouter_debut`, mais le noeud vient de la réserve **r**. \n
+ * **Complexité :** O(1) (en amorti)
+ * @param l liste chaînée,
+ * @param x valeur qu'on veut ajouter au début de la liste,
+ * @param r une réserve (ou NULL pour utiliser malloc).
+ * @returns une liste dont le premier noeud est étiqueté par x, et dont
+ * la suite est donnée par l.
+ */
+ListeChainee ajouter_debut_reserve(ListeChainee l, type_base x, Reserve r);
+
+/**
+ * @brief Comme `supprimer_lc`, mais le noeud supprimé est rendu à la réserve **r**. \n
+ * Si la valeur n'est pas dans la liste chaînée, déclenche une erreur. \n
+ * **Complexité :** O(taille de la liste)
+ * @param l liste chaînée,
+ * @param x valeur dont on souhaite supprimer une occurrence dans l,
+ * @param r une réserve (ou NULL pour utiliser free).
+ * @returns l dans laquelle on a supprimé un noeud de valeur x.
+ */
+ListeChainee supprimer_lc_reserve(ListeChainee l, type_base x, Reserve r);
+
+#endif